@@ -162,6 +162,16 @@ header file. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+
+/* Run time statistics in microseconds from the TIM2 based timebase, which
+   the HAL tick already keeps running; used for the idle time reports */
+#if defined(__ICCARM__) || defined(__CC_ARM) || defined(__GNUC__)
+extern uint32_t timebase_us(void);
+#endif
+#define configGENERATE_RUN_TIME_STATS            1
+#define INCLUDE_xTaskGetIdleTaskHandle           1
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portGET_RUN_TIME_COUNTER_VALUE()         timebase_us()
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
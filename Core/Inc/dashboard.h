@@ -1,6 +1,30 @@
 #ifndef DASHBOARD_H
 #define DASHBOARD_H
 
+#include <stdint.h>
+
+struct _lv_disp_t;
+struct _lv_disp_drv_t;
+
 void CreateGuiTask(void);
+void CreateCanDecoderTask(void);
+void CreateCanStatsUartTask(void);
+void can_configure_filters(void);
+void gui_stats_record_frame(uint32_t render_us, uint32_t px);
+void gui_stats_record_flush_wait(uint32_t wait_us);
+void gui_stats_set_display(const char *mode, uint32_t ram_bytes);
+uint32_t timebase_us(void);
+uint32_t cycles_now(void);
+void dashboard_set_overlay_display(struct _lv_disp_t *disp);
+void scanout_configure(uint32_t active_lines, uint32_t total_lines);
+int32_t scanout_copy_line(uint32_t beam, int32_t y1, int32_t y2);
+void scanout_order_areas(struct _lv_disp_t *disp, int32_t y_offset,
+		uint32_t beam);
+void render_profile_attach(struct _lv_disp_drv_t *drv);
+void render_profile_refresh_begin(void);
+void render_profile_refresh_end(uint32_t px);
+void render_profile_record_flush(uint32_t cycles);
+void render_profile_record_flush_wait(uint32_t cycles);
+void glyph_dma2d_attach(struct _lv_disp_drv_t *drv);
 
 #endif // DASHBOARD_H
@@ -18,6 +18,43 @@ extern "C" {
 #define MY_DISP_HOR_RES    800
 #define MY_DISP_VER_RES    480
 
+/* RGB565 framebuffer bytes; two of them back to back from the LTDC layer 0
+ * address, see RAM2 in the linker scripts */
+#define MY_DISP_FB_SIZE    (MY_DISP_HOR_RES * MY_DISP_VER_RES * 2)
+
+/* 0: LVGL draws straight into both framebuffers and the LTDC flips between
+ *    them in vertical blanking, 1.5 MB
+ * 1: LVGL draws into two small buffers of MY_DISP_PARTIAL_LINES rows while
+ *    DMA2D copies the other into a single framebuffer, 900 KB; RAM2 in the
+ *    linker scripts can then shrink to 750K and give the rest to RAM */
+#ifndef MY_DISP_PARTIAL
+#define MY_DISP_PARTIAL    0
+#endif
+#define MY_DISP_PARTIAL_LINES (MY_DISP_VER_RES / 10)
+
+/* 1: a second LVGL display on LTDC layer 1, a window over the gauge row that
+ *    the LTDC blends over layer 0 in hardware; black is colour keyed, so
+ *    only what is drawn on it covers layer 0. Gauges redraw there without
+ *    touching the chrome on layer 0. It has a single framebuffer in RAM
+ *    filled by DMA2D from two buffers of MY_DISP_OVERLAY_LINES rows, 375 KB,
+ *    which together with MY_DISP_PARTIAL needs RAM2 shrunk as described
+ *    above */
+#ifndef MY_DISP_OVERLAY
+#define MY_DISP_OVERLAY    1
+#endif
+#define MY_DISP_OVERLAY_X  0
+#define MY_DISP_OVERLAY_Y  260
+#define MY_DISP_OVERLAY_HOR_RES 800
+#define MY_DISP_OVERLAY_VER_RES 200
+#define MY_DISP_OVERLAY_LINES 20
+
+/* 1: DMA2D copies into a framebuffer that is on screen (MY_DISP_PARTIAL,
+ *    MY_DISP_OVERLAY) wait for the LTDC line event when the beam is in the
+ *    area, so no frame shows half a copy */
+#ifndef MY_DISP_BEAM_RACE
+#define MY_DISP_BEAM_RACE  1
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
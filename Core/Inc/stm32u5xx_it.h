@@ -59,6 +59,8 @@ void GPU2D_IRQHandler(void);
 void GPU2D_ER_IRQHandler(void);
 void LTDC_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void GPDMA1_Channel0_IRQHandler(void);
+void USART1_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -41,6 +41,7 @@ extern UART_HandleTypeDef huart3;
 extern UART_HandleTypeDef huart6;
 
 /* USER CODE BEGIN Private defines */
+extern DMA_HandleTypeDef hdma_usart1_tx;
 
 /* USER CODE END Private defines */
 
@@ -130,7 +130,9 @@ void vApplicationStackOverflowHook(xTaskHandle xTask, char *pcTaskName)
 void MX_FREERTOS_Init(void) {
   /* USER CODE BEGIN Init */
 	lvglTickHandle = osThreadNew(LVGLTick, NULL, &lvglTick_attributes);
+	CreateCanDecoderTask();
 	CreateGuiTask();
+	CreateCanStatsUartTask();
   /* USER CODE END Init */
 
   /* USER CODE BEGIN RTOS_MUTEX */
@@ -5,14 +5,68 @@
 #include "lvgl_port_display.h"
 #include "main.h"
 #include "ltdc.h"
+#if MY_DISP_PARTIAL || MY_DISP_OVERLAY
 #include "dma2d.h"
+#endif
+#include "cmsis_os2.h"
+#include "FreeRTOS.h"
+#include "dashboard.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+#if MY_DISP_PARTIAL
+#define DISP_BUF_PIXELS (MY_DISP_HOR_RES * MY_DISP_PARTIAL_LINES)
+#define DISP_MODE_NAME "partial"
+#define DISP_RAM_BYTES (MY_DISP_FB_SIZE + 2 * DISP_BUF_PIXELS * sizeof(lv_color_t))
+#else
+#define DISP_MODE_NAME "double fb"
+#define DISP_RAM_BYTES (2 * MY_DISP_FB_SIZE)
+#endif
+
+#if MY_DISP_OVERLAY
+#define OVERLAY_FB_PIXELS (MY_DISP_OVERLAY_HOR_RES * MY_DISP_OVERLAY_VER_RES)
+#define OVERLAY_BUF_PIXELS (MY_DISP_OVERLAY_HOR_RES * MY_DISP_OVERLAY_LINES)
+#define OVERLAY_MODE_NAME " + overlay"
+#define OVERLAY_RAM_BYTES ((OVERLAY_FB_PIXELS + 2 * OVERLAY_BUF_PIXELS) \
+                           * sizeof(lv_color_t))
+#define OVERLAY_COLOR_KEY 0x000000U /* RGB888, black on layer 1 is see-through */
+#else
+#define OVERLAY_MODE_NAME ""
+#define OVERLAY_RAM_BYTES 0
+#endif
+
+#define DISP_FLUSH_FLAG 0x0001U /* thread flag of the task waiting in LVGL */
+#define DISP_LINE_FLAG 0x0002U /* thread flag of the task waiting for the beam */
+#define DISP_FLUSH_TIMEOUT_MS 10 /* recheck the flag if an interrupt is lost */
+
+/* copies into a scanned out framebuffer race the beam */
+#define DISP_BEAM_RACE (MY_DISP_BEAM_RACE && (MY_DISP_PARTIAL || MY_DISP_OVERLAY))
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static void disp_flush (lv_disp_drv_t*, const lv_area_t*, lv_color_t*);
-static void disp_flush_complete (DMA2D_HandleTypeDef*);
+static void disp_monitor (lv_disp_drv_t*, uint32_t, uint32_t);
+static void disp_refr_timer (lv_timer_t*);
+static void disp_wait (lv_disp_drv_t*);
+static void disp_flush_done (lv_disp_drv_t*);
+#if MY_DISP_PARTIAL || MY_DISP_OVERLAY
+static void dma2d_flush (lv_disp_drv_t*, const lv_area_t*, lv_color_t*,
+                         uint32_t, lv_coord_t);
+static void dma2d_flush_complete (DMA2D_HandleTypeDef*);
+#endif
+#if MY_DISP_OVERLAY
+static void overlay_init (void);
+static void overlay_flush (lv_disp_drv_t*, const lv_area_t*, lv_color_t*);
+#endif
+#if DISP_BEAM_RACE
+static int32_t disp_scanout_y (lv_disp_drv_t*);
+static uint32_t scanout_beam (void);
+static void scanout_wait (int32_t, int32_t);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -21,7 +75,38 @@ static void disp_flush_complete (DMA2D_HandleTypeDef*);
 static lv_disp_drv_t disp_drv;
 static lv_disp_draw_buf_t disp_buf;
 
-static __attribute__((aligned(32))) lv_color_t buf_1[MY_DISP_HOR_RES * MY_DISP_VER_RES];
+static uint32_t frame_px;
+
+/* cycle count when the pending flush was started, for the render profile */
+static uint32_t volatile flush_start;
+
+/* the task blocked in disp_wait, woken by the flush interrupt */
+static osThreadId_t volatile flush_waiter;
+
+#if DISP_BEAM_RACE
+/* the task blocked in scanout_wait, woken by the LTDC line event */
+static osThreadId_t volatile line_waiter;
+#endif
+
+#if MY_DISP_PARTIAL
+static __attribute__((aligned(32))) lv_color_t buf_1[DISP_BUF_PIXELS];
+static __attribute__((aligned(32))) lv_color_t buf_2[DISP_BUF_PIXELS];
+#endif
+
+#if MY_DISP_PARTIAL || MY_DISP_OVERLAY
+/* the display whose area DMA2D is copying */
+static lv_disp_drv_t *volatile dma2d_drv;
+#endif
+
+#if MY_DISP_OVERLAY
+static lv_disp_drv_t overlay_drv;
+static lv_disp_draw_buf_t overlay_buf;
+
+/* scanned out by LTDC layer 1; zeroed at startup, so see-through */
+static __attribute__((aligned(32))) lv_color_t overlay_fb[OVERLAY_FB_PIXELS];
+static __attribute__((aligned(32))) lv_color_t overlay_buf_1[OVERLAY_BUF_PIXELS];
+static __attribute__((aligned(32))) lv_color_t overlay_buf_2[OVERLAY_BUF_PIXELS];
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -33,11 +118,23 @@ lvgl_display_init (void)
   /* display initialization */
   ; /* display is already initialized by cubemx-generated code */
 
-  /* display buffer initialization */
+#if MY_DISP_PARTIAL
+  /* display buffer initialization: LVGL renders into one buffer while DMA2D
+   * copies the other into the framebuffer */
   lv_disp_draw_buf_init (&disp_buf,
                          (void*) buf_1,
-                         NULL,
+                         (void*) buf_2,
+                         DISP_BUF_PIXELS);
+#else
+  /* display buffer initialization: LVGL renders straight into the two
+   * LTDC framebuffers, starting with the one not on screen */
+  uint32_t front = hltdc.LayerCfg[0].FBStartAdress;
+
+  lv_disp_draw_buf_init (&disp_buf,
+                         (void*) (front + MY_DISP_FB_SIZE),
+                         (void*) front,
                          MY_DISP_HOR_RES * MY_DISP_VER_RES);
+#endif
 
   /* register the display in LVGL */
   lv_disp_drv_init(&disp_drv);
@@ -49,48 +146,339 @@ lvgl_display_init (void)
   /* set callback for display driver */
   disp_drv.flush_cb = disp_flush;
   disp_drv.full_refresh = 0;
+#if MY_DISP_PARTIAL
+  disp_drv.direct_mode = 0;
+#else
   disp_drv.direct_mode = 1;
+#endif
 
+#if MY_DISP_PARTIAL || MY_DISP_OVERLAY
   /* interrupt callback for DMA2D transfer */
-  hdma2d.XferCpltCallback = disp_flush_complete;
+  hdma2d.XferCpltCallback = dma2d_flush_complete;
+#endif
+
+  /* block until the flush interrupt instead of spinning on flush_ready */
+  disp_drv.wait_cb = disp_wait;
+
+  /* per-frame redrawn area and render time, for the diagnostics */
+  disp_drv.monitor_cb = disp_monitor;
 
   /* set a display buffer */
   disp_drv.draw_buf = &disp_buf;
 
   /* finally register the driver */
-  lv_disp_drv_register(&disp_drv);
+  lv_disp_t *disp = lv_disp_drv_register(&disp_drv);
+
+  /* time every refresh, and hold them until the previous page flip */
+  lv_timer_set_cb(disp->refr_timer, disp_refr_timer);
+
+  /* letters blended by DMA2D from their glyph bitmaps, timed as LVGL's */
+  glyph_dma2d_attach(&disp_drv);
+  render_profile_attach(&disp_drv);
+
+#if MY_DISP_OVERLAY
+  overlay_init();
+#endif
+
+#if DISP_BEAM_RACE
+  scanout_configure(MY_DISP_VER_RES, hltdc.Init.TotalHeigh + 1);
+#endif
+
+  gui_stats_set_display(DISP_MODE_NAME OVERLAY_MODE_NAME,
+                        DISP_RAM_BYTES + OVERLAY_RAM_BYTES);
+}
+
+#if !MY_DISP_PARTIAL
+/* LTDC shadow registers reloaded in vertical blanking: the new framebuffer
+ * is on screen and the old one is free to render into */
+void
+HAL_LTDC_ReloadEventCallback (LTDC_HandleTypeDef *hltdc)
+{
+  disp_flush_done(&disp_drv);
+}
+#endif
+
+#if DISP_BEAM_RACE
+/* the beam reached the line programmed in scanout_wait */
+void
+HAL_LTDC_LineEventCallback (LTDC_HandleTypeDef *hltdc)
+{
+  osThreadId_t waiter = line_waiter;
+  if (waiter != NULL)
+    osThreadFlagsSet(waiter, DISP_LINE_FLAG);
 }
+#endif
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if MY_DISP_PARTIAL
+static void
+disp_flush (lv_disp_drv_t   *drv,
+            const lv_area_t *area,
+            lv_color_t      *color_p)
+{
+  dma2d_flush(drv, area, color_p, hltdc.LayerCfg[0].FBStartAdress,
+              MY_DISP_HOR_RES);
+}
+#else
 static void
 disp_flush (lv_disp_drv_t   *drv,
             const lv_area_t *area,
             lv_color_t      *color_p)
 {
+  /* the areas are already in the back buffer, nothing to copy; once the last
+   * one is drawn show the buffer from the next vertical blanking on */
+  if (!lv_disp_flush_is_last(drv))
+    {
+      lv_disp_flush_ready(drv);
+      return;
+    }
+
+  HAL_LTDC_SetAddress_NoReload(&hltdc, (uint32_t) color_p, 0);
+  flush_start = cycles_now();
+  HAL_LTDC_Reload(&hltdc, LTDC_RELOAD_VERTICAL_BLANKING);
+}
+#endif
+
+#if MY_DISP_PARTIAL || MY_DISP_OVERLAY
+/* copy a rendered area into a framebuffer dest_width pixels wide. LVGL's own
+ * DMA2D drawing waits for the START bit to clear first, so it never
+ * overlaps a transfer started here */
+static void
+dma2d_flush (lv_disp_drv_t   *drv,
+             const lv_area_t *area,
+             lv_color_t      *color_p,
+             uint32_t         dest,
+             lv_coord_t       dest_width)
+{
 
   lv_coord_t width = lv_area_get_width(area);
   lv_coord_t height = lv_area_get_height(area);
 
+#if DISP_BEAM_RACE
+  int32_t y = disp_scanout_y(drv);
+  scanout_wait(area->y1 + y, area->y2 + y);
+#endif
+
+  dma2d_drv = drv;
+
   DMA2D->CR = 0x0U << DMA2D_CR_MODE_Pos;
   DMA2D->FGPFCCR = DMA2D_INPUT_RGB565;
   DMA2D->FGMAR = (uint32_t)color_p;
   DMA2D->FGOR = 0;
   DMA2D->OPFCCR = DMA2D_OUTPUT_RGB565;
-  DMA2D->OMAR = hltdc.LayerCfg[0].FBStartAdress + 2 * \
-                (area->y1 * MY_DISP_HOR_RES + area->x1);
-  DMA2D->OOR = MY_DISP_HOR_RES - width;
+  DMA2D->OMAR = dest + 2 * (area->y1 * dest_width + area->x1);
+  DMA2D->OOR = dest_width - width;
   DMA2D->NLR = (width << DMA2D_NLR_PL_Pos) | (height << DMA2D_NLR_NL_Pos);
   DMA2D->IFCR = 0x3FU;
   DMA2D->CR |= DMA2D_CR_TCIE;
+  flush_start = cycles_now();
   DMA2D->CR |= DMA2D_CR_START;
 
 }
 
 static void
-disp_flush_complete (DMA2D_HandleTypeDef *hdma2d)
+dma2d_flush_complete (DMA2D_HandleTypeDef *hdma2d)
+{
+  disp_flush_done(dma2d_drv);
+}
+#endif
+
+#if MY_DISP_OVERLAY
+static void
+overlay_init (void)
+{
+  /* LTDC layer 1: a window over the gauge row showing overlay_fb, opaque
+   * except for the colour key */
+  LTDC_LayerCfgTypeDef layer = {0};
+
+  layer.WindowX0 = MY_DISP_OVERLAY_X;
+  layer.WindowX1 = MY_DISP_OVERLAY_X + MY_DISP_OVERLAY_HOR_RES;
+  layer.WindowY0 = MY_DISP_OVERLAY_Y;
+  layer.WindowY1 = MY_DISP_OVERLAY_Y + MY_DISP_OVERLAY_VER_RES;
+  layer.PixelFormat = LTDC_PIXEL_FORMAT_RGB565;
+  layer.Alpha = 255;
+  layer.Alpha0 = 0;
+  layer.BlendingFactor1 = LTDC_BLENDING_FACTOR1_CA;
+  layer.BlendingFactor2 = LTDC_BLENDING_FACTOR2_CA;
+  layer.FBStartAdress = (uint32_t) overlay_fb;
+  layer.ImageWidth = MY_DISP_OVERLAY_HOR_RES;
+  layer.ImageHeight = MY_DISP_OVERLAY_VER_RES;
+  if (HAL_LTDC_ConfigLayer(&hltdc, &layer, 1) != HAL_OK
+      || HAL_LTDC_ConfigColorKeying(&hltdc, OVERLAY_COLOR_KEY, 1) != HAL_OK
+      || HAL_LTDC_EnableColorKeying(&hltdc, 1) != HAL_OK)
+    Error_Handler();
+
+  /* a second LVGL display for the layer, drawn in partial mode and copied
+   * into overlay_fb by DMA2D like MY_DISP_PARTIAL */
+  lv_disp_draw_buf_init (&overlay_buf,
+                         (void*) overlay_buf_1,
+                         (void*) overlay_buf_2,
+                         OVERLAY_BUF_PIXELS);
+
+  lv_disp_drv_init(&overlay_drv);
+  overlay_drv.hor_res = MY_DISP_OVERLAY_HOR_RES;
+  overlay_drv.ver_res = MY_DISP_OVERLAY_VER_RES;
+  overlay_drv.flush_cb = overlay_flush;
+  overlay_drv.wait_cb = disp_wait;
+  overlay_drv.monitor_cb = disp_monitor;
+  overlay_drv.draw_buf = &overlay_buf;
+
+  /* layer 0 stays the default display */
+  lv_disp_t *overlay = lv_disp_drv_register(&overlay_drv);
+  lv_timer_set_cb(overlay->refr_timer, disp_refr_timer);
+  glyph_dma2d_attach(&overlay_drv);
+  render_profile_attach(&overlay_drv);
+
+  /* the theme's screen is white, keep the layer see-through until the
+   * dashboard loads its own screens */
+  lv_obj_set_style_bg_color(lv_disp_get_scr_act(overlay), lv_color_black(), 0);
+
+  dashboard_set_overlay_display(overlay);
+}
+
+static void
+overlay_flush (lv_disp_drv_t   *drv,
+               const lv_area_t *area,
+               lv_color_t      *color_p)
+{
+  dma2d_flush(drv, area, color_p, (uint32_t) overlay_fb,
+              MY_DISP_OVERLAY_HOR_RES);
+}
+#endif
+
+#if DISP_BEAM_RACE
+/* screen line of the display's first row if its framebuffer is written
+ * while on screen, -1 if it is page flipped */
+static int32_t
+disp_scanout_y (lv_disp_drv_t *drv)
+{
+#if MY_DISP_OVERLAY
+  if (drv == &overlay_drv)
+    return MY_DISP_OVERLAY_Y;
+#endif
+#if MY_DISP_PARTIAL
+  return 0;
+#else
+  return -1;
+#endif
+}
+
+/* the line the LTDC is scanning, counted from the first visible one */
+static uint32_t
+scanout_beam (void)
+{
+  /* CYPOS counts from the start of vertical sync */
+  uint32_t first = hltdc.Init.AccumulatedVBP + 1;
+  uint32_t total = hltdc.Init.TotalHeigh + 1;
+  uint32_t line = (LTDC->CPSR & LTDC_CPSR_CYPOS) >> LTDC_CPSR_CYPOS_Pos;
+
+  return (line + total - first) % total;
+}
+
+/* block until screen lines y1..y2 can be copied without tearing. The GUI
+ * task waits here rather than starting DMA2D from the line interrupt, as
+ * LVGL draws the next buffer with DMA2D meanwhile */
+static void
+scanout_wait (int32_t y1,
+              int32_t y2)
+{
+  int32_t line = scanout_copy_line(scanout_beam(), y1, y2);
+
+  if (line < 0)
+    return; /* clear of the beam */
+
+  uint32_t start_us = timebase_us();
+  uint32_t start = cycles_now();
+
+  for (; line >= 0; line = scanout_copy_line(scanout_beam(), y1, y2))
+    {
+      line_waiter = osThreadGetId();
+      osThreadFlagsClear(DISP_LINE_FLAG);
+      HAL_LTDC_ProgramLineEvent(&hltdc, (line + hltdc.Init.AccumulatedVBP + 1)
+                                        % (hltdc.Init.TotalHeigh + 1));
+
+      /* the beam may have passed the line while it was programmed */
+      if (scanout_copy_line(scanout_beam(), y1, y2) < 0)
+        break;
+      osThreadFlagsWait(DISP_LINE_FLAG, osFlagsWaitAny,
+                        pdMS_TO_TICKS(DISP_FLUSH_TIMEOUT_MS));
+    }
+
+  render_profile_record_flush_wait(cycles_now() - start);
+  gui_stats_record_flush_wait(timebase_us() - start_us);
+}
+#endif
+
+/* from the flush interrupt */
+static void
+disp_flush_done (lv_disp_drv_t *drv)
+{
+  render_profile_record_flush(cycles_now() - flush_start);
+  lv_disp_flush_ready(drv);
+
+  osThreadId_t waiter = flush_waiter;
+  if (waiter != NULL)
+    osThreadFlagsSet(waiter, DISP_FLUSH_FLAG);
+}
+
+static void
+disp_wait (lv_disp_drv_t *drv)
+{
+  /* LVGL calls this in a loop until the flush is done. The waiter is
+   * published before flushing is checked, so an interrupt in between still
+   * sets the flag; a flag left over from an earlier flush only costs one
+   * extra pass */
+  uint32_t start_us = timebase_us();
+  uint32_t start = cycles_now();
+
+  flush_waiter = osThreadGetId();
+  if (drv->draw_buf->flushing)
+    osThreadFlagsWait(DISP_FLUSH_FLAG, osFlagsWaitAny,
+                      pdMS_TO_TICKS(DISP_FLUSH_TIMEOUT_MS));
+
+  render_profile_record_flush_wait(cycles_now() - start);
+  gui_stats_record_flush_wait(timebase_us() - start_us);
+}
+
+static void
+disp_monitor (lv_disp_drv_t *drv,
+              uint32_t       time,
+              uint32_t       px)
+{
+  frame_px = px;
+}
+
+static void
+disp_refr_timer (lv_timer_t *timer)
 {
-  lv_disp_flush_ready(&disp_drv);
+#if !MY_DISP_PARTIAL
+  /* LVGL copies the last frame's dirty areas into the back buffer before it
+   * waits for the flush, so starting while the flip is still pending would
+   * draw into the buffer being scanned out; retry on the next handler call */
+  lv_disp_t *disp = timer->user_data;
+  if (disp->driver == &disp_drv && disp_buf.flushing)
+    {
+      lv_timer_ready(timer);
+      return;
+    }
+#endif
+
+#if DISP_BEAM_RACE
+  /* draw the areas in the order the beam reaches them */
+  int32_t y = disp_scanout_y(((lv_disp_t*) timer->user_data)->driver);
+  if (y >= 0)
+    scanout_order_areas(timer->user_data, y, scanout_beam());
+#endif
+
+  uint32_t start_us = timebase_us();
+
+  frame_px = 0;
+  render_profile_refresh_begin();
+  _lv_disp_refr_timer(timer);
+  render_profile_refresh_end(frame_px);
+  if (frame_px != 0)
+    gui_stats_record_frame(timebase_us() - start_us, frame_px);
 }
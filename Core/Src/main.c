@@ -163,30 +163,11 @@ int main(void)
   MX_FLASH_Init();
   /* USER CODE BEGIN 2 */
 
-  /* Setup CAN filter */
-  // Standard id filter (match all)
-  FDCAN_FilterTypeDef sFilterConfig = {
-      .IdType = FDCAN_STANDARD_ID,
-      .FilterIndex = 0,
-      .FilterType = FDCAN_FILTER_MASK,
-      .FilterConfig = FDCAN_FILTER_TO_RXFIFO0,
-      .FilterID1 = 0x000,
-      .FilterID2 = 0x000, // mask = 0 => match all
-  };
-  HAL_FDCAN_ConfigFilter(&hfdcan1, &sFilterConfig);
-
-  // Extended id filter (match all)
-  FDCAN_FilterTypeDef eFilterConfig = {
-      .IdType = FDCAN_EXTENDED_ID,
-      .FilterIndex = 1,
-      .FilterType = FDCAN_FILTER_MASK,
-      .FilterConfig = FDCAN_FILTER_TO_RXFIFO0,
-      .FilterID1 = 0x00000000,
-      .FilterID2 = 0x00000000, // match all
-  };
-  HAL_FDCAN_ConfigFilter(&hfdcan1, &eFilterConfig);
-
-  HAL_FDCAN_ActivateNotification(&hfdcan1, FDCAN_IT_RX_FIFO0_NEW_MESSAGE, 0);
+  /* Setup CAN filters: only IDs the decoder uses are accepted */
+  can_configure_filters();
+
+  HAL_FDCAN_ActivateNotification(&hfdcan1,
+      FDCAN_IT_RX_FIFO0_NEW_MESSAGE | FDCAN_IT_RX_FIFO0_MESSAGE_LOST, 0);
   HAL_FDCAN_Start(&hfdcan1);
 
   /* reset display */
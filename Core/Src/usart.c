@@ -21,6 +21,8 @@
 #include "usart.h"
 
 /* USER CODE BEGIN 0 */
+/* USART1 transmits by GPDMA1 channel 0, set up in HAL_UART_MspInit */
+DMA_HandleTypeDef hdma_usart1_tx;
 
 /* USER CODE END 0 */
 
@@ -251,6 +253,42 @@ void HAL_UART_MspInit(UART_HandleTypeDef* uartHandle)
 
   /* USER CODE BEGIN USART1_MspInit 1 */
 
+    /* USART1 DMA Init */
+    __HAL_RCC_GPDMA1_CLK_ENABLE();
+
+    /* GPDMA1_REQUEST_USART1_TX Init */
+    hdma_usart1_tx.Instance = GPDMA1_Channel0;
+    hdma_usart1_tx.Init.Request = GPDMA1_REQUEST_USART1_TX;
+    hdma_usart1_tx.Init.BlkHWRequest = DMA_BREQ_SINGLE_BURST;
+    hdma_usart1_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+    hdma_usart1_tx.Init.SrcInc = DMA_SINC_INCREMENTED;
+    hdma_usart1_tx.Init.DestInc = DMA_DINC_FIXED;
+    hdma_usart1_tx.Init.SrcDataWidth = DMA_SRC_DATAWIDTH_BYTE;
+    hdma_usart1_tx.Init.DestDataWidth = DMA_DEST_DATAWIDTH_BYTE;
+    hdma_usart1_tx.Init.Priority = DMA_LOW_PRIORITY_LOW_WEIGHT;
+    hdma_usart1_tx.Init.SrcBurstLength = 1;
+    hdma_usart1_tx.Init.DestBurstLength = 1;
+    hdma_usart1_tx.Init.TransferAllocatedPort = DMA_SRC_ALLOCATED_PORT0|DMA_DEST_ALLOCATED_PORT0;
+    hdma_usart1_tx.Init.TransferEventMode = DMA_TCEM_BLOCK_TRANSFER;
+    hdma_usart1_tx.Init.Mode = DMA_NORMAL;
+    if (HAL_DMA_Init(&hdma_usart1_tx) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    __HAL_LINKDMA(uartHandle, hdmatx, hdma_usart1_tx);
+
+    if (HAL_DMA_ConfigChannelAttributes(&hdma_usart1_tx, DMA_CHANNEL_NPRIV) != HAL_OK)
+    {
+      Error_Handler();
+    }
+
+    /* GPDMA1 channel 0 and USART1 interrupt Init */
+    HAL_NVIC_SetPriority(GPDMA1_Channel0_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(GPDMA1_Channel0_IRQn);
+    HAL_NVIC_SetPriority(USART1_IRQn, 5, 0);
+    HAL_NVIC_EnableIRQ(USART1_IRQn);
+
   /* USER CODE END USART1_MspInit 1 */
   }
   else if(uartHandle->Instance==USART2)
@@ -403,6 +441,9 @@ void HAL_UART_MspDeInit(UART_HandleTypeDef* uartHandle)
     HAL_GPIO_DeInit(GPIOG, GPIO_PIN_9);
 
   /* USER CODE BEGIN USART1_MspDeInit 1 */
+    HAL_DMA_DeInit(uartHandle->hdmatx);
+    HAL_NVIC_DisableIRQ(GPDMA1_Channel0_IRQn);
+    HAL_NVIC_DisableIRQ(USART1_IRQn);
 
   /* USER CODE END USART1_MspDeInit 1 */
   }
@@ -1,39 +1,62 @@
 #include "dashboard.h"
 #include "fdcan/fdcan_handlers.h"
+#include "fdcan/can_stats.h"
+#include "gui/binding.h"
+#include "gui/chrome_cache.h"
+#include "gui/digit_atlas.h"
+#include "gui/gauge.h"
+#include "gui/gui_stats.h"
 #include "gui/gui_task.h"
+#include "gui/label_text.h"
+#include "gui/readout.h"
+#include "gui/span_label.h"
+#include "telemetry/telemetry.h"
+#include "timing/cpu_load.h"
+#include "timing/timebase.h"
+#include <inttypes.h>
+#include <stdarg.h>
+#include <string.h>
 
 uint32_t time_count = 0;
 
-inv_t inv1 = { 0 };
-inv_t inv2 = { 0 };
-battery_t battery = { 0 };
-vcu_t vcu = { 0 };
+telemetry_t telemetry = { 0 };
 
 display_state_t current_display_state = UNINITIALIZED;
 display_state_t commanded_display_state = LOGO;
 
+// one resident screen per display state, built once at boot
+static lv_obj_t *display_screens[DISPLAY_STATE_COUNT];
+
+// LTDC layer 1 when the display port has one: a blank (see-through) screen,
+// and the drive state's gauges over the bottom row of its layer 0 screen
+static lv_disp_t *overlay_display;
+static lv_obj_t *overlay_blank_screen;
+static lv_obj_t *overlay_drive_screen;
+
 //persistent lv_objs for logo state
 lv_obj_t *our_logo;
 
 //persistent lv_objs for pre_drive state
 lv_obj_t *pre_drive_grid;
 lv_obj_t *pre_drive_labels[4];
+static label_text_t pre_drive_text[4]; // but 0, a span label
 
 //persistent lv_objs for drive state
 lv_obj_t *drive_grid;
-lv_obj_t *rpm_arc;
-lv_obj_t *rpm_arc_label;
-lv_obj_t *speed_arc;
-lv_obj_t *acceleration_arc;
-lv_obj_t *battery_temp_label;
+lv_obj_t *rpm_gauge;
+lv_obj_t *speed_gauge;
+lv_obj_t *acceleration_gauge;
+lv_obj_t *battery_temp_readout;
 lv_obj_t *current_limiting_factor_label;
 lv_obj_t *battery_soc_bar;
-lv_obj_t *battery_soc_label;
+lv_obj_t *battery_soc_readout;
 lv_obj_t *inverter_temp_label;
 lv_obj_t *motor_temp_label;
+lv_obj_t *display_stats_label;
 
 //persistent lv_objs for diagnostic state
 lv_obj_t *diagnostic_label;
+lv_obj_t *bus_stats_table;
 
 const char* inverter_statusword(statusword_t word) {
 	switch (word) {
@@ -58,23 +81,41 @@ const char* inverter_statusword(statusword_t word) {
 
 lv_color_t LV_COLOR_LIGHT_GRAY;
 
+#define STALE(signal) (telemetry.stale[CAN_DB_##signal##_SIGNAL] != 0)
+
+// set a label's text only when it differs, so an unchanged value costs no
+// re-layout and no redraw
+static void label_set_text_fmt(lv_obj_t *label, const char *fmt, ...) {
+	char text[LABEL_TEXT_BYTES];
+	va_list args;
+
+	va_start(args, fmt);
+	lv_vsnprintf(text, sizeof(text), fmt, args);
+	va_end(args);
+
+	if (strcmp(lv_label_get_text(label), text) != 0) {
+		lv_label_set_text(label, text);
+	}
+}
+
 void initialize_display_colors() {
 	LV_COLOR_LIGHT_GRAY = lv_color_hex(LIGHT_GRAY_HEX);
 }
 
-void initialize_display_state(display_state_t display_state) {
+void initialize_display_state(display_state_t display_state,
+		lv_obj_t *screen) {
 	switch (display_state) {
 	case LOGO:
-		initialize_display_state_logo();
+		initialize_display_state_logo(screen);
 		break;
 	case PRE_DRIVE:
-		initialize_display_state_pre_drive();
+		initialize_display_state_pre_drive(screen);
 		break;
 	case DRIVE:
-		initialize_display_state_drive();
+		initialize_display_state_drive(screen);
 		break;
 	case DIAGNOSTIC:
-		initialize_display_state_diagnostic();
+		initialize_display_state_diagnostic(screen);
 		break;
 	default:
 		break;
@@ -82,78 +123,118 @@ void initialize_display_state(display_state_t display_state) {
 
 }
 
-void clear_display_state(display_state_t display_state) {
-	switch (display_state) {
-	case LOGO:
-		clear_display_state_logo();
-		break;
-	case PRE_DRIVE:
-		clear_display_state_pre_drive();
-		break;
-	case DRIVE:
-		clear_display_state_drive();
-		break;
-	case DIAGNOSTIC:
-		clear_display_state_diagnostic();
-		break;
-	default:
-		break;
+void dashboard_set_overlay_display(lv_disp_t *disp) {
+	overlay_display = disp;
+}
+
+static void initialize_overlay_screens(void) {
+	lv_obj_t *boot_screen = lv_disp_get_scr_act(overlay_display);
+	lv_disp_t *base_display = lv_disp_get_default();
+
+	// screens are created on the default display
+	lv_disp_set_default(overlay_display);
+	overlay_blank_screen = lv_obj_create(NULL);
+	overlay_drive_screen = lv_obj_create(NULL);
+	lv_disp_set_default(base_display);
+
+	set_display_background(overlay_blank_screen);
+	set_display_background(overlay_drive_screen);
+
+	lv_scr_load(overlay_blank_screen);
+	lv_obj_del(boot_screen);
+}
+
+void initialize_display_screens(void) {
+	initialize_display_colors();
+
+	if (overlay_display != NULL) {
+		initialize_overlay_screens();
 	}
+
+	for (int state = LOGO; state < DISPLAY_STATE_COUNT; state++) {
+		display_screens[state] = lv_obj_create(NULL);
+		initialize_display_state((display_state_t) state,
+				display_screens[state]);
+	}
+
+	// the default screen created with the display is no longer needed
+	lv_obj_t *boot_screen = lv_scr_act();
+	lv_scr_load(display_screens[LOGO]);
+	lv_obj_del(boot_screen);
 }
 
-void update_display_state(display_state_t display_state) {
+void load_display_state(display_state_t display_state) {
+	if (display_state > UNINITIALIZED && display_state < DISPLAY_STATE_COUNT) {
+		lv_scr_load(display_screens[display_state]);
+		if (overlay_display != NULL) {
+			lv_scr_load(
+					display_state == DRIVE ?
+							overlay_drive_screen : overlay_blank_screen);
+		}
+	}
+}
+
+void update_display_state(display_state_t display_state, uint32_t dirty) {
 	switch (display_state) {
 	case LOGO:
-		update_display_state_logo();
+		update_display_state_logo(dirty);
 		break;
 	case PRE_DRIVE:
-		update_display_state_pre_drive();
+		update_display_state_pre_drive(dirty);
 		break;
 	case DRIVE:
-		update_display_state_drive();
+		update_display_state_drive(dirty);
 		break;
 	case DIAGNOSTIC:
-		update_display_state_diagnostic();
+		update_display_state_diagnostic(dirty);
 		break;
 	default:
 		break;
 	}
 }
 
-lv_obj_t* generate_grid(bool border, int grid_rows, int grid_cols) {
-	lv_obj_t *grid = lv_obj_create(lv_scr_act());
+lv_obj_t* generate_grid(lv_obj_t *parent, bool border, int grid_rows,
+		int grid_cols) {
+	lv_obj_t *grid = lv_obj_create(parent);
 	// make use of the additional variable so I don't have to change chatgpt's code
-	int MAX_GRID_WIDTH = 800;
-	int MAX_GRID_HEIGHT = 480;
+	// the whole parent, a screen of either display layer
+	int MAX_GRID_WIDTH = lv_obj_get_width(parent);
+	int MAX_GRID_HEIGHT = lv_obj_get_height(parent);
 	lv_obj_clear_flag(grid, LV_OBJ_FLAG_SCROLLABLE);
 	lv_obj_set_size(grid, MAX_GRID_WIDTH, MAX_GRID_HEIGHT);
 	lv_obj_center(grid); // Optional: center the grid on the screen
 
 #define MAX_GRID_COLS 10
 #define MAX_GRID_ROWS 10
-	static lv_coord_t col_dsc_static[MAX_GRID_COLS + 1];
-	static lv_coord_t row_dsc_static[MAX_GRID_ROWS + 1];
-
 	if (grid_cols > MAX_GRID_COLS || grid_rows > MAX_GRID_ROWS) {
 		// fallback: clamp or handle error
 		grid_cols = LV_MIN(grid_cols, MAX_GRID_COLS);
 		grid_rows = LV_MIN(grid_rows, MAX_GRID_ROWS);
 	}
 
+	// LVGL keeps pointers to the descriptors and every screen's grid stays
+	// alive, so each grid gets its own; they are never freed
+	lv_coord_t *col_dsc = lv_mem_alloc(
+			(grid_cols + 1) * sizeof(lv_coord_t));
+	lv_coord_t *row_dsc = lv_mem_alloc(
+			(grid_rows + 1) * sizeof(lv_coord_t));
+	LV_ASSERT_MALLOC(col_dsc);
+	LV_ASSERT_MALLOC(row_dsc);
+
 	// fill column widths and append sentinel after last real entry
 	for (int i = 0; i < grid_cols; i++) {
-		col_dsc_static[i] = MAX_GRID_WIDTH / grid_cols;
+		col_dsc[i] = MAX_GRID_WIDTH / grid_cols;
 	}
-	col_dsc_static[grid_cols] = LV_GRID_TEMPLATE_LAST;
+	col_dsc[grid_cols] = LV_GRID_TEMPLATE_LAST;
 
 	// fill row heights and append sentinel after last real entry
 	for (int i = 0; i < grid_rows; i++) {
-		row_dsc_static[i] = MAX_GRID_HEIGHT / grid_rows;
+		row_dsc[i] = MAX_GRID_HEIGHT / grid_rows;
 	}
-	row_dsc_static[grid_rows] = LV_GRID_TEMPLATE_LAST;
+	row_dsc[grid_rows] = LV_GRID_TEMPLATE_LAST;
 
 	lv_obj_set_layout(grid, LV_LAYOUT_GRID);
-	lv_obj_set_grid_dsc_array(grid, col_dsc_static, row_dsc_static);
+	lv_obj_set_grid_dsc_array(grid, col_dsc, row_dsc);
 	lv_obj_set_style_pad_all(grid, 0, 0);
 	lv_obj_set_style_pad_row(grid, 0, 0);
 	lv_obj_set_style_pad_column(grid, 0, 0);
@@ -194,71 +275,45 @@ bool center_align) {
 	lv_style_set_text_font(style_label, font);
 }
 
-static arc_with_label_t create_arc_with_label(lv_obj_t *parent, int init_value,
-		int range, const char *units) {
-	arc_with_label_t a = { 0 };
-	a.arc = lv_arc_create(parent);
-	lv_obj_set_size(a.arc, 200, 200);
-	lv_arc_set_range(a.arc, 0, range);
-	lv_arc_set_value(a.arc, init_value);
-	lv_arc_set_bg_angles(a.arc, 0, 270);
-	lv_obj_clear_flag(a.arc, LV_OBJ_FLAG_CLICKABLE);
-	lv_arc_set_mode(a.arc, LV_ARC_MODE_NORMAL);
-	lv_arc_set_rotation(a.arc, 135);
-	lv_obj_set_style_arc_color(a.arc, LV_COLOR_LIGHT_GRAY, LV_PART_MAIN);
-	lv_obj_set_style_arc_width(a.arc, 6, LV_PART_INDICATOR);
-	lv_obj_set_style_bg_opa(a.arc, LV_OPA_TRANSP, LV_PART_KNOB);
-
-	// container for labels
-	lv_obj_t *container = lv_obj_create(a.arc);
-	lv_obj_set_size(container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
-	lv_obj_center(container);
-	lv_obj_set_flex_flow(container, LV_FLEX_FLOW_COLUMN);
-	lv_obj_set_style_bg_opa(container, LV_OPA_TRANSP, 0);
-	lv_obj_set_style_pad_all(container, 0, 0);
-	lv_obj_set_style_border_width(container, 0, 0);
-	lv_obj_set_style_border_opa(container, LV_OPA_TRANSP, 0);
-	lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
-
-	a.value_label = lv_label_create(container);
-	lv_label_set_text_fmt(a.value_label, "%d", init_value);
-	lv_obj_set_style_text_font(a.value_label, &lv_font_montserrat_48, 0);
-	a.units_label = lv_label_create(container);
-	lv_label_set_text(a.units_label, units);
-	lv_obj_set_style_text_font(a.units_label, &lv_font_montserrat_24, 0);
-
-	return a;
+// one object drawing its track, sweep, value and units, see gui/gauge.h
+static lv_obj_t* create_gauge(lv_obj_t *parent, int range, const char *units) {
+	lv_obj_t *gauge = gauge_create(parent, range, units);
+	lv_obj_set_size(gauge, 200, 200);
+	lv_obj_set_style_arc_color(gauge, LV_COLOR_LIGHT_GRAY, LV_PART_MAIN);
+	lv_obj_set_style_arc_width(gauge, 6, LV_PART_INDICATOR);
+	lv_obj_set_style_text_font(gauge, &lv_font_montserrat_24, LV_PART_MAIN);
+	lv_obj_set_style_text_font(gauge,
+			digit_atlas_font(&lv_font_montserrat_48), LV_PART_INDICATOR);
+
+	return gauge;
 }
 
-void set_display_background(void) {
-	lv_obj_set_style_bg_color(lv_scr_act(), lv_color_black(), 0);
-	lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0); // Ensure it's not transparent
-	lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+void set_display_background(lv_obj_t *screen) {
+	lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
+	lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0); // Ensure it's not transparent
+	lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
 }
-void initialize_display_state_logo(void) {
+void initialize_display_state_logo(lv_obj_t *screen) {
 	//	set_display_background(); //needs to be set to white
-	lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
-	lv_obj_set_style_bg_opa(lv_scr_act(), LV_OPA_COVER, 0); // Ensure it's not transparent
-	lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+	lv_obj_set_style_bg_color(screen, lv_color_white(), 0);
+	lv_obj_set_style_bg_opa(screen, LV_OPA_COVER, 0); // Ensure it's not transparent
+	lv_obj_clear_flag(screen, LV_OBJ_FLAG_SCROLLABLE);
 
-	our_logo = lv_img_create(lv_scr_act());   // Create image object
+	our_logo = lv_img_create(screen);   // Create image object
 	lv_img_set_src(our_logo, &our_logo_screenshot);          // Set image source
 	lv_img_set_zoom(our_logo, 450);
 	lv_obj_align(our_logo, LV_ALIGN_CENTER, 0, 0); // Align to center (optional)
 }
 
-void clear_display_state_logo(void) {
-	lv_obj_del(our_logo);
-}
-
-void update_display_state_logo(void) {/*do nothing*/
+void update_display_state_logo(uint32_t dirty) {/*do nothing*/
+	(void) dirty;
 }
 
-void initialize_display_state_pre_drive(void) {
-	set_display_background();
+void initialize_display_state_pre_drive(lv_obj_t *screen) {
+	set_display_background(screen);
 
 	// Create a container for the grid
-	pre_drive_grid = generate_grid(true, 2, 3);
+	pre_drive_grid = generate_grid(screen, true, 2, 3);
 
 	static lv_style_t style_label;
 	generate_style(&style_label, &lv_font_montserrat_30, true, false);
@@ -270,12 +325,21 @@ void initialize_display_state_pre_drive(void) {
 	// DIMENSION HERE IS HARDCODED, CHANGE THIS
 	for (int row = 0; row < 2; row++) {
 		for (int col = 0; col < 2; col++) {
-			lv_obj_t *label = lv_label_create(pre_drive_grid);
-			lv_label_set_recolor(label, true);
-			if (row == 0 && col == 0)
+			lv_obj_t *label;
+			if (row == 0 && col == 0) {
+				// the LV battery and RTD switch, in coloured segments
+				label = span_label_create(pre_drive_grid);
 				lv_obj_add_style(label, &style_label, 0);
-			else
+				span_label_add(label, "LV Batt: ");
+				span_label_add(label, "");
+				span_label_new_line(label);
+				span_label_add(label, "RTD Switch: ");
+				span_label_add(label, "");
+			} else {
+				label = lv_label_create(pre_drive_grid);
 				lv_obj_add_style(label, &style_label_small, 0);
+				label_text_bind(&pre_drive_text[2 * row + col], label);
+			}
 			pre_drive_labels[2 * row + col] = label;
 
 			// Set label to occupy one cell
@@ -286,76 +350,190 @@ void initialize_display_state_pre_drive(void) {
 
 }
 
-void clear_display_state_pre_drive(void) {
-	lv_obj_del(pre_drive_grid);
-}
+void update_display_state_pre_drive(uint32_t dirty) {
+	if (dirty & (TELEMETRY_GROUP(VCU_STATUS) | GUI_GROUP_BLINK)) {
+		lv_color_t lv_battery_color = lv_color_hex(
+				telemetry.vcu.lv_voltage >= 12.7 ? GREEN_HEX : YELLOW_HEX);
+		lv_color_t rtd_color =
+				telemetry.vcu.rtd_switch_state
+						&& (time_count / GUI_BLINK_LOOPS) % 2 != 0 ?
+						lv_color_hex(RED_HEX) : lv_color_white();
+		const char *rtd_state_string =
+				telemetry.vcu.rtd_switch_state ? "ON" : "OFF";
+
+		// segments: "LV Batt: ", voltage, "RTD Switch: ", state
+		span_label_set_float(pre_drive_labels[0], 1, telemetry.vcu.lv_voltage,
+				1, " V");
+		span_label_set_color(pre_drive_labels[0], 1, lv_battery_color);
+		span_label_set_text(pre_drive_labels[0], 3, rtd_state_string);
+		span_label_set_color(pre_drive_labels[0], 3, rtd_color);
+		binding_set_stale(pre_drive_labels[0],
+				STALE(VCU_LV_VOLTAGE) || STALE(VCU_RTD_SWITCH_STATE));
+	}
 
-void update_display_state_pre_drive() {
-	const char *lv_battery_color_state =
-			vcu.lv_voltage >= 12.7 ? LVGL_GREEN : LVGL_YELLOW;
-	const char *rtd_color_state =
-			vcu.rtd_switch_state && time_count % 80 >= 40 ?
-			LVGL_RED :
-															LVGL_WHITE;
-	const char *rtd_state_string = vcu.rtd_switch_state ? "ON" : "OFF";
-
-	lv_label_set_text_fmt(pre_drive_labels[0], "LV Batt: #%s %.1f V#\n"
-			"RTD Switch: #%s %s#", lv_battery_color_state, vcu.lv_voltage,
-			rtd_color_state, rtd_state_string);
-
-	lv_label_set_text_fmt(pre_drive_labels[2], "TS Battery Pack\n"
-			"Temperature: %d °C\n"
-			"SOC: %d%%\n"
-			"Pack Voltage: %.1f\n"
-			"Pack DCL: %d A", battery.temperature, battery.pack_soc,
-			battery.pack_voltage, battery.pack_dcl);
-
-	lv_label_set_text_fmt(pre_drive_labels[1], "Inverters\n"
-			"Inv1 Status: %s\n"
-			"Inv1 Cap Voltage: %.2f\n\n"
-			"Inv2 Status: %s\n"
-			"Inv2 Cap Voltage: %.2f", inverter_statusword(inv1.statusword),
-			inv1.capacitor_voltage, inverter_statusword(inv2.statusword),
-			inv2.capacitor_voltage);
-
-	lv_label_set_text_fmt(pre_drive_labels[3], "VCU Config\n"
-			"Max Torque: %d N*m\n"
-			"Max Inverter Current: %d A\n"
-			"Max RPM: %d", vcu.max_torque, vcu.current_limit, vcu.max_rpm);
+	if (dirty & (TELEMETRY_GROUP(BMS_PACK) | TELEMETRY_GROUP(BMS_LIMITS))) {
+		label_text_t *text = &pre_drive_text[2];
+
+		label_text_begin(text);
+		label_text_str(text, "TS Battery Pack\nTemperature: ");
+		label_text_int(text, telemetry.battery.temperature);
+		label_text_str(text, " °C\nSOC: ");
+		label_text_int(text, telemetry.battery.pack_soc);
+		label_text_str(text, "%\nPack Voltage: ");
+		label_text_float(text, telemetry.battery.pack_voltage, 1);
+		label_text_str(text, "\nPack DCL: ");
+		label_text_int(text, telemetry.battery.pack_dcl);
+		label_text_str(text, " A");
+		label_text_end(text);
+		binding_set_stale(pre_drive_labels[2],
+				STALE(BATTERY_TEMPERATURE) || STALE(BATTERY_PACK_SOC)
+						|| STALE(BATTERY_PACK_VOLTAGE)
+						|| STALE(BATTERY_PACK_DCL));
+	}
 
+	if (dirty
+			& (TELEMETRY_GROUP(INV1_LIMITSSTATUS)
+					| TELEMETRY_GROUP(INV2_LIMITSSTATUS)
+					| TELEMETRY_GROUP(INV1_TEMPSVOLTAGE)
+					| TELEMETRY_GROUP(INV2_TEMPSVOLTAGE))) {
+		label_text_t *text = &pre_drive_text[1];
+
+		label_text_begin(text);
+		label_text_str(text, "Inverters\nInv1 Status: ");
+		label_text_str(text, inverter_statusword(telemetry.inv1.statusword));
+		label_text_str(text, "\nInv1 Cap Voltage: ");
+		label_text_float(text, telemetry.inv1.capacitor_voltage, 2);
+		label_text_str(text, "\n\nInv2 Status: ");
+		label_text_str(text, inverter_statusword(telemetry.inv2.statusword));
+		label_text_str(text, "\nInv2 Cap Voltage: ");
+		label_text_float(text, telemetry.inv2.capacitor_voltage, 2);
+		label_text_end(text);
+		binding_set_stale(pre_drive_labels[1],
+				STALE(INV1_STATUSWORD) || STALE(INV1_CAPACITOR_VOLTAGE)
+						|| STALE(INV2_STATUSWORD)
+						|| STALE(INV2_CAPACITOR_VOLTAGE));
+	}
+
+	if (dirty & TELEMETRY_GROUP(VCU_STATUS)) {
+		label_text_t *text = &pre_drive_text[3];
+
+		label_text_begin(text);
+		label_text_str(text, "VCU Config\nMax Torque: ");
+		label_text_int(text, telemetry.vcu.max_torque);
+		label_text_str(text, " N*m\nMax Inverter Current: ");
+		label_text_int(text, telemetry.vcu.current_limit);
+		label_text_str(text, " A\nMax RPM: ");
+		label_text_int(text, telemetry.vcu.max_rpm);
+		label_text_end(text);
+		binding_set_stale(pre_drive_labels[3], STALE(VCU_CURRENT_LIMIT));
+	}
 }
 
-void initialize_display_state_drive(void) {
-	set_display_background();
+static const binding_band_t battery_temp_bands[] = {
+	{ .from = INT32_MIN, .color = GREEN_HEX },
+	{ .from = 36, .color = YELLOW_HEX },
+	{ .from = 46, .color = RED_HEX },
+	{ .from = 71, .color = 0xffffff }
+};
+
+static const binding_ramp_t battery_temp_ramp = {
+	.bands = battery_temp_bands,
+	.count = 4,
+	.hysteresis = 1
+};
+
+static const binding_band_t battery_soc_bands[] = {
+	{ .from = INT32_MIN, .color = 0xffffff },
+	{ .from = 0, .color = RED_HEX },
+	{ .from = 20, .color = YELLOW_HEX },
+	{ .from = 50, .color = GREEN_HEX }
+};
+
+static const binding_ramp_t battery_soc_ramp = {
+	.bands = battery_soc_bands,
+	.count = 4,
+	.hysteresis = 1
+};
+
+static int32_t read_mph(const telemetry_t *t) {
+	return (int32_t) ((t->inv1.motor_speed + t->inv2.motor_speed) * 0.02975f
+			/ 5.0f);
+}
 
-	drive_grid = generate_grid(false, 2, 3);
+// what the drive screen shows of the telemetry, see gui/binding.h
+static const binding_t drive_bindings[] = {
+	{ .obj = &battery_temp_readout, .widget = BINDING_READOUT,
+		BINDING_FIELD(battery.temperature),
+		.groups = TELEMETRY_GROUP(BMS_LIMITS),
+		.stale = BINDING_STALE(BATTERY_TEMPERATURE),
+		.ramp = &battery_temp_ramp },
+	{ .obj = &battery_soc_readout, .widget = BINDING_READOUT,
+		BINDING_FIELD(battery.pack_soc),
+		.groups = TELEMETRY_GROUP(BMS_PACK),
+		.stale = BINDING_STALE(BATTERY_PACK_SOC) },
+	{ .obj = &battery_soc_bar, .widget = BINDING_BAR,
+		BINDING_FIELD(battery.pack_soc),
+		.groups = TELEMETRY_GROUP(BMS_PACK),
+		.stale = BINDING_STALE(BATTERY_PACK_SOC),
+		.ramp = &battery_soc_ramp },
+	{ .obj = &motor_temp_label, .widget = BINDING_SPAN, .segment = 0,
+		.format = { .digits = 4, .units = " °C" },
+		BINDING_FIELD(inv1.motor_temp),
+		.groups = TELEMETRY_GROUP(INV1_TEMPSVOLTAGE)
+				| TELEMETRY_GROUP(INV2_TEMPSVOLTAGE),
+		.stale = BINDING_STALE(INV1_MOTOR_TEMP)
+				| BINDING_STALE(INV2_MOTOR_TEMP) },
+	{ .obj = &motor_temp_label, .widget = BINDING_SPAN, .segment = 2,
+		.format = { .digits = 4, .units = " °C" },
+		BINDING_FIELD(inv2.motor_temp),
+		.groups = TELEMETRY_GROUP(INV1_TEMPSVOLTAGE)
+				| TELEMETRY_GROUP(INV2_TEMPSVOLTAGE),
+		.stale = BINDING_STALE(INV1_MOTOR_TEMP)
+				| BINDING_STALE(INV2_MOTOR_TEMP) },
+	{ .obj = &rpm_gauge, .widget = BINDING_GAUGE, .read = read_mph,
+		.groups = TELEMETRY_GROUP(INV1_TORQUESPEED)
+				| TELEMETRY_GROUP(INV2_TORQUESPEED),
+		.stale = BINDING_STALE(INV1_MOTOR_SPEED)
+				| BINDING_STALE(INV2_MOTOR_SPEED) }
+};
+
+static binding_table_t drive_binding_table;
+
+void initialize_display_state_drive(lv_obj_t *screen) {
+	set_display_background(screen);
+
+	drive_grid = generate_grid(screen, false, 2, 3);
+
+	// the gauges change with every speed message; on the overlay layer their
+	// redraws leave the rest of the screen alone
+	lv_obj_t *gauge_grid = drive_grid;
+	int gauge_row = 1;
+	if (overlay_drive_screen != NULL) {
+		gauge_grid = generate_grid(overlay_drive_screen, false, 1, 3);
+		gauge_row = 0;
+	}
 
 	// RPM
-	arc_with_label_t rpm = create_arc_with_label(drive_grid, 0, 60, "rpm");
-	rpm_arc = rpm.arc;
-	rpm_arc_label = rpm.value_label;
+	rpm_gauge = create_gauge(gauge_grid, 60, "rpm");
 	// Align it to the center of the cell
-	int row = 1;
+	int row = gauge_row;
 	int col = 0;
-	lv_obj_set_grid_cell(rpm_arc, LV_GRID_ALIGN_CENTER, col, 1,
+	lv_obj_set_grid_cell(rpm_gauge, LV_GRID_ALIGN_CENTER, col, 1,
 			LV_GRID_ALIGN_CENTER, row, 1);
 
 	// VEHICLE SPEED
-	arc_with_label_t speed = create_arc_with_label(drive_grid, 0, 150, "mph");
-	speed_arc = speed.arc;
+	speed_gauge = create_gauge(gauge_grid, 150, "mph");
 	// Align it to the center of the cell
-	row = 1;
+	row = gauge_row;
 	col = 1;
-	lv_obj_set_grid_cell(speed_arc, LV_GRID_ALIGN_CENTER, col, 1,
+	lv_obj_set_grid_cell(speed_gauge, LV_GRID_ALIGN_CENTER, col, 1,
 			LV_GRID_ALIGN_CENTER, row, 1);
 
 	// ACCELERATION
-	arc_with_label_t acceleration = create_arc_with_label(drive_grid, 0, 20,
-			"G");
-	acceleration_arc = acceleration.arc;
-	row = 1;
+	acceleration_gauge = create_gauge(gauge_grid, 20, "G");
+	row = gauge_row;
 	col = 2;
-	lv_obj_set_grid_cell(acceleration_arc, LV_GRID_ALIGN_CENTER, col, 1,
+	lv_obj_set_grid_cell(acceleration_gauge, LV_GRID_ALIGN_CENTER, col, 1,
 			LV_GRID_ALIGN_CENTER, row, 1);
 
 	// DIAGNOSTICS
@@ -383,7 +561,6 @@ void initialize_display_state_drive(void) {
 	generate_style(&limiting_factor_style, &lv_font_montserrat_48, false, true);
 	current_limiting_factor_label = lv_label_create(diagnostics_container);
 	lv_obj_add_style(current_limiting_factor_label, &limiting_factor_style, 0);
-	lv_label_set_recolor(current_limiting_factor_label, true);
 	lv_label_set_text(current_limiting_factor_label, "Banana");
 
 	row = 0;
@@ -414,14 +591,16 @@ void initialize_display_state_drive(void) {
 	//add battery temperature label
 	static lv_style_t battery_temp_style;
 	generate_style(&battery_temp_style, &lv_font_montserrat_48, false, true);
-	battery_temp_label = lv_label_create(battery_container);
-	lv_obj_add_style(battery_temp_label, &battery_temp_style, 0);
-	lv_label_set_recolor(battery_temp_label, true);
+	battery_temp_readout = readout_create(battery_container, 3, NULL, " °C");
+	lv_obj_add_style(battery_temp_readout, &battery_temp_style, 0);
+	lv_obj_set_style_text_font(battery_temp_readout,
+			digit_atlas_font(&lv_font_montserrat_48), LV_PART_INDICATOR);
 
 	//add soc text label
-	battery_soc_label = lv_label_create(battery_container);
-	lv_obj_add_style(battery_soc_label, &text_style, 0);
-	lv_label_set_text(battery_soc_label, "SOC: 0\%");
+	battery_soc_readout = readout_create(battery_container, 3, "SOC: ", "%");
+	lv_obj_add_style(battery_soc_readout, &text_style, 0);
+	lv_obj_set_style_text_font(battery_soc_readout,
+			digit_atlas_font(&lv_font_montserrat_24), LV_PART_INDICATOR);
 
 	//add battery SOC bar
 	battery_soc_bar = lv_bar_create(battery_container);
@@ -468,122 +647,184 @@ void initialize_display_state_drive(void) {
 	generate_style(&inverter_temp_style, &lv_font_montserrat_36, false, true);
 	inverter_temp_label = lv_label_create(inverter_container);
 	lv_obj_add_style(inverter_temp_label, &inverter_temp_style, 0);
-	lv_label_set_recolor(inverter_temp_label, true);
 
 	//add motor text label
 	lv_obj_t *motor_text_label = lv_label_create(inverter_container);
 	lv_obj_add_style(motor_text_label, &text_style, 0);
 	lv_label_set_text(motor_text_label, "Motors");
 
-	//add motor temperature label
-	motor_temp_label = lv_label_create(inverter_container);
+	//add motor temperature label: inverter 1, a separator, inverter 2
+	motor_temp_label = span_label_create(inverter_container);
 	lv_obj_add_style(motor_temp_label, &inverter_temp_style, 0);
-	lv_label_set_recolor(motor_temp_label, true);
+	span_label_add(motor_temp_label, "");
+	span_label_add(motor_temp_label, "\t|\t");
+	span_label_add(motor_temp_label, "");
+	span_label_set_color(motor_temp_label, 0, lv_color_hex(GREEN_HEX));
+	span_label_set_color(motor_temp_label, 1, LV_COLOR_LIGHT_GRAY);
+	span_label_set_color(motor_temp_label, 2, lv_color_hex(GREEN_HEX));
 
 	// Align it to the center of the cell
 	row = 0;
 	col = 1;
 	lv_obj_set_grid_cell(inverter_container, LV_GRID_ALIGN_CENTER, col, 1,
 			LV_GRID_ALIGN_CENTER, row, 1);
-}
 
-void clear_display_state_drive(void) {
-	lv_obj_del(drive_grid);
+	// DISPLAY PORT FRAME TIME AND RAM, along the bottom edge
+	display_stats_label = lv_label_create(screen);
+	lv_obj_set_style_text_font(display_stats_label, &lv_font_montserrat_14, 0);
+	lv_obj_set_style_text_color(display_stats_label, LV_COLOR_LIGHT_GRAY, 0);
+	lv_obj_align(display_stats_label, LV_ALIGN_BOTTOM_MID, 0, -4);
+	lv_label_set_text(display_stats_label, "");
+
+	// the titles and gauge tracks never change: from now on redraws copy
+	// them from snapshots
+	chrome_cache_arc(rpm_gauge);
+	chrome_cache_arc(speed_gauge);
+	chrome_cache_arc(acceleration_gauge);
+	chrome_cache_widget(battery_text_label);
+	chrome_cache_widget(inverter_text_label);
+	chrome_cache_widget(motor_text_label);
+	chrome_cache_widget(limiting_factor_label);
+
+	binding_table_init(&drive_binding_table, drive_bindings,
+			sizeof(drive_bindings) / sizeof(drive_bindings[0]));
 }
 
-int green_yellow_red_range(int value, int greenThreshold, int yellowThreshold,
-		int redThreshold) {
-	if (value >= greenThreshold)
-		return 3;
-	else if (value >= yellowThreshold)
-		return 2;
-	else if (value >= redThreshold)
-		return 1;
+// average frame time since the last call, so the two display port modes can
+// be compared on the car
+static void update_display_stats(void) {
+	static gui_frame_stats_t previous;
+	static cpu_load_window_t window;
+	gui_frame_stats_t stats;
+	lv_mem_monitor_t mem;
+
+	gui_stats_read(&stats);
+	lv_mem_monitor(&mem);
+
+	uint32_t frames = stats.frames - previous.frames;
+	uint32_t render_us = stats.render_us_total - previous.render_us_total;
+	uint32_t idle = cpu_idle_permille(&window);
+	previous = stats;
+	if (frames == 0) {
+		return;
+	}
 
-	return 0;
+	label_set_text_fmt(display_stats_label,
+			"%s: frame %" PRIu32 " us avg, %" PRIu32 " us last    "
+					"RAM: display %" PRIu32 " KB, LVGL %" PRIu32 "/%" PRIu32
+					" KB    idle %" PRIu32 "%%",
+			stats.display_mode ? stats.display_mode : "-",
+			render_us / frames, stats.render_us_last,
+			stats.display_ram_bytes / 1024U,
+			(uint32_t) (mem.total_size - mem.free_size) / 1024U,
+			(uint32_t) mem.total_size / 1024U, idle / 10U);
 }
 
-int red_yellow_green_range(int value, int greenThreshold, int yellowThreshold,
-		int redThreshold) {
-	if (value <= greenThreshold)
-		return 3;
-	else if (value <= yellowThreshold)
-		return 2;
-	else if (value <= redThreshold)
-		return 1;
-
-	return 0;
-}
+void update_display_state_drive(uint32_t dirty) {
+	// only the bindings of changed messages, and LVGL only where what they
+	// show changes
+	binding_table_update(&drive_binding_table, &telemetry, dirty);
 
-void update_display_state_drive() {
-	//battery temperature
-	const char *battery_temp_color;
-	switch (red_yellow_green_range(battery.temperature, 35, 45, 70)) {
-	case 3:
-		battery_temp_color = LVGL_GREEN;
-		break;
-	case 2:
-		battery_temp_color = LVGL_YELLOW;
-		break;
-	case 1:
-		battery_temp_color = LVGL_RED;
-		break;
-	default:
-		battery_temp_color = LVGL_WHITE;
+	if (dirty & GUI_GROUP_PERIODIC) {
+		update_display_stats();
 	}
-	lv_label_set_text_fmt(battery_temp_label, "#%s %d °C#", battery_temp_color,
-			battery.temperature);
-
-	//battery SOC
-	uint32_t battery_soc_color;
-	switch (green_yellow_red_range(battery.pack_soc, 50, 20, 0)) {
-	case 3:
-		battery_soc_color = GREEN_HEX;
-		break;
-	case 2:
-		battery_soc_color = YELLOW_HEX;
-		break;
-	case 1:
-		battery_soc_color = RED_HEX;
-		break;
-	default:
-		battery_soc_color = 0xffffff;
-		break;
-	}
-	lv_label_set_text_fmt(battery_soc_label, "SOC: %d%%", battery.pack_soc);
-	lv_bar_set_value(battery_soc_bar, battery.pack_soc, LV_ANIM_OFF);
-	lv_obj_set_style_bg_color(battery_soc_bar, lv_color_hex(battery_soc_color),
-			LV_PART_INDICATOR);
-
-	//motor temperatures
-	lv_label_set_text_fmt(motor_temp_label,
-			"#%s %d °C#\t#646464 |#\t#%s %d °C#",
-			LVGL_GREEN, inv1.motor_temp, LVGL_GREEN, inv2.motor_temp);
-
-	//speed
-	int mph = (inv1.motor_speed + inv2.motor_speed) * 0.02975f / 5.0f;
-	lv_arc_set_value(rpm_arc, mph);
-	lv_label_set_text_fmt(rpm_arc_label, "%d", mph);
-
 }
 
-void initialize_display_state_diagnostic(void) {
-	set_display_background();
+void initialize_display_state_diagnostic(lv_obj_t *screen) {
+	set_display_background(screen);
 
-	diagnostic_label = lv_label_create(lv_scr_act());
-	lv_obj_set_size(diagnostic_label, 800, 480);
-	lv_obj_center(diagnostic_label);
+	diagnostic_label = lv_label_create(screen);
+	lv_obj_set_size(diagnostic_label, 800, 80);
+	lv_obj_align(diagnostic_label, LV_ALIGN_TOP_LEFT, 0, 0);
 
 	static lv_style_t style_label;
 	generate_style(&style_label, &lv_font_montserrat_30, false, false);
 
 	lv_obj_add_style(diagnostic_label, &style_label, 0);
+
+	// one row per CAN database message, plus a header and the unknown ID row
+	bus_stats_table = lv_table_create(screen);
+	lv_obj_set_size(bus_stats_table, 800, 400);
+	lv_obj_align(bus_stats_table, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+	lv_table_set_col_cnt(bus_stats_table, BUS_STATS_COLS);
+	lv_table_set_row_cnt(bus_stats_table, CAN_STATS_SLOTS + 1);
+
+	static lv_style_t style_table;
+	generate_style(&style_table, &lv_font_montserrat_14, false, false);
+	lv_style_set_pad_top(&style_table, 2);
+	lv_style_set_pad_bottom(&style_table, 2);
+
+	lv_obj_add_style(bus_stats_table, &style_table, 0);
+	lv_obj_add_style(bus_stats_table, &style_table, LV_PART_ITEMS);
+
+	static const char *const headers[BUS_STATS_COLS] = { "Message", "ID",
+			"Count", "Rate Hz", "Period ms", "Max ms", "Jitter ms", "Latency us",
+			"Age ms" };
+	static const lv_coord_t widths[BUS_STATS_COLS] = { 160, 100, 70, 70, 80,
+			70, 80, 90, 80 };
+
+	for (uint16_t col = 0; col < BUS_STATS_COLS; col++) {
+		lv_table_set_col_width(bus_stats_table, col, widths[col]);
+		lv_table_set_cell_value(bus_stats_table, 0, col, headers[col]);
+	}
+
+	for (uint32_t slot = 0; slot < CAN_STATS_SLOTS; slot++) {
+		lv_table_set_cell_value(bus_stats_table, slot + 1, 0,
+				can_stats_name(slot));
+		if (slot < CAN_DB_MESSAGE_COUNT) {
+			lv_table_set_cell_value_fmt(bus_stats_table, slot + 1, 1,
+					"0x%" PRIX32, can_db.keys[slot] & ~CAN_KEY_EXTENDED);
+		} else {
+			lv_table_set_cell_value(bus_stats_table, slot + 1, 1, "-");
+		}
+	}
 }
 
-void clear_display_state_diagnostic(void) {
-	lv_obj_del(diagnostic_label);
+static void update_bus_stats_row(uint16_t row, uint32_t slot, uint32_t now_us) {
+	can_id_stats_t stats;
+	can_stats_read(slot, &stats);
+
+	uint32_t period = can_stats_mean_period_us(&stats);
+
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 2, "%" PRIu32,
+			stats.count);
+	if (period == 0) {
+		for (uint16_t col = 3; col < BUS_STATS_COLS; col++) {
+			lv_table_set_cell_value(bus_stats_table, row, col, "-");
+		}
+		return;
+	}
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 3, "%" PRIu32,
+			1000000U / period);
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 4,
+			"%" PRIu32 ".%" PRIu32, period / 1000U, period / 100U % 10U);
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 5, "%" PRIu32,
+			stats.max_period_us / 1000U);
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 6,
+			"%" PRIu32 ".%" PRIu32, stats.jitter_us / 1000U,
+			stats.jitter_us / 100U % 10U);
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 7,
+			"%" PRIu32 "/%" PRIu32, stats.latency_us, stats.max_latency_us);
+	lv_table_set_cell_value_fmt(bus_stats_table, row, 8, "%" PRIu32,
+			(now_us - stats.last_seen_us) / 1000U);
 }
 
-void update_display_state_diagnostic() {
-	lv_label_set_text_fmt(diagnostic_label, "VCU Fault: %d", vcu.fault);
+void update_display_state_diagnostic(uint32_t dirty) {
+	// statistics move with every frame, so refresh them on a timer
+	if (!(dirty & (TELEMETRY_GROUP(VCU_STATUS) | GUI_GROUP_PERIODIC))) {
+		return;
+	}
+
+	uint32_t now_us = timebase_us();
+	uint32_t load = can_stats_bus_load_permille(now_us);
+
+	label_set_text_fmt(diagnostic_label,
+			"VCU Fault: %d    Bus load: %" PRIu32 ".%" PRIu32 "%%",
+			telemetry.vcu.fault, load / 10U, load % 10U);
+
+	if (dirty & GUI_GROUP_PERIODIC) {
+		for (uint32_t slot = 0; slot < CAN_STATS_SLOTS; slot++) {
+			update_bus_stats_row(slot + 1, slot, now_us);
+		}
+	}
 }
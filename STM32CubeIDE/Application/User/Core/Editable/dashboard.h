@@ -13,15 +13,18 @@
 #include "cmsis_os2.h"
 #include "FreeRTOS.h"
 #include "lv_conf.h"
+#include "fdcan/can_db.h"
 #include <stdbool.h>
 
 #define LOGO_TIME 350 //time to show logo before switching to pre-drive state
+#define GUI_MIN_REFRESH_MS 30 //minimum time between widget updates, one LVGL refresh period
+#define GUI_BLINK_LOOPS 40 //GUI loops per blink phase
+#define GUI_PERIODIC_LOOPS 20 //GUI loops between updates of time based widgets
 
-#define LVGL_GREEN "009632"
-#define LVGL_YELLOW "c8c800"
-#define LVGL_RED "ff0000"
-#define LVGL_BLACK "000000"
-#define LVGL_WHITE "ffffff"
+//GUI events that share the telemetry dirty group mask with the CAN messages
+#define GUI_GROUP_BLINK (1U << 31)
+#define GUI_GROUP_PERIODIC (1U << 30)
+#define BUS_STATS_COLS 9 //columns of the CAN bus statistics table
 
 #define GREEN_HEX 0x009632
 #define YELLOW_HEX 0xc8c800
@@ -30,6 +33,8 @@
 
 #define INVERTER_CUTOFF_TEMP 86
 
+#define STALE_OPA LV_OPA_40 //opacity of values whose CAN signals timed out
+
 //persistent lv_objs for logo state
 extern lv_obj_t *our_logo;
 
@@ -39,19 +44,20 @@ extern lv_obj_t *pre_drive_labels[4];
 
 //persistent lv_objs for drive state
 extern lv_obj_t *drive_grid;
-extern lv_obj_t *rpm_arc;
-extern lv_obj_t *rpm_arc_label;
-extern lv_obj_t *speed_arc;
-extern lv_obj_t *acceleration_arc;
-extern lv_obj_t *battery_temp_label;
+extern lv_obj_t *rpm_gauge;
+extern lv_obj_t *speed_gauge;
+extern lv_obj_t *acceleration_gauge;
+extern lv_obj_t *battery_temp_readout;
 extern lv_obj_t *current_limiting_factor_label;
 extern lv_obj_t *battery_soc_bar;
-extern lv_obj_t *battery_soc_label;
+extern lv_obj_t *battery_soc_readout;
 extern lv_obj_t *inverter_temp_label;
 extern lv_obj_t *motor_temp_label;
+extern lv_obj_t *display_stats_label;
 
 //persistent lv_objs for diagnostic state
 extern lv_obj_t *diagnostic_label;
+extern lv_obj_t *bus_stats_table;
 
 extern const lv_img_dsc_t our_logo_screenshot;
 
@@ -59,6 +65,8 @@ typedef enum {
 	UNINITIALIZED = 0, LOGO = 1, PRE_DRIVE = 2, DRIVE = 3, DIAGNOSTIC = 4
 } display_state_t;
 
+#define DISPLAY_STATE_COUNT (DIAGNOSTIC + 1)
+
 typedef enum {
 	STATUSWORD_NOTREADY = 0x01,
 	STATUSWORD_SHUTDOWN = 0x02,
@@ -102,23 +110,22 @@ typedef struct {
 	bool rtd_switch_state;
 	uint8_t fault;
 	bool active;
-	uint32_t last_comm_time;
 } vcu_t;
 
 typedef struct {
-	lv_obj_t *arc;
-	lv_obj_t *value_label;
-	lv_obj_t *units_label;
-} arc_with_label_t;
+	inv_t inv1;
+	inv_t inv2;
+	battery_t battery;
+	vcu_t vcu;
+	uint32_t signal_rx_us[CAN_DB_SIGNAL_COUNT]; // see can_db_t.rx_us
+	uint8_t stale[CAN_DB_SIGNAL_COUNT]; // 1 once past its timeout
+	uint32_t stale_count;
+} telemetry_t;
 
 extern uint32_t time_count;
 
-extern inv_t inv1;
-extern inv_t inv2;
-
-extern battery_t battery;
-
-extern vcu_t vcu;
+// GUI copy of the CAN telemetry, refreshed once per GUI loop
+extern telemetry_t telemetry;
 
 extern display_state_t current_display_state;
 extern display_state_t commanded_display_state;
@@ -128,24 +135,24 @@ void update_battery(lv_obj_t *label, battery_t *battery);
 void update_vcu(lv_obj_t *label, vcu_t *vcu);
 
 void initialize_display_colors(void);
-void initialize_display_state(display_state_t display_state);
-void initialize_display_state_logo(void);
-void initialize_display_state_pre_drive(void);
-void initialize_display_state_drive(void);
-void initialize_display_state_diagnostic(void);
-
-void clear_display_state(display_state_t display_state);
-void clear_display_state_logo(void);
-void clear_display_state_pre_drive(void);
-void clear_display_state_drive(void);
-void clear_display_state_diagnostic(void);
-
-void update_display_state(display_state_t display_state);
-void update_display_state_logo(void);
-void update_display_state_pre_drive(void);
-void update_display_state_drive(void);
-void update_display_state_diagnostic(void);
-
-void set_display_background(void);
+void initialize_display_state(display_state_t display_state,
+		lv_obj_t *screen);
+void initialize_display_state_logo(lv_obj_t *screen);
+void initialize_display_state_pre_drive(lv_obj_t *screen);
+void initialize_display_state_drive(lv_obj_t *screen);
+void initialize_display_state_diagnostic(lv_obj_t *screen);
+
+// build every screen once and show the logo; switching is then only a load
+void dashboard_set_overlay_display(lv_disp_t *disp);
+void initialize_display_screens(void);
+void load_display_state(display_state_t display_state);
+
+void update_display_state(display_state_t display_state, uint32_t dirty);
+void update_display_state_logo(uint32_t dirty);
+void update_display_state_pre_drive(uint32_t dirty);
+void update_display_state_drive(uint32_t dirty);
+void update_display_state_diagnostic(uint32_t dirty);
+
+void set_display_background(lv_obj_t *screen);
 
 #endif /* APPLICATION_USER_CORE_EDITABLE_DASHBOARD_H_ */
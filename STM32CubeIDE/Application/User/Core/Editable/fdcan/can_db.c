@@ -0,0 +1,167 @@
+/* Generated by Tools/dbc2c.py from our5.dbc - do not edit */
+
+#include "can_db.h"
+#include "../telemetry/telemetry.h"
+
+static const uint32_t can_db_keys[CAN_DB_MESSAGE_COUNT] = {
+	CAN_DB_BMS_PACK_KEY,
+	CAN_DB_BMS_LIMITS_KEY,
+	CAN_DB_VCU_STATUS_KEY,
+	CAN_DB_INV1_TORQUESPEED_KEY,
+	CAN_DB_INV2_TORQUESPEED_KEY,
+	CAN_DB_INV1_LIMITSSTATUS_KEY,
+	CAN_DB_INV2_LIMITSSTATUS_KEY,
+	CAN_DB_INV1_TEMPSVOLTAGE_KEY,
+	CAN_DB_INV2_TEMPSVOLTAGE_KEY,
+};
+
+static const can_message_t can_db_messages[CAN_DB_MESSAGE_COUNT] = {
+	{ .first_signal = 0, .signal_count = 3, .length = 8 }, // BMS_Pack
+	{ .first_signal = 3, .signal_count = 2, .length = 8 }, // BMS_Limits
+	{ .first_signal = 5, .signal_count = 8, .length = 8 }, // VCU_Status
+	{ .first_signal = 13, .signal_count = 3, .length = 8 }, // INV1_TorqueSpeed
+	{ .first_signal = 16, .signal_count = 3, .length = 8 }, // INV2_TorqueSpeed
+	{ .first_signal = 19, .signal_count = 3, .length = 8 }, // INV1_LimitsStatus
+	{ .first_signal = 22, .signal_count = 3, .length = 8 }, // INV2_LimitsStatus
+	{ .first_signal = 25, .signal_count = 3, .length = 8 }, // INV1_TempsVoltage
+	{ .first_signal = 28, .signal_count = 3, .length = 8 }, // INV2_TempsVoltage
+};
+
+static const can_signal_t can_db_signals[CAN_DB_SIGNAL_COUNT] = {
+	// BMS_Pack
+	{ CAN_SIGNAL_DEST(battery.pack_current), .scale = 0.1f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 48, .length = 16, .flags = CAN_SIG_BIG_ENDIAN },
+	{ CAN_SIGNAL_DEST(battery.pack_voltage), .scale = 0.1f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 48, .length = 16, .flags = CAN_SIG_BIG_ENDIAN },
+	{ CAN_SIGNAL_DEST(battery.pack_soc), .scale = 0.5f, .offset = 0.0f,
+		.byte_offset = 4, .end = 5, .shift = 0, .length = 8, .flags = 0 },
+	// BMS_Limits
+	{ CAN_SIGNAL_DEST(battery.pack_dcl), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 48, .length = 16, .flags = CAN_SIG_BIG_ENDIAN | CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(battery.temperature), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 5, .shift = 0, .length = 8, .flags = CAN_SIG_RAW },
+	// VCU_Status
+	{ CAN_SIGNAL_DEST(vcu.lv_voltage), .scale = 0.00491214369387f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(vcu.current_limit), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 5, .shift = 0, .length = 8, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv2.active), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 6, .end = 7, .shift = 0, .length = 1, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv1.active), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 6, .end = 7, .shift = 1, .length = 1, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(battery.active), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 6, .end = 7, .shift = 2, .length = 1, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(vcu.rtd), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 6, .end = 7, .shift = 3, .length = 1, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(vcu.rtd_switch_state), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 6, .end = 7, .shift = 4, .length = 1, .flags = CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(vcu.fault), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 7, .end = 8, .shift = 0, .length = 8, .flags = CAN_SIG_RAW },
+	// INV1_TorqueSpeed
+	{ CAN_SIGNAL_DEST(inv1.output_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv1.motor_speed), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv1.battery_current), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 6, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	// INV2_TorqueSpeed
+	{ CAN_SIGNAL_DEST(inv2.output_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv2.motor_speed), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv2.battery_current), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 6, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	// INV1_LimitsStatus
+	{ CAN_SIGNAL_DEST(inv1.available_forward_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv1.available_reverse_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv1.statusword), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 5, .shift = 0, .length = 8, .flags = CAN_SIG_RAW },
+	// INV2_LimitsStatus
+	{ CAN_SIGNAL_DEST(inv2.available_forward_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv2.available_reverse_torque), .scale = 0.00625f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = 0 },
+	{ CAN_SIGNAL_DEST(inv2.statusword), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 4, .end = 5, .shift = 0, .length = 8, .flags = CAN_SIG_RAW },
+	// INV1_TempsVoltage
+	{ CAN_SIGNAL_DEST(inv1.temperature), .scale = -1.0f, .offset = 86.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED },
+	{ CAN_SIGNAL_DEST(inv1.motor_temp), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv1.capacitor_voltage), .scale = 0.0625f, .offset = 0.0f,
+		.byte_offset = 4, .end = 6, .shift = 0, .length = 16, .flags = 0 },
+	// INV2_TempsVoltage
+	{ CAN_SIGNAL_DEST(inv2.temperature), .scale = -1.0f, .offset = 86.0f,
+		.byte_offset = 0, .end = 2, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED },
+	{ CAN_SIGNAL_DEST(inv2.motor_temp), .scale = 1.0f, .offset = 0.0f,
+		.byte_offset = 2, .end = 4, .shift = 0, .length = 16, .flags = CAN_SIG_SIGNED | CAN_SIG_RAW },
+	{ CAN_SIGNAL_DEST(inv2.capacitor_voltage), .scale = 0.0625f, .offset = 0.0f,
+		.byte_offset = 4, .end = 6, .shift = 0, .length = 16, .flags = 0 },
+};
+
+static const uint32_t can_db_timeouts_us[CAN_DB_SIGNAL_COUNT] = {
+	// BMS_Pack
+	500000U, // battery_pack_current
+	500000U, // battery_pack_voltage
+	500000U, // battery_pack_soc
+	// BMS_Limits
+	500000U, // battery_pack_dcl
+	500000U, // battery_temperature
+	// VCU_Status
+	500000U, // vcu_lv_voltage
+	500000U, // vcu_current_limit
+	500000U, // inv2_active
+	500000U, // inv1_active
+	500000U, // battery_active
+	500000U, // vcu_rtd
+	500000U, // vcu_rtd_switch_state
+	500000U, // vcu_fault
+	// INV1_TorqueSpeed
+	500000U, // inv1_output_torque
+	500000U, // inv1_motor_speed
+	500000U, // inv1_battery_current
+	// INV2_TorqueSpeed
+	500000U, // inv2_output_torque
+	500000U, // inv2_motor_speed
+	500000U, // inv2_battery_current
+	// INV1_LimitsStatus
+	500000U, // inv1_available_forward_torque
+	500000U, // inv1_available_reverse_torque
+	500000U, // inv1_statusword
+	// INV2_LimitsStatus
+	500000U, // inv2_available_forward_torque
+	500000U, // inv2_available_reverse_torque
+	500000U, // inv2_statusword
+	// INV1_TempsVoltage
+	500000U, // inv1_temperature
+	500000U, // inv1_motor_temp
+	500000U, // inv1_capacitor_voltage
+	// INV2_TempsVoltage
+	500000U, // inv2_temperature
+	500000U, // inv2_motor_temp
+	500000U, // inv2_capacitor_voltage
+};
+
+static const char *const can_db_names[CAN_DB_MESSAGE_COUNT] = {
+	"BMS_Pack",
+	"BMS_Limits",
+	"VCU_Status",
+	"INV1_TorqueSpeed",
+	"INV2_TorqueSpeed",
+	"INV1_LimitsStatus",
+	"INV2_LimitsStatus",
+	"INV1_TempsVoltage",
+	"INV2_TempsVoltage",
+};
+
+const can_db_t can_db = {
+	.keys = can_db_keys,
+	.messages = can_db_messages,
+	.signals = can_db_signals,
+	.names = can_db_names,
+	.rx_us = signal_rx_us,
+	.timeouts_us = can_db_timeouts_us,
+	.message_count = CAN_DB_MESSAGE_COUNT
+};
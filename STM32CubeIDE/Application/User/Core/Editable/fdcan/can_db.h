@@ -0,0 +1,68 @@
+/* Generated by Tools/dbc2c.py from our5.dbc - do not edit */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DB_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DB_H_
+
+#include "can_decode.h"
+
+#define CAN_DB_MESSAGE_COUNT 9
+#define CAN_DB_SIGNAL_COUNT 31
+
+// Lookup keys of the decoded messages, see CAN_KEY()
+#define CAN_DB_BMS_PACK_KEY 0x000006b0U
+#define CAN_DB_BMS_LIMITS_KEY 0x000006b1U
+#define CAN_DB_VCU_STATUS_KEY 0x000007a4U
+#define CAN_DB_INV1_TORQUESPEED_KEY 0x8118ff71U
+#define CAN_DB_INV2_TORQUESPEED_KEY 0x8118ff72U
+#define CAN_DB_INV1_LIMITSSTATUS_KEY 0x8119ff71U
+#define CAN_DB_INV2_LIMITSSTATUS_KEY 0x8119ff72U
+#define CAN_DB_INV1_TEMPSVOLTAGE_KEY 0x811aff71U
+#define CAN_DB_INV2_TEMPSVOLTAGE_KEY 0x811aff72U
+
+// Message indices, e.g. for telemetry dirty groups
+#define CAN_DB_BMS_PACK_MESSAGE 0
+#define CAN_DB_BMS_LIMITS_MESSAGE 1
+#define CAN_DB_VCU_STATUS_MESSAGE 2
+#define CAN_DB_INV1_TORQUESPEED_MESSAGE 3
+#define CAN_DB_INV2_TORQUESPEED_MESSAGE 4
+#define CAN_DB_INV1_LIMITSSTATUS_MESSAGE 5
+#define CAN_DB_INV2_LIMITSSTATUS_MESSAGE 6
+#define CAN_DB_INV1_TEMPSVOLTAGE_MESSAGE 7
+#define CAN_DB_INV2_TEMPSVOLTAGE_MESSAGE 8
+
+// Signal indices, e.g. for telemetry_t.stale
+#define CAN_DB_BATTERY_PACK_CURRENT_SIGNAL 0
+#define CAN_DB_BATTERY_PACK_VOLTAGE_SIGNAL 1
+#define CAN_DB_BATTERY_PACK_SOC_SIGNAL 2
+#define CAN_DB_BATTERY_PACK_DCL_SIGNAL 3
+#define CAN_DB_BATTERY_TEMPERATURE_SIGNAL 4
+#define CAN_DB_VCU_LV_VOLTAGE_SIGNAL 5
+#define CAN_DB_VCU_CURRENT_LIMIT_SIGNAL 6
+#define CAN_DB_INV2_ACTIVE_SIGNAL 7
+#define CAN_DB_INV1_ACTIVE_SIGNAL 8
+#define CAN_DB_BATTERY_ACTIVE_SIGNAL 9
+#define CAN_DB_VCU_RTD_SIGNAL 10
+#define CAN_DB_VCU_RTD_SWITCH_STATE_SIGNAL 11
+#define CAN_DB_VCU_FAULT_SIGNAL 12
+#define CAN_DB_INV1_OUTPUT_TORQUE_SIGNAL 13
+#define CAN_DB_INV1_MOTOR_SPEED_SIGNAL 14
+#define CAN_DB_INV1_BATTERY_CURRENT_SIGNAL 15
+#define CAN_DB_INV2_OUTPUT_TORQUE_SIGNAL 16
+#define CAN_DB_INV2_MOTOR_SPEED_SIGNAL 17
+#define CAN_DB_INV2_BATTERY_CURRENT_SIGNAL 18
+#define CAN_DB_INV1_AVAILABLE_FORWARD_TORQUE_SIGNAL 19
+#define CAN_DB_INV1_AVAILABLE_REVERSE_TORQUE_SIGNAL 20
+#define CAN_DB_INV1_STATUSWORD_SIGNAL 21
+#define CAN_DB_INV2_AVAILABLE_FORWARD_TORQUE_SIGNAL 22
+#define CAN_DB_INV2_AVAILABLE_REVERSE_TORQUE_SIGNAL 23
+#define CAN_DB_INV2_STATUSWORD_SIGNAL 24
+#define CAN_DB_INV1_TEMPERATURE_SIGNAL 25
+#define CAN_DB_INV1_MOTOR_TEMP_SIGNAL 26
+#define CAN_DB_INV1_CAPACITOR_VOLTAGE_SIGNAL 27
+#define CAN_DB_INV2_TEMPERATURE_SIGNAL 28
+#define CAN_DB_INV2_MOTOR_TEMP_SIGNAL 29
+#define CAN_DB_INV2_CAPACITOR_VOLTAGE_SIGNAL 30
+
+extern const can_db_t can_db;
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DB_H_ */
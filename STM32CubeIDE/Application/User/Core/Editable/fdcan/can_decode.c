@@ -0,0 +1,146 @@
+/*
+ * can_decode.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "can_decode.h"
+#include <string.h>
+
+#define PAYLOAD_MAX 64 // largest CAN FD payload
+
+// both the Cortex-M33 and x86 hosts are little-endian
+static inline uint64_t load_le64(const uint8_t *p) {
+	uint64_t v;
+	memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+static inline uint64_t load_be64(const uint8_t *p) {
+	return __builtin_bswap64(load_le64(p));
+}
+
+int can_db_find(const can_db_t *db, uint32_t key) {
+	const uint32_t *base = db->keys;
+	uint32_t n = db->message_count;
+
+	if (n == 0) {
+		return -1;
+	}
+
+	// branchless lower bound: the loop count only depends on the table size
+	while (n > 1) {
+		uint32_t half = n / 2;
+		base = (base[half] <= key) ? base + half : base;
+		n -= half;
+	}
+
+	return (*base == key) ? (int) (base - db->keys) : -1;
+}
+
+// A physical value for an integer field: truncated as a C conversion but
+// saturated to the field's range, where the conversion itself would be
+// undefined; NaN stores 0
+static int64_t phys_to_int(float phys, int64_t min, int64_t max) {
+	if (phys != phys) {
+		return 0;
+	}
+	if (phys <= (float) min) {
+		return min;
+	}
+	// (float) max rounds up to the next power of two
+	if (phys >= (float) max) {
+		return max;
+	}
+	return (int64_t) phys;
+}
+
+static void store_signal(const can_signal_t *sig, uint64_t raw) {
+	int64_t value = (int64_t) raw;
+	float phys;
+
+	if (sig->flags & CAN_SIG_SIGNED) {
+		uint32_t unused = 64 - sig->length;
+		value = (int64_t) (raw << unused) >> unused;
+	}
+
+	if (sig->flags & CAN_SIG_RAW) {
+		phys = (float) value;
+	} else {
+		phys = (float) value * sig->scale + sig->offset;
+	}
+
+	switch ((can_store_t) sig->store) {
+	case CAN_STORE_U8:
+		*(uint8_t*) sig->dest = (uint8_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, 0, UINT8_MAX));
+		break;
+	case CAN_STORE_I8:
+		*(int8_t*) sig->dest = (int8_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, INT8_MIN, INT8_MAX));
+		break;
+	case CAN_STORE_U16:
+		*(uint16_t*) sig->dest = (uint16_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, 0, UINT16_MAX));
+		break;
+	case CAN_STORE_I16:
+		*(int16_t*) sig->dest = (int16_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, INT16_MIN, INT16_MAX));
+		break;
+	case CAN_STORE_U32:
+		*(uint32_t*) sig->dest = (uint32_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, 0, UINT32_MAX));
+		break;
+	case CAN_STORE_I32:
+		*(int32_t*) sig->dest = (int32_t) ((sig->flags & CAN_SIG_RAW) ?
+				value : phys_to_int(phys, INT32_MIN, INT32_MAX));
+		break;
+	case CAN_STORE_F32:
+		*(float*) sig->dest = phys;
+		break;
+	case CAN_STORE_BOOL:
+		*(bool*) sig->dest = value != 0;
+		break;
+	}
+}
+
+int can_decode(const can_db_t *db, uint32_t key, const uint8_t *data,
+		uint8_t len, uint32_t timestamp_us) {
+	uint8_t payload[PAYLOAD_MAX + 8];
+	int index = can_db_find(db, key);
+
+	if (index < 0) {
+		return -1;
+	}
+
+	// zero padding lets every signal within len load a full 64-bit window
+	if (len > PAYLOAD_MAX) {
+		len = PAYLOAD_MAX;
+	}
+	memcpy(payload, data, len);
+	memset(payload + len, 0, 8);
+
+	const can_message_t *msg = &db->messages[index];
+	const can_signal_t *sig = &db->signals[msg->first_signal];
+	uint32_t *rx_us = &db->rx_us[msg->first_signal];
+
+	// 0 is reserved for "never received"
+	timestamp_us |= 1;
+
+	for (uint32_t i = 0; i < msg->signal_count; i++, sig++) {
+		if (sig->end > len) {
+			continue;
+		}
+
+		const uint8_t *window = payload + sig->byte_offset;
+		uint64_t word = (sig->flags & CAN_SIG_BIG_ENDIAN) ?
+				load_be64(window) : load_le64(window);
+		uint64_t mask = (sig->length >= 64) ?
+				~0ULL : ((1ULL << sig->length) - 1);
+
+		store_signal(sig, (word >> sig->shift) & mask);
+		rx_us[i] = timestamp_us;
+	}
+
+	return index;
+}
@@ -0,0 +1,100 @@
+/*
+ * can_decode.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DECODE_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DECODE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Table driven CAN signal decoder. The tables themselves live in can_db.c,
+ * which is generated from our5.dbc by Tools/dbc2c.py - add signals there,
+ * not here.
+ */
+
+// Standard and extended IDs share one lookup key space. Extended IDs match
+// on their low 25 bits: senders set the priority in bits 25 to 28 as they
+// like, whatever the DBC says.
+#define CAN_KEY_EXTENDED 0x80000000U
+#define CAN_EXT_MATCH_MASK 0x01FFFFFFU
+#define CAN_KEY(id, extended) \
+	((extended) ? (((id) & CAN_EXT_MATCH_MASK) | CAN_KEY_EXTENDED) : (id))
+
+// can_signal_t.flags
+#define CAN_SIG_SIGNED 0x01U
+#define CAN_SIG_BIG_ENDIAN 0x02U
+#define CAN_SIG_RAW 0x04U // scale 1, offset 0: store the raw integer directly
+
+// Storage type of the destination field
+typedef enum {
+	CAN_STORE_U8,
+	CAN_STORE_I8,
+	CAN_STORE_U16,
+	CAN_STORE_I16,
+	CAN_STORE_U32,
+	CAN_STORE_I32,
+	CAN_STORE_F32,
+	CAN_STORE_BOOL
+} can_store_t;
+
+#define CAN_STORE_INT(size, is_signed) \
+	((size) == 1 ? ((is_signed) ? CAN_STORE_I8 : CAN_STORE_U8) : \
+	 (size) == 2 ? ((is_signed) ? CAN_STORE_I16 : CAN_STORE_U16) : \
+	 ((is_signed) ? CAN_STORE_I32 : CAN_STORE_U32))
+
+// Storage type of a struct field, a constant expression (enums are stored
+// according to their size and signedness)
+#define CAN_STORE_OF(field) \
+	_Generic((field), float: CAN_STORE_F32, bool: CAN_STORE_BOOL, \
+			default: CAN_STORE_INT(sizeof(field), ((__typeof__(field)) -1) < 0))
+
+// Destination pointer and storage type of a struct field, usable in static
+// initialisers
+#define CAN_SIGNAL_DEST(field) \
+	.dest = &(field), \
+	.store = CAN_STORE_OF(field)
+
+typedef struct {
+	void *dest;
+	float scale;
+	float offset;
+	uint8_t byte_offset; // first payload byte of the 64-bit extraction window
+	uint8_t end; // one past the last payload byte the signal occupies
+	uint8_t shift; // position of the signal LSB inside the window
+	uint8_t length; // in bits, 1..57
+	uint8_t flags;
+	uint8_t store; // can_store_t
+} can_signal_t;
+
+typedef struct {
+	uint16_t first_signal; // index into the signal table
+	uint8_t signal_count;
+	uint8_t length; // payload bytes declared in the DBC
+} can_message_t;
+
+typedef struct {
+	const uint32_t *keys; // sorted ascending
+	const can_message_t *messages; // same order as keys
+	const can_signal_t *signals;
+	const char *const *names; // DBC message names, for diagnostics
+	uint32_t *rx_us; // per signal RX timestamp, 0 until first received
+	const uint32_t *timeouts_us; // per signal staleness timeout
+	uint16_t message_count;
+} can_db_t;
+
+/* Index of the message with this key, or -1 if the database does not use it */
+int can_db_find(const can_db_t *db, uint32_t key);
+
+/* Decode every signal of one frame into its destination field and stamp it
+ * with the frame's RX time. Signals that run past the end of a frame shorter
+ * than its DBC length keep their value and time, and go stale. Returns the
+ * message index, or -1 if the frame is not in the database. */
+int can_decode(const can_db_t *db, uint32_t key, const uint8_t *data,
+		uint8_t len, uint32_t timestamp_us);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DECODE_H_ */
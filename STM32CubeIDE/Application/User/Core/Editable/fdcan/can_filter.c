@@ -0,0 +1,143 @@
+/*
+ * can_filter.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "can_filter.h"
+#include <stdbool.h>
+
+#define MAX_RUNS 64
+
+typedef struct {
+	uint32_t lo;
+	uint32_t hi;
+} id_run_t;
+
+// the low bits a mask filter must leave out to hold lo..hi
+static uint32_t block_low_bits(uint32_t lo, uint32_t hi) {
+	uint32_t low = 0;
+
+	while ((lo & ~low) != (hi & ~low)) {
+		low = (low << 1) | 1U;
+	}
+	return low;
+}
+
+// run i needs no mask filter of its own, the previous run's block holds it
+static bool in_previous_block(const id_run_t *runs, uint32_t i) {
+	if (i == 0) {
+		return false;
+	}
+	uint32_t low = block_low_bits(runs[i - 1].lo, runs[i - 1].hi);
+
+	return (runs[i].hi & ~low) == (runs[i - 1].lo & ~low);
+}
+
+static uint32_t filters_needed(const id_run_t *runs, uint32_t run_count,
+		bool masks_only) {
+	uint32_t ranges = 0;
+	uint32_t singles = 0;
+
+	if (masks_only) {
+		uint32_t masks = 0;
+		for (uint32_t i = 0; i < run_count; i++) {
+			masks += !in_previous_block(runs, i);
+		}
+		return masks;
+	}
+
+	for (uint32_t i = 0; i < run_count; i++) {
+		if (runs[i].lo == runs[i].hi) {
+			singles++;
+		} else {
+			ranges++;
+		}
+	}
+
+	return ranges + (singles + 1) / 2;
+}
+
+static bool is_mask_block(uint32_t lo, uint32_t hi) {
+	uint32_t size = hi - lo + 1;
+
+	return size != 0 && (size & (size - 1)) == 0 && (lo & (size - 1)) == 0;
+}
+
+uint32_t can_filter_plan(const uint32_t *ids, uint32_t count, uint32_t id_mask,
+		can_filter_t *filters, uint32_t max_filters) {
+	id_run_t runs[MAX_RUNS];
+	uint32_t run_count = 0;
+	// range and dual filters would compare the bits id_mask leaves out
+	bool masks_only = id_mask != CAN_STD_ID_MASK && id_mask != CAN_EXT_ID_MASK;
+
+	if (count == 0 || max_filters == 0) {
+		return 0;
+	}
+
+	// collapse consecutive IDs into runs
+	for (uint32_t i = 0; i < count; i++) {
+		if (run_count > 0 && ids[i] == runs[run_count - 1].hi + 1) {
+			runs[run_count - 1].hi = ids[i];
+		} else if (run_count < MAX_RUNS) {
+			runs[run_count].lo = ids[i];
+			runs[run_count].hi = ids[i];
+			run_count++;
+		} else {
+			// out of scratch space: widen the last run instead
+			runs[run_count - 1].hi = ids[i];
+		}
+	}
+
+	// merge the closest neighbours until everything fits the filter bank
+	while (filters_needed(runs, run_count, masks_only) > max_filters) {
+		uint32_t best = 0;
+		for (uint32_t i = 1; i + 1 < run_count; i++) {
+			if (runs[i + 1].lo - runs[i].hi < runs[best + 1].lo - runs[best].hi) {
+				best = i;
+			}
+		}
+		runs[best].hi = runs[best + 1].hi;
+		for (uint32_t i = best + 1; i + 1 < run_count; i++) {
+			runs[i] = runs[i + 1];
+		}
+		run_count--;
+	}
+
+	uint32_t n = 0;
+	int32_t pending_single = -1;
+
+	for (uint32_t i = 0; i < run_count; i++) {
+		if (masks_only) {
+			if (!in_previous_block(runs, i)) {
+				uint32_t low = block_low_bits(runs[i].lo, runs[i].hi);
+				filters[n].type = CAN_FILTER_MASK;
+				filters[n].id1 = runs[i].lo & ~low;
+				filters[n].id2 = id_mask & ~low;
+				n++;
+			}
+		} else if (runs[i].lo == runs[i].hi) {
+			if (pending_single < 0) {
+				pending_single = (int32_t) n++;
+				filters[pending_single].type = CAN_FILTER_DUAL;
+				filters[pending_single].id1 = runs[i].lo;
+				filters[pending_single].id2 = runs[i].lo;
+			} else {
+				filters[pending_single].id2 = runs[i].lo;
+				pending_single = -1;
+			}
+		} else if (is_mask_block(runs[i].lo, runs[i].hi)) {
+			filters[n].type = CAN_FILTER_MASK;
+			filters[n].id1 = runs[i].lo;
+			filters[n].id2 = id_mask & ~(runs[i].hi - runs[i].lo);
+			n++;
+		} else {
+			filters[n].type = CAN_FILTER_RANGE;
+			filters[n].id1 = runs[i].lo;
+			filters[n].id2 = runs[i].hi;
+			n++;
+		}
+	}
+
+	return n;
+}
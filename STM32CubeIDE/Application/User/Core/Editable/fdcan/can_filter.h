@@ -0,0 +1,48 @@
+/*
+ * can_filter.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_FILTER_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_FILTER_H_
+
+#include <stdint.h>
+
+/*
+ * Turns a list of CAN IDs into as few FDCAN acceptance filter elements as
+ * possible. Consecutive IDs become range filters (or mask filters when the
+ * run is an aligned power-of-two block), leftover single IDs are paired into
+ * dual filters. If the list does not fit the filter bank, the runs with the
+ * smallest gap between them are merged, which accepts a few unused IDs but
+ * never rejects a wanted one.
+ *
+ * Range and dual filters compare the whole ID. To match on fewer bits, such
+ * as an extended ID's low 25 (CAN_EXT_MATCH_MASK), every run becomes a mask
+ * filter over the smallest aligned power-of-two block that holds it.
+ */
+
+#define CAN_STD_ID_MASK 0x7FFU
+#define CAN_EXT_ID_MASK 0x1FFFFFFFU
+
+typedef enum {
+	CAN_FILTER_RANGE, // accept id1..id2
+	CAN_FILTER_DUAL, // accept id1 or id2
+	CAN_FILTER_MASK // accept (id & id2) == id1
+} can_filter_type_t;
+
+typedef struct {
+	can_filter_type_t type;
+	uint32_t id1;
+	uint32_t id2;
+} can_filter_t;
+
+/* ids must be sorted ascending, unique and of one ID type, within id_mask:
+ * CAN_STD_ID_MASK or CAN_EXT_ID_MASK to match whole IDs, or a narrower mask of
+ * the low bits to match. Returns the number of filters written, at most
+ * max_filters. */
+uint32_t can_filter_plan(const uint32_t *ids, uint32_t count, uint32_t id_mask,
+		can_filter_t *filters, uint32_t max_filters);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_FILTER_H_ */
@@ -0,0 +1,58 @@
+/*
+ * can_rx_ring.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "can_rx_ring.h"
+#include <stddef.h>
+
+#if (CAN_RX_RING_SIZE & (CAN_RX_RING_SIZE - 1)) != 0
+#error "CAN_RX_RING_SIZE must be a power of two"
+#endif
+
+#define RING_MASK (CAN_RX_RING_SIZE - 1)
+
+can_frame_t* can_rx_ring_claim(can_rx_ring_t *ring) {
+	uint32_t head = ring->head;
+	uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+	if (head - tail >= CAN_RX_RING_SIZE) {
+		ring->overflow_count++;
+		return NULL;
+	}
+
+	return &ring->frames[head & RING_MASK];
+}
+
+void can_rx_ring_publish(can_rx_ring_t *ring) {
+	uint32_t head = ring->head + 1;
+	uint32_t used = head - __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+	if (used > ring->high_water) {
+		ring->high_water = used;
+	}
+
+	// frame contents must be visible before the consumer sees the new head
+	__atomic_store_n(&ring->head, head, __ATOMIC_RELEASE);
+}
+
+bool can_rx_ring_pop(can_rx_ring_t *ring, can_frame_t *frame) {
+	uint32_t tail = ring->tail;
+	uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+
+	if (head == tail) {
+		return false;
+	}
+
+	*frame = ring->frames[tail & RING_MASK];
+
+	// slot may be reused by the producer once tail has moved past it
+	__atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+	return true;
+}
+
+uint32_t can_rx_ring_count(const can_rx_ring_t *ring) {
+	return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE)
+			- __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,62 @@
+/*
+ * can_rx_ring.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_RX_RING_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_RX_RING_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Lock-free single-producer/single-consumer ring of raw CAN frames.
+ * The producer is the FDCAN RX ISR, the consumer is the CAN decoder task.
+ * No critical sections are needed: head is only written by the producer and
+ * tail only by the consumer. A zero-initialised ring is empty.
+ */
+
+#define CAN_RX_RING_SIZE 128 // must be a power of two
+#define CAN_FRAME_MAX_LEN 64 // CAN FD payload
+
+typedef struct {
+	uint32_t timestamp_us;
+	uint32_t id;
+	bool extended;
+	bool fd; // FD format, len may be any of the FD payload sizes
+	bool brs; // data phase sent at the data bit rate
+	uint8_t len; // payload bytes, not the DLC code
+	uint8_t data[CAN_FRAME_MAX_LEN];
+} can_frame_t;
+
+/* Payload bytes of a 4-bit DLC code; codes 9..15 are only valid for FD
+ * frames, a classic frame with DLC above 8 still carries 8 bytes. */
+static inline uint8_t can_dlc_to_len(uint32_t dlc, bool fd) {
+	static const uint8_t lengths[16] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20,
+			24, 32, 48, 64 };
+
+	dlc &= 0xFU;
+	return (!fd && dlc > 8) ? 8 : lengths[dlc];
+}
+
+typedef struct {
+	uint32_t head; // next slot to write, owned by the producer
+	uint32_t tail; // next slot to read, owned by the consumer
+	uint32_t overflow_count; // frames dropped because the ring was full
+	uint32_t high_water; // maximum number of frames ever queued
+	can_frame_t frames[CAN_RX_RING_SIZE];
+} can_rx_ring_t;
+
+/* Producer side: claim the next free slot, fill it, then publish it.
+ * Returns NULL (and counts an overflow) when the ring is full. */
+can_frame_t* can_rx_ring_claim(can_rx_ring_t *ring);
+void can_rx_ring_publish(can_rx_ring_t *ring);
+
+/* Consumer side: copy out the oldest frame, false if the ring is empty */
+bool can_rx_ring_pop(can_rx_ring_t *ring, can_frame_t *frame);
+
+uint32_t can_rx_ring_count(const can_rx_ring_t *ring);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_RX_RING_H_ */
@@ -0,0 +1,111 @@
+/*
+ * can_stats.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "can_stats.h"
+
+#define EWMA_SHIFT 4 // smoothing factor 1/16
+
+static can_id_stats_t can_stats[CAN_STATS_SLOTS];
+
+static uint32_t window_start_us;
+static uint32_t window_bits;
+static uint32_t bus_load_permille;
+
+static uint32_t abs_diff(uint32_t a, uint32_t b) {
+	return a > b ? a - b : b - a;
+}
+
+static uint32_t ewma(uint32_t average, uint32_t sample) {
+	return (uint32_t) ((int32_t) average
+			+ (((int32_t) sample - (int32_t) average) >> EWMA_SHIFT));
+}
+
+/* Bits on the wire without stuff bits, in nominal bit times */
+static uint32_t frame_bits(const can_frame_t *frame) {
+	if (!frame->fd) {
+		return (frame->extended ? 67U : 47U) + 8U * frame->len;
+	}
+
+	// arbitration up to BRS, then ACK, EOF and IFS at the nominal rate
+	uint32_t nominal = (frame->extended ? 35U : 16U) + 12U;
+	// ESI, DLC, payload, stuff count, CRC and CRC delimiter
+	uint32_t data = 1U + 4U + 8U * frame->len + 4U
+			+ (frame->len > 16 ? 21U : 17U) + 1U;
+
+	if (frame->brs) {
+		data = (data * CAN_BITRATE + CAN_DATA_BITRATE - 1) / CAN_DATA_BITRATE;
+	}
+	return nominal + data;
+}
+
+static void update_bus_load(const can_frame_t *frame, uint32_t now_us) {
+	uint32_t elapsed = now_us - window_start_us;
+
+	if (elapsed >= CAN_BUS_LOAD_WINDOW_US) {
+		bus_load_permille = (uint32_t) ((uint64_t) window_bits * 1000000U
+				* 1000U / ((uint64_t) CAN_BITRATE * elapsed));
+		window_start_us = now_us;
+		window_bits = 0;
+	}
+
+	window_bits += frame_bits(frame);
+}
+
+void can_stats_record(uint32_t slot, const can_frame_t *frame,
+		uint32_t now_us) {
+	if (slot >= CAN_STATS_SLOTS) {
+		slot = CAN_STATS_OTHER;
+	}
+
+	can_id_stats_t *s = &can_stats[slot];
+	uint32_t latency = now_us - frame->timestamp_us;
+
+	if (s->count == 0) {
+		s->latency_us = latency;
+	} else {
+		// only differences of timestamps, which stay right across the wrap
+		// of the 32-bit microsecond clock every 71.6 minutes
+		uint32_t period = frame->timestamp_us - s->last_seen_us;
+
+		if (s->count == 1) {
+			s->period_us = period;
+		}
+		if (period > s->max_period_us) {
+			s->max_period_us = period;
+		}
+		s->jitter_us = ewma(s->jitter_us, abs_diff(period, s->period_us));
+		s->period_us = ewma(s->period_us, period);
+		s->latency_us = ewma(s->latency_us, latency);
+	}
+
+	if (latency > s->max_latency_us) {
+		s->max_latency_us = latency;
+	}
+	s->last_seen_us = frame->timestamp_us;
+	s->count++;
+
+	update_bus_load(frame, now_us);
+}
+
+void can_stats_read(uint32_t slot, can_id_stats_t *stats) {
+	*stats = can_stats[slot < CAN_STATS_SLOTS ? slot : CAN_STATS_OTHER];
+}
+
+uint32_t can_stats_mean_period_us(const can_id_stats_t *stats) {
+	return stats->count < 2 ? 0 : stats->period_us;
+}
+
+uint32_t can_stats_bus_load_permille(uint32_t now_us) {
+	// no frames at all for a whole window means an idle (or dead) bus
+	if (now_us - window_start_us >= 2 * CAN_BUS_LOAD_WINDOW_US) {
+		return 0;
+	}
+	return bus_load_permille;
+}
+
+const char* can_stats_name(uint32_t slot) {
+	return slot < CAN_DB_MESSAGE_COUNT ? can_db.names[slot] : "other";
+}
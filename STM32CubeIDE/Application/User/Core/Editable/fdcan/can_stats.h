@@ -0,0 +1,55 @@
+/*
+ * can_stats.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_H_
+
+#include "can_db.h"
+#include "can_rx_ring.h"
+
+/*
+ * Per-message receive statistics. Slots are indexed by CAN database message
+ * index, so recording a frame is O(1) once the decoder has looked it up; one
+ * extra slot collects frames the database does not know. Written only by the
+ * CAN decoder task. Readers get each field atomically but a row may mix two
+ * updates, which is fine for diagnostics.
+ */
+
+#define CAN_STATS_OTHER CAN_DB_MESSAGE_COUNT // slot for unknown IDs
+#define CAN_STATS_SLOTS (CAN_DB_MESSAGE_COUNT + 1)
+
+#define CAN_BITRATE 1000000U // nominal bit rate set in MX_FDCAN1_Init
+#define CAN_DATA_BITRATE 2000000U // FD data phase bit rate, frames with BRS
+#define CAN_BUS_LOAD_WINDOW_US 100000U
+
+typedef struct {
+	uint32_t count;
+	uint32_t last_seen_us; // RX timestamp of the newest frame
+	uint32_t period_us; // smoothed gap between two frames
+	uint32_t max_period_us; // longest gap between two frames
+	uint32_t jitter_us; // smoothed |period - smoothed period|
+	uint32_t max_latency_us; // RX interrupt to decode, worst case
+	uint32_t latency_us; // RX interrupt to decode, smoothed
+} can_id_stats_t;
+
+void can_stats_record(uint32_t slot, const can_frame_t *frame,
+		uint32_t now_us);
+
+void can_stats_read(uint32_t slot, can_id_stats_t *stats);
+
+/* Smoothed inter-arrival time, 0 until two frames have been seen */
+uint32_t can_stats_mean_period_us(const can_id_stats_t *stats);
+
+/* Load caused by accepted frames over the last window, in 0.1 % units.
+ * Stuff bits are not counted, so this is a lower bound. FD data phases sent
+ * with BRS are scaled to nominal bit times. */
+uint32_t can_stats_bus_load_permille(uint32_t now_us);
+
+/* DBC message name of a slot, "other" for the unknown ID slot */
+const char* can_stats_name(uint32_t slot);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_H_ */
@@ -0,0 +1,157 @@
+/*
+ * can_stats_uart.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "can_stats_uart.h"
+#include "can_stats.h"
+#include "fdcan_handlers.h"
+#include "../gui/gui_stats.h"
+#include "../gui/render_profile.h"
+#include "../timing/cpu_load.h"
+#include "../timing/timebase.h"
+#include "cmsis_os2.h"
+#include "usart.h"
+#include <inttypes.h>
+#include <stdio.h>
+
+#define STATS_LINE_LEN 128
+#define UART_TIMEOUT_MS 100
+#define UART_TX_FLAG 0x1U
+
+static osThreadId_t volatile uart_waiter;
+
+// DMA, and sleep until it is done rather than poll the UART for the whole
+// report, which showed up as busy time in the idle figure
+static void send(const uint8_t *data, uint16_t len) {
+	// ten bits per byte on the wire
+	uint32_t timeout_ms = len * 10000U / huart1.Init.BaudRate + UART_TIMEOUT_MS;
+
+	uart_waiter = osThreadGetId();
+	osThreadFlagsClear(UART_TX_FLAG);
+	if (HAL_UART_Transmit_DMA(&huart1, data, len) != HAL_OK) {
+		return;
+	}
+	if (osThreadFlagsWait(UART_TX_FLAG, osFlagsWaitAny, timeout_ms)
+			!= UART_TX_FLAG) {
+		HAL_UART_AbortTransmit(&huart1);
+	}
+}
+
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart) {
+	if (huart == &huart1 && uart_waiter != NULL) {
+		osThreadFlagsSet(uart_waiter, UART_TX_FLAG);
+	}
+}
+
+static void send_line(const char *line, int len) {
+	if (len <= 0) {
+		return;
+	}
+	if (len >= STATS_LINE_LEN) {
+		len = STATS_LINE_LEN - 1; // snprintf truncated the line
+	}
+	send((const uint8_t*) line, (uint16_t) len);
+}
+
+static void print_row(char *line, uint32_t slot, uint32_t now_us) {
+	can_id_stats_t stats;
+	can_stats_read(slot, &stats);
+
+	uint32_t id = slot < CAN_DB_MESSAGE_COUNT ?
+			can_db.keys[slot] & ~CAN_KEY_EXTENDED : 0;
+	uint32_t period = can_stats_mean_period_us(&stats);
+	uint32_t age = stats.count ? (now_us - stats.last_seen_us) / 1000U : 0;
+
+	send_line(line,
+			snprintf(line, STATS_LINE_LEN,
+					"%-24s %08" PRIX32 " %8" PRIu32 " %8" PRIu32 " %8" PRIu32
+							" %8" PRIu32 " %6" PRIu32 " %6" PRIu32 " %8" PRIu32
+							"\r\n",
+					can_stats_name(slot), id, stats.count, period,
+					stats.max_period_us, stats.jitter_us, stats.latency_us,
+					stats.max_latency_us, age));
+}
+
+/* Redrawn area, and CPU time given back while waiting for the display,
+ * since the previous report */
+static void print_gui_stats(char *line) {
+	static gui_frame_stats_t previous;
+	static cpu_load_window_t window;
+	gui_frame_stats_t stats;
+	gui_stats_read(&stats);
+
+	uint32_t frames = stats.frames - previous.frames;
+	uint32_t px = stats.px_total - previous.px_total;
+	uint32_t wait_us = stats.flush_wait_us_total - previous.flush_wait_us_total;
+	uint32_t idle = cpu_idle_permille(&window);
+	previous = stats;
+
+	send_line(line,
+			snprintf(line, STATS_LINE_LEN,
+					"gui: %" PRIu32 " frames, %" PRIu32 " px/frame, max %"
+							PRIu32 " px, render max %" PRIu32 " us, switch %"
+							PRIu32 "/%" PRIu32 " us\r\n",
+					frames, frames ? px / frames : 0, stats.px_max,
+					stats.render_us_max, stats.switch_us_last,
+					stats.switch_us_max));
+	send_line(line,
+			snprintf(line, STATS_LINE_LEN,
+					"cpu: idle %" PRIu32 ".%" PRIu32 "%%, display wait %"
+							PRIu32 " us/frame\r\n",
+					idle / 10U, idle % 10U, frames ? wait_us / frames : 0));
+}
+
+static void print_stats(char *line) {
+	uint32_t now_us = timebase_us();
+	uint32_t load = can_stats_bus_load_permille(now_us);
+	can_rx_counters_t counters;
+	can_rx_get_counters(&counters);
+
+	send_line(line,
+			snprintf(line, STATS_LINE_LEN,
+					"\r\ncan: load %" PRIu32 ".%" PRIu32 "%% rx %" PRIu32
+							" lost %" PRIu32 " ovf %" PRIu32 " hw %" PRIu32
+							"\r\n",
+					load / 10U, load % 10U, counters.received,
+					counters.fifo_lost, counters.ring_overflow,
+					counters.ring_high_water));
+	send_line(line,
+			snprintf(line, STATS_LINE_LEN,
+					"%-24s %8s %8s %8s %8s %8s %6s %6s %8s\r\n", "message",
+					"id", "count", "mean_us", "max_us", "jit_us", "lat_us",
+					"latmax", "age_ms"));
+
+	for (uint32_t slot = 0; slot < CAN_STATS_SLOTS; slot++) {
+		print_row(line, slot, now_us);
+	}
+
+	print_gui_stats(line);
+}
+
+#if CAN_STATS_UART_PROFILE
+static void send_render_profile(void) {
+	static uint8_t record[RENDER_PROFILE_RECORD_MAX];
+
+	send(record, (uint16_t) render_profile_encode(record, sizeof(record)));
+}
+#endif
+
+static void CanStatsUartTask(void *argument) {
+	static char line[STATS_LINE_LEN];
+
+	for (;;) {
+		print_stats(line);
+#if CAN_STATS_UART_PROFILE
+		send_render_profile();
+#endif
+		osDelay(CAN_STATS_UART_PERIOD_MS);
+	}
+}
+
+void CreateCanStatsUartTask(void) {
+	osThreadNew(CanStatsUartTask, NULL, &(osThreadAttr_t ) {
+					.name = "can_stats_uart", .priority = osPriorityLow,
+					.stack_size = 512 * 4 });
+}
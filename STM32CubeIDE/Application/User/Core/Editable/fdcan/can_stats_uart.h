@@ -0,0 +1,23 @@
+/*
+ * can_stats_uart.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_UART_H_
+#define APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_UART_H_
+
+#define CAN_STATS_UART_PERIOD_MS 1000U
+
+// follow each report with a binary render profile record for
+// Tools/render_profile.py; 0 for a plain serial terminal
+#define CAN_STATS_UART_PROFILE 1
+
+/*
+ * Low priority task that prints the CAN bus statistics table on USART1 once
+ * per period, so the bus can be checked from a laptop without the screen.
+ */
+void CreateCanStatsUartTask(void);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_STATS_UART_H_ */
@@ -5,100 +5,197 @@
  *      Author:
  */
 #include "fdcan_handlers.h"
+#include "can_rx_ring.h"
+#include "can_db.h"
+#include "can_filter.h"
+#include "can_stats.h"
+#include "../telemetry/telemetry.h"
+#include "../timing/timebase.h"
 #include <stddef.h>
 
+#define CAN_RX_FLAG 0x0001U
+
+// size of the FDCAN filter lists in message RAM
+#define CAN_STD_FILTERS_MAX 28
+#define CAN_EXT_FILTERS_MAX 8
+
 // If hfdcan1 is declared elsewhere (e.g. in main.c), include its extern or header
 extern FDCAN_HandleTypeDef hfdcan1;
 
+static can_rx_ring_t can_rx_ring;
+static osThreadId_t can_decoder_task;
+
+static volatile uint32_t can_rx_received;
+static volatile uint32_t can_rx_fifo_lost;
+static uint32_t can_rx_decoded;
+static uint32_t can_rx_unmatched;
+
+static void can_decode_frame(const can_frame_t *frame);
+
 void FDCAN1_IT0_IRQHandler(void) {
 	HAL_FDCAN_IRQHandler(&hfdcan1);
 }
 
-/* Receive new CAN messages */
+/* Drain every pending element of the hardware FIFO into the RX ring and
+ * wake the decoder task. Decoding is kept out of interrupt context. */
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan, uint32_t RxFifo0ITs) {
 	FDCAN_RxHeaderTypeDef rxHeader;
-	uint8_t rxData[8];
+	static uint8_t discard[CAN_FRAME_MAX_LEN];
+	uint32_t drained = 0;
 
-	if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_NEW_MESSAGE) == 0) {
-		return;
+	if ((RxFifo0ITs & FDCAN_IT_RX_FIFO0_MESSAGE_LOST) != 0) {
+		can_rx_fifo_lost++;
 	}
 
-	HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &rxHeader, rxData);
+	while (HAL_FDCAN_GetRxFifoFillLevel(hfdcan, FDCAN_RX_FIFO0) > 0) {
+		can_frame_t *slot = can_rx_ring_claim(&can_rx_ring);
 
-	if (rxHeader.IdType == FDCAN_EXTENDED_ID) {
-		switch (rxHeader.Identifier & 0x01FFFFFF) {
-		case 0x118ff71:
-			inv1.output_torque = ((rxData[0]) | (rxData[1] << 8)) / 160.0f;
-			inv1.motor_speed = (int16_t) ((rxData[2]) | (rxData[3] << 8));
-			inv1.battery_current = (int16_t) ((rxData[4]) | (rxData[5] << 8));
-			break;
-		case 0x118ff72:
-			inv2.output_torque = ((rxData[0]) | (rxData[1] << 8)) / 160.0f;
-			inv2.motor_speed = (int16_t) ((rxData[2]) | (rxData[3] << 8));
-			inv2.battery_current = (int16_t) ((rxData[4]) | (rxData[5] << 8));
-			break;
-		case 0x119ff71:
-			inv1.available_forward_torque = ((rxData[0]) | (rxData[1] << 8))
-					/ 160.0f;
-			inv1.available_reverse_torque = ((rxData[2]) | (rxData[3] << 8))
-					/ 160.0f;
-			inv1.statusword = (statusword_t) rxData[4];
-			break;
-		case 0x119ff72:
-			inv2.available_forward_torque = ((rxData[0]) | (rxData[1] << 8))
-					/ 160.0f;
-			inv2.available_reverse_torque = ((rxData[2]) | (rxData[3] << 8))
-					/ 160.0f;
-			inv2.statusword = (statusword_t) rxData[4];
-			break;
-		case 0x11aff71:
-			inv1.capacitor_voltage = ((rxData[4]) | (rxData[5] << 8)) / 16.0f;
-			inv1.temperature = INVERTER_CUTOFF_TEMP
-					- (int16_t) ((rxData[0]) | (rxData[1] << 8));
-			inv1.motor_temp = (int16_t) ((rxData[2]) | (rxData[3] << 8));
-			break;
-		case 0x11aff72:
-			inv2.capacitor_voltage = ((rxData[4]) | (rxData[5] << 8)) / 16.0f;
-			inv2.temperature = INVERTER_CUTOFF_TEMP
-					- (int16_t) ((rxData[0]) | (rxData[1] << 8));
-			inv2.motor_temp = (int16_t) ((rxData[2]) | (rxData[3] << 8));
-			break;
-		case 0x19107101:
-			// placeholder
-			break;
-		case 0x19117101:
-			break;
-		default:
+		// the element still has to be read out to free the hardware FIFO
+		if (HAL_FDCAN_GetRxMessage(hfdcan, FDCAN_RX_FIFO0, &rxHeader,
+				slot != NULL ? slot->data : discard) != HAL_OK) {
 			break;
 		}
-	} else {
-		switch (rxHeader.Identifier) {
-		case 0x6B1:
-			battery.pack_dcl = (uint16_t) (rxData[0] << 8) | rxData[1];
-			battery.temperature = rxData[4];
-			break;
-		case 0x6B0:
-			battery.pack_soc = rxData[4] / 2;
-			battery.pack_voltage = (((uint16_t) rxData[2] << 8) | rxData[3])
-					* 0.1f;
-			battery.pack_current = (((uint16_t) rxData[0] << 8) | rxData[1])
-					* 0.1f;
-			break;
-		case 0x7A4:
-			vcu.lv_voltage = (rxData[0] + ((uint16_t) rxData[1] << 8)) * 12.58f
-					/ 2561.0f;
-			vcu.current_limit = rxData[4];
-			vcu.rtd_switch_state = (rxData[6] >> 4) & 1;
-			vcu.rtd = (rxData[6] >> 3) & 1;
-			battery.active = (rxData[6] >> 2) & 1;
-			inv1.active = (rxData[6] >> 1) & 1;
-			inv2.active = (rxData[6] >> 0) & 1;
-			vcu.last_comm_time = time_count;
-			vcu.fault = rxData[7];
-			break;
-		default:
-			break;
+		can_rx_received++;
+
+		if (slot == NULL) {
+			continue;
+		}
+
+		slot->timestamp_us = timebase_us();
+		slot->id = rxHeader.Identifier;
+		slot->extended = rxHeader.IdType == FDCAN_EXTENDED_ID;
+		slot->fd = rxHeader.FDFormat == FDCAN_FD_CAN;
+		slot->brs = rxHeader.BitRateSwitch == FDCAN_BRS_ON;
+		// DataLength is the raw DLC code
+		slot->len = can_dlc_to_len(rxHeader.DataLength, slot->fd);
+		can_rx_ring_publish(&can_rx_ring);
+		drained++;
+	}
+
+	if (drained > 0 && can_decoder_task != NULL) {
+		osThreadFlagsSet(can_decoder_task, CAN_RX_FLAG);
+	}
+}
+
+void can_rx_process(void) {
+	can_frame_t frame;
+
+	while (can_rx_ring_pop(&can_rx_ring, &frame)) {
+		can_decode_frame(&frame);
+	}
+}
+
+static void CanDecoderTask(void *pvParameters) {
+	(void) pvParameters;
+
+	for (;;) {
+		osThreadFlagsWait(CAN_RX_FLAG, osFlagsWaitAny, osWaitForever);
+		can_rx_process();
+	}
+}
+
+void CreateCanDecoderTask(void) {
+	// can_rx_ring is zero-initialised static storage and may already hold
+	// frames received before the scheduler started, so it is not reset here
+	can_decoder_task = osThreadNew(CanDecoderTask, NULL, &(osThreadAttr_t ) {
+					.name = "can_decoder", .priority = osPriorityAboveNormal,
+					.stack_size = 512 * 4 });
+}
+
+void can_rx_get_counters(can_rx_counters_t *counters) {
+	counters->received = can_rx_received;
+	counters->fifo_lost = can_rx_fifo_lost;
+	counters->ring_overflow = can_rx_ring.overflow_count;
+	counters->ring_high_water = can_rx_ring.high_water;
+	counters->decoded = can_rx_decoded;
+	counters->unmatched = can_rx_unmatched;
+}
+
+static uint32_t filter_type_to_hal(can_filter_type_t type) {
+	switch (type) {
+	case CAN_FILTER_DUAL:
+		return FDCAN_FILTER_DUAL;
+	case CAN_FILTER_MASK:
+		return FDCAN_FILTER_MASK;
+	case CAN_FILTER_RANGE:
+	default:
+		return FDCAN_FILTER_RANGE;
+	}
+}
+
+static void configure_filter_list(FDCAN_HandleTypeDef *hfdcan, uint32_t id_type,
+		const uint32_t *ids, uint32_t count, uint32_t max_filters) {
+	can_filter_t filters[CAN_STD_FILTERS_MAX];
+	bool extended = id_type == FDCAN_EXTENDED_ID;
+	// the decoder ignores an extended ID's priority bits, so must the filters
+	uint32_t id_mask = extended ? CAN_EXT_MATCH_MASK : CAN_STD_ID_MASK;
+	uint32_t list_size = extended ? CAN_EXT_FILTERS_MAX : CAN_STD_FILTERS_MAX;
+
+	if (max_filters > list_size) {
+		max_filters = list_size;
+	}
+
+	uint32_t n = can_filter_plan(ids, count, id_mask, filters, max_filters);
+
+	for (uint32_t i = 0; i < n; i++) {
+		FDCAN_FilterTypeDef config = {
+				.IdType = id_type,
+				.FilterIndex = i,
+				.FilterType = filter_type_to_hal(filters[i].type),
+				.FilterConfig = FDCAN_FILTER_TO_RXFIFO0,
+				.FilterID1 = filters[i].id1,
+				.FilterID2 = filters[i].id2,
+		};
+		HAL_FDCAN_ConfigFilter(hfdcan, &config);
+	}
+}
+
+void can_configure_filters(void) {
+	uint32_t std_ids[CAN_DB_MESSAGE_COUNT];
+	uint32_t ext_ids[CAN_DB_MESSAGE_COUNT];
+	uint32_t std_count = 0;
+	uint32_t ext_count = 0;
+
+	// database keys are sorted, so both ID lists come out sorted too
+	for (uint32_t i = 0; i < CAN_DB_MESSAGE_COUNT; i++) {
+		uint32_t key = can_db.keys[i];
+		if (key & CAN_KEY_EXTENDED) {
+			ext_ids[ext_count++] = key & CAN_EXT_MATCH_MASK;
+		} else {
+			std_ids[std_count++] = key;
 		}
 	}
+
+	configure_filter_list(&hfdcan1, FDCAN_STANDARD_ID, std_ids, std_count,
+			hfdcan1.Init.StdFiltersNbr);
+	configure_filter_list(&hfdcan1, FDCAN_EXTENDED_ID, ext_ids, ext_count,
+			hfdcan1.Init.ExtFiltersNbr);
+
+	// anything the decoder does not use never reaches the RX FIFO
+	HAL_FDCAN_ConfigGlobalFilter(&hfdcan1, FDCAN_REJECT, FDCAN_REJECT,
+	FDCAN_REJECT_REMOTE, FDCAN_REJECT_REMOTE);
 }
 
+/* Decode one received frame into the telemetry structs */
+static void can_decode_frame(const can_frame_t *frame) {
+	uint32_t key = CAN_KEY(frame->id, frame->extended);
+	int index;
+
+	telemetry_write_begin();
+	index = can_decode(&can_db, key, frame->data, frame->len,
+			frame->timestamp_us);
+	if (index >= 0) {
+		telemetry_mark_dirty((uint32_t) index);
+	}
+	telemetry_write_end();
+
+	if (index >= 0) {
+		can_rx_decoded++;
+	} else {
+		// let through by a merged acceptance filter but not used
+		can_rx_unmatched++;
+	}
+
+	can_stats_record(index >= 0 ? (uint32_t) index : CAN_STATS_OTHER, frame,
+			timebase_us());
+}
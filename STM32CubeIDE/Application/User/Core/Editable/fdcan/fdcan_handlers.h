@@ -21,6 +21,28 @@ void FDCAN1_IT0_IRQHandler(void);
 void HAL_FDCAN_RxFifo0Callback(FDCAN_HandleTypeDef *hfdcan,
 		uint32_t RxFifo0ITs);
 
+typedef struct {
+	uint32_t received; // frames read out of the hardware FIFO
+	uint32_t fifo_lost; // frames the FDCAN dropped before the ISR ran
+	uint32_t ring_overflow; // frames dropped because the RX ring was full
+	uint32_t ring_high_water; // deepest RX ring occupancy seen
+	uint32_t decoded; // frames consumed by the decoder
+	uint32_t unmatched; // frames accepted by the filters but not decoded
+} can_rx_counters_t;
+
+/* Create the CAN decoder task (call once during system init) */
+void CreateCanDecoderTask(void);
+
+/* Decode every frame waiting in the RX ring. This is the decoder task body,
+ * exposed so the host replay tool can drive it without an RTOS. */
+void can_rx_process(void);
+
+void can_rx_get_counters(can_rx_counters_t *counters);
+
+/* Program the FDCAN acceptance filters from the IDs in the CAN database and
+ * reject everything else in hardware. Call before HAL_FDCAN_Start(). */
+void can_configure_filters(void);
+
 #endif // FDCAN_HANDLERS_H_
 
 #endif /* APPLICATION_USER_CORE_EDITABLE_FDCAN_FDCAN_HANDLERS_H_ */
@@ -0,0 +1,241 @@
+/*
+ * binding.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "binding.h"
+#include "gauge.h"
+#include "label_text.h"
+#include "readout.h"
+#include "span_label.h"
+#include <string.h>
+
+static binding_stats_t stats;
+
+static int32_t read_field(const binding_t *b, const telemetry_t *t) {
+	const void *field = (const uint8_t*) t + b->offset;
+
+	switch (b->store) {
+	case CAN_STORE_U8:
+		return *(const uint8_t*) field;
+	case CAN_STORE_I8:
+		return *(const int8_t*) field;
+	case CAN_STORE_U16:
+		return *(const uint16_t*) field;
+	case CAN_STORE_I16:
+		return *(const int16_t*) field;
+	case CAN_STORE_U32:
+		return (int32_t) *(const uint32_t*) field;
+	case CAN_STORE_I32:
+		return *(const int32_t*) field;
+	case CAN_STORE_BOOL:
+		return *(const bool*) field;
+	default:
+		return 0;
+	}
+}
+
+static int32_t pow10_of(uint32_t decimals) {
+	int32_t scale = 1;
+
+	decimals = LV_MIN(decimals, LABEL_TEXT_DECIMALS_MAX);
+	while (decimals-- > 0) {
+		scale *= 10;
+	}
+	return scale;
+}
+
+// the value in the format's fixed point
+static int32_t read_value(const binding_t *b, const telemetry_t *t) {
+	if (b->read != NULL) {
+		return b->read(t);
+	}
+	if (b->store == CAN_STORE_F32) {
+		return label_text_scale_float(
+				*(const float*) ((const uint8_t*) t + b->offset),
+				b->format.decimals);
+	}
+	int64_t value = (int64_t) read_field(b, t) * pow10_of(b->format.decimals);
+
+	return (int32_t) LV_CLAMP((int64_t) INT32_MIN, value, (int64_t) INT32_MAX);
+}
+
+// the value clamped to the characters its format has room for
+static int32_t clamp_digits(const binding_format_t *format, int32_t value) {
+	uint32_t n = format->digits - (format->decimals != 0 ? 1U : 0U);
+
+	if (format->digits == 0 || n <= format->decimals || n >= 10U) {
+		return value;
+	}
+	int32_t max = pow10_of(n);
+	return LV_CLAMP(-(max / 10 - 1), value, max - 1);
+}
+
+static bool is_stale(uint32_t signals, const telemetry_t *t) {
+	while (signals != 0) {
+		uint32_t i = (uint32_t) __builtin_ctz(signals);
+
+		if (t->stale[i]) {
+			return true;
+		}
+		signals &= signals - 1U;
+	}
+	return false;
+}
+
+// the highest band value has reached, or the shown band while value is
+// within its hysteresis
+static uint8_t band_of(const binding_ramp_t *ramp, int32_t value,
+		const binding_state_t *state) {
+	uint8_t band = 0;
+
+	while (band + 1U < ramp->count && value >= ramp->bands[band + 1U].from) {
+		band++;
+	}
+	if (state->shown && band < state->band
+			&& value >= ramp->bands[state->band].from - ramp->hysteresis) {
+		band = state->band;
+	}
+	return band;
+}
+
+static void set_value(const binding_t *b, lv_obj_t *obj, int32_t value) {
+	switch (b->widget) {
+	case BINDING_READOUT:
+		readout_set_value(obj, value);
+		break;
+	case BINDING_GAUGE:
+		gauge_set_value(obj, value);
+		break;
+	case BINDING_BAR:
+		lv_bar_set_value(obj, value, LV_ANIM_OFF);
+		break;
+	case BINDING_SPAN:
+		span_label_set_fixed(obj, b->segment, clamp_digits(&b->format, value),
+				b->format.decimals, b->format.units);
+		break;
+	default:
+		break;
+	}
+}
+
+static void set_color(const binding_t *b, lv_obj_t *obj, lv_color_t color) {
+	switch (b->widget) {
+	case BINDING_READOUT:
+		lv_obj_set_style_text_color(obj, color, LV_PART_INDICATOR);
+		break;
+	case BINDING_GAUGE:
+		lv_obj_set_style_arc_color(obj, color, LV_PART_INDICATOR);
+		break;
+	case BINDING_BAR:
+		lv_obj_set_style_bg_color(obj, color, LV_PART_INDICATOR);
+		break;
+	case BINDING_SPAN:
+		span_label_set_color(obj, b->segment, color);
+		break;
+	default:
+		break;
+	}
+}
+
+static void evaluate(const binding_t *b, binding_state_t *state,
+		const telemetry_t *t) {
+	lv_obj_t *obj = *b->obj;
+	int32_t value = read_value(b, t);
+	bool stale = is_stale(b->stale, t);
+	bool changed = false;
+
+	stats.evaluated++;
+	if (!state->shown || value != state->value) {
+		set_value(b, obj, value);
+		state->value = value;
+		changed = true;
+	}
+	if (b->ramp != NULL) {
+		uint8_t band = band_of(b->ramp, value, state);
+
+		if (!state->shown || band != state->band) {
+			set_color(b, obj, lv_color_hex(b->ramp->bands[band].color));
+			state->band = band;
+			changed = true;
+		}
+	}
+	if (!state->shown || stale != state->stale) {
+		binding_set_stale(obj, stale);
+		state->stale = stale;
+		changed = true;
+	}
+	state->shown = true;
+	stats.changed += changed;
+}
+
+bool binding_table_init(binding_table_t *table, const binding_t *bindings,
+		uint32_t count) {
+	uint32_t links = 0;
+
+	if (count > BINDING_TABLE_MAX) {
+		return false;
+	}
+	table->bindings = bindings;
+	table->count = count;
+	table->pass = 0;
+	memset(table->states, 0, sizeof(table->states));
+
+	memset(table->first, 0, sizeof(table->first));
+
+	// one run per group, a binding listed in the run of each of its groups
+	for (uint32_t g = 0; g < BINDING_GROUPS; g++) {
+		uint32_t start = links;
+
+		for (uint32_t i = 0; i < count; i++) {
+			if ((bindings[i].groups & (1U << g)) == 0) {
+				continue;
+			}
+			if (links == BINDING_TABLE_LINKS) {
+				// leave every run empty, updates then do nothing
+				memset(table->first, 0, sizeof(table->first));
+				return false;
+			}
+			table->links[links++] = (uint8_t) i;
+		}
+		table->first[g] = (uint8_t) start;
+	}
+	table->first[BINDING_GROUPS] = (uint8_t) links;
+	return true;
+}
+
+void binding_table_update(binding_table_t *table, const telemetry_t *t,
+		uint32_t dirty) {
+	uint32_t pass = ++table->pass;
+
+	// only the runs of the dirty groups: the cost is the bindings changed,
+	// not the size of the table
+	while (dirty != 0) {
+		uint32_t g = (uint32_t) __builtin_ctz(dirty);
+
+		for (uint32_t l = table->first[g]; l < table->first[g + 1U]; l++) {
+			uint32_t i = table->links[l];
+			binding_state_t *state = &table->states[i];
+
+			if (state->pass != pass) {
+				state->pass = pass;
+				evaluate(&table->bindings[i], state, t);
+			}
+		}
+		dirty &= dirty - 1U;
+	}
+}
+
+void binding_get_stats(binding_stats_t *out) {
+	*out = stats;
+	memset(&stats, 0, sizeof(stats));
+}
+
+void binding_set_stale(lv_obj_t *obj, bool stale) {
+	lv_opa_t opa = stale ? STALE_OPA : LV_OPA_COVER;
+
+	if (lv_obj_get_style_opa(obj, LV_PART_MAIN) != opa) {
+		lv_obj_set_style_opa(obj, opa, 0);
+	}
+}
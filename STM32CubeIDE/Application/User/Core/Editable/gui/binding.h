@@ -0,0 +1,131 @@
+/*
+ * binding.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_BINDING_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_BINDING_H_
+
+#include "../telemetry/telemetry.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Table driven signal to widget updates, like the CAN decoder's signal
+ * tables. Each binding reads one telemetry field (or a function of several),
+ * shows it on one widget in its format and picks the widget's colour from a
+ * ramp of threshold bands. It also dims the widget while any of its signals
+ * is stale.
+ *
+ * A table is indexed by dirty group once. An update then only evaluates the
+ * bindings of the groups that changed. Each binding caches the value, band
+ * and staleness it last showed, and calls into LVGL only for the ones that
+ * differ. Adding a widget is one more entry.
+ */
+
+#define BINDING_TABLE_MAX 32U // bindings in a table
+#define BINDING_TABLE_LINKS 64U // bindings summed over the groups they are in
+#define BINDING_GROUPS 32U // bits of the dirty mask
+
+_Static_assert(CAN_DB_SIGNAL_COUNT <= 32,
+		"a binding's stale signals are a 32-bit mask");
+
+typedef enum {
+	BINDING_READOUT, // readout_set_value(), colour the number's text
+	BINDING_GAUGE, // gauge_set_value(), colour the sweep
+	BINDING_BAR, // lv_bar_set_value(), colour the indicator
+	BINDING_SPAN // span_label_set_fixed() on a segment, colour it
+} binding_widget_t;
+
+/* How a value is read and shown. It is fixed point with decimals places: a
+ * field is read times 10^decimals, a float rounded as gui/label_text.h
+ * rounds it, and the ramp's bands are in the same units. A span shows it as
+ * gui/label_text.h formats it, clamped to digits characters ('-' and '.'
+ * included, 0 for no limit) and followed by units. Readouts, gauges and bars
+ * show the value as it is, having their digits and units from when they were
+ * created. */
+typedef struct {
+	uint8_t decimals; // up to LABEL_TEXT_DECIMALS_MAX
+	uint8_t digits;
+	const char *units; // or NULL
+} binding_format_t;
+
+typedef struct {
+	int32_t from; // the band's lowest value; the first band's is not used
+	uint32_t color; // 0xRRGGBB
+} binding_band_t;
+
+/* Bands in ascending order. A value enters a band at its from and leaves it
+ * downwards only below from - hysteresis, so a signal sitting on a
+ * threshold does not flicker between colours. */
+typedef struct {
+	const binding_band_t *bands;
+	uint8_t count;
+	int32_t hysteresis;
+} binding_ramp_t;
+
+typedef struct {
+	lv_obj_t **obj; // set once the screen is built
+	uint8_t widget; // binding_widget_t
+	uint8_t segment; // BINDING_SPAN only
+	binding_format_t format;
+	uint16_t offset; // of a telemetry_t field, see BINDING_FIELD()
+	uint8_t store; // can_store_t
+	// instead of the field if not NULL, returning the value already scaled
+	int32_t (*read)(const telemetry_t *t);
+	uint32_t groups; // the TELEMETRY_GROUP()s the value depends on
+	uint32_t stale; // BINDING_STALE() signals that dim the widget
+	const binding_ramp_t *ramp; // NULL to leave the colour alone
+} binding_t;
+
+// Offset and storage type of a telemetry_t field such as battery.pack_soc,
+// usable in static initialisers
+#define BINDING_FIELD(field) \
+	.offset = offsetof(telemetry_t, field), \
+	.store = CAN_STORE_OF(((telemetry_t*) 0)->field)
+
+#define BINDING_STALE(signal) (1U << CAN_DB_##signal##_SIGNAL)
+
+typedef struct {
+	int32_t value;
+	uint8_t band;
+	bool stale;
+	bool shown; // false until the first update
+	uint32_t pass; // last update that evaluated it, for bindings in two groups
+} binding_state_t;
+
+typedef struct {
+	const binding_t *bindings;
+	uint32_t count;
+	uint32_t pass;
+	binding_state_t states[BINDING_TABLE_MAX];
+	uint8_t first[BINDING_GROUPS + 1]; // each group's run in links
+	uint8_t links[BINDING_TABLE_LINKS]; // binding indices, by group
+} binding_table_t;
+
+typedef struct {
+	uint32_t evaluated; // bindings read
+	uint32_t changed; // of them, those that called into LVGL
+} binding_stats_t;
+
+/* Index bindings, which must stay valid, by group. Returns false if there
+ * are more than the table holds. */
+bool binding_table_init(binding_table_t *table, const binding_t *bindings,
+		uint32_t count);
+
+/* Bring the widgets of the bindings in the dirty groups up to date with t;
+ * TELEMETRY_GROUPS_ALL sets every one. The widgets must exist. */
+void binding_table_update(binding_table_t *table, const telemetry_t *t,
+		uint32_t dirty);
+
+/* Counts since the last call */
+void binding_get_stats(binding_stats_t *stats);
+
+/* Dim obj while stale, so old values are not trusted; for widgets updated
+ * outside a table too. Only sets the opacity if it differs, as bindings
+ * sharing an object dim it together */
+void binding_set_stale(lv_obj_t *obj, bool stale);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_BINDING_H_ */
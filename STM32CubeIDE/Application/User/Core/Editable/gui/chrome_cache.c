@@ -0,0 +1,260 @@
+/*
+ * chrome_cache.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "chrome_cache.h"
+#include <string.h>
+
+typedef struct {
+	lv_img_dsc_t img;
+	lv_coord_t ext; // the widget's extra draw size when it was taken
+} snapshot_t;
+
+static __attribute__((aligned(4))) uint8_t pool[CHROME_CACHE_BYTES];
+static snapshot_t snapshots[CHROME_CACHE_SNAPSHOTS];
+
+static chrome_cache_stats_t stats;
+static bool enabled = true;
+
+// where snapshots are taken, on LVGL's heap, kept from one to the next while
+// the screens are built: a new one each time would leave the small
+// allocations in between scattered over the freed block, and the next
+// snapshot without room
+static void *scratch;
+static uint32_t scratch_size;
+
+void chrome_cache_enable(bool enable) {
+	enabled = enable;
+}
+
+// once the screens are built and LVGL runs its timers
+static void free_scratch(lv_timer_t *timer) {
+	LV_UNUSED(timer);
+	lv_mem_free(scratch);
+	scratch = NULL;
+	scratch_size = 0;
+}
+
+// scratch of at least size bytes, or NULL if LVGL's heap has no room
+static void* get_scratch(uint32_t size) {
+	if (size <= scratch_size) {
+		return scratch;
+	}
+	if (scratch == NULL) {
+		lv_timer_t *timer = lv_timer_create(free_scratch, 0, NULL);
+
+		if (timer == NULL) {
+			return NULL;
+		}
+		lv_timer_set_repeat_count(timer, 1);
+	}
+	lv_mem_free(scratch);
+	scratch = lv_mem_alloc(size);
+	scratch_size = scratch != NULL ? size : 0;
+	return scratch;
+}
+
+// a snapshot of obj as it draws now, or an identical one taken before; it
+// is taken in the scratch first, so a duplicate needs no room in the pool
+static const snapshot_t* take(lv_obj_t *obj) {
+	uint32_t size = lv_snapshot_buf_size_needed(obj, LV_IMG_CF_TRUE_COLOR);
+	void *buf = get_scratch(size);
+	lv_coord_t ext = _lv_obj_get_ext_draw_size(obj);
+	const snapshot_t *found = NULL;
+	lv_img_dsc_t img;
+
+	if (buf == NULL
+			|| lv_snapshot_take_to_buf(obj, LV_IMG_CF_TRUE_COLOR, &img, buf,
+					size) != LV_RES_OK) {
+		stats.full++;
+		return NULL;
+	}
+	for (uint32_t i = 0; i < stats.snapshots && found == NULL; i++) {
+		const snapshot_t *old = &snapshots[i];
+
+		if (old->ext == ext && old->img.data_size == img.data_size
+				&& old->img.header.w == img.header.w
+				&& memcmp(old->img.data, img.data, img.data_size) == 0) {
+			found = old;
+		}
+	}
+	if (found == NULL && stats.snapshots < CHROME_CACHE_SNAPSHOTS
+			&& stats.bytes + img.data_size <= sizeof(pool)) {
+		snapshot_t *s = &snapshots[stats.snapshots++];
+
+		s->img = img;
+		s->img.data = &pool[stats.bytes];
+		s->ext = ext;
+		memcpy(&pool[stats.bytes], img.data, img.data_size);
+		stats.bytes = (stats.bytes + img.data_size + 3U) & ~3U;
+		found = s;
+	} else if (found == NULL) {
+		stats.full++;
+	}
+	return found;
+}
+
+// where the widget draws: its box and what it draws outside it
+static void draw_area(lv_obj_t *obj, lv_coord_t ext, lv_area_t *area) {
+	lv_obj_get_coords(obj, area);
+	lv_area_increase(area, ext, ext);
+}
+
+// the snapshot is opaque over its whole area, so LVGL can start a refresh
+// there, unless the widget is faded
+static void cover_check(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	const snapshot_t *s = lv_event_get_user_data(e);
+	lv_cover_check_info_t *info = lv_event_get_param(e);
+	lv_area_t area;
+
+	draw_area(obj, s->ext, &area);
+	if (info->res != LV_COVER_RES_MASKED
+			&& _lv_area_is_in(info->area, &area, 0)
+			&& lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN)
+					>= LV_OPA_MAX) {
+		info->res = LV_COVER_RES_COVER;
+		lv_event_stop_processing(e);
+	}
+}
+
+// the snapshot where the widget's main part would be drawn, faded as LVGL
+// fades the widget's own parts
+static void blit(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	const snapshot_t *s = lv_event_get_user_data(e);
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	lv_draw_img_dsc_t dsc;
+	lv_area_t area;
+	lv_area_t shown;
+
+	draw_area(obj, s->ext, &area);
+	if (!_lv_area_intersect(&shown, &area, draw_ctx->clip_area)) {
+		return;
+	}
+	stats.blit_px += lv_area_get_size(&shown);
+
+	lv_draw_img_dsc_init(&dsc);
+	dsc.opa = lv_obj_get_style_opa_recursive(obj, LV_PART_MAIN);
+	lv_draw_img(draw_ctx, &dsc, &area, &s->img);
+}
+
+// instead of the widget's own drawing, which the snapshot holds
+static void widget_draw(lv_event_t *e) {
+	if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+		blit(e);
+	}
+	lv_event_stop_processing(e);
+}
+
+// under the arc's indicator and knob
+static void arc_draw(lv_event_t *e) {
+	blit(e);
+}
+
+// cache disabled: the pixels the widget draws live
+static void count_live(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	lv_area_t area;
+	lv_area_t shown;
+
+	draw_area(obj, _lv_obj_get_ext_draw_size(obj), &area);
+	if (_lv_area_intersect(&shown, &area, draw_ctx->clip_area)) {
+		stats.live_px += lv_area_get_size(&shown);
+	}
+}
+
+// leave out of the snapshot, or hide for good: the children that are not
+// hidden already
+static uint32_t hide_children(lv_obj_t *obj) {
+	uint32_t hidden = 0;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj) && i < 32; i++) {
+		lv_obj_t *child = lv_obj_get_child(obj, (int32_t) i);
+
+		if (!lv_obj_has_flag(child, LV_OBJ_FLAG_HIDDEN)) {
+			lv_obj_add_flag(child, LV_OBJ_FLAG_HIDDEN);
+			hidden |= 1U << i;
+		}
+	}
+	return hidden;
+}
+
+static void show_children(lv_obj_t *obj, uint32_t hidden) {
+	for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj) && i < 32; i++) {
+		if (hidden & (1U << i)) {
+			lv_obj_clear_flag(lv_obj_get_child(obj, (int32_t) i),
+					LV_OBJ_FLAG_HIDDEN);
+		}
+	}
+}
+
+bool chrome_cache_widget(lv_obj_t *obj) {
+	if (!enabled) {
+		lv_obj_add_event_cb(obj, count_live, LV_EVENT_DRAW_MAIN, NULL);
+		return false;
+	}
+
+	const snapshot_t *s = take(obj);
+	if (s == NULL) {
+		return false;
+	}
+
+	// the snapshot has the children; hidden ones would leave the layout,
+	// see-through ones keep their place
+	for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+		lv_obj_set_style_opa(lv_obj_get_child(obj, (int32_t) i),
+				LV_OPA_TRANSP, 0);
+	}
+	lv_obj_add_event_cb(obj, widget_draw,
+			LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS, (void*) s);
+	lv_obj_add_event_cb(obj, widget_draw,
+			LV_EVENT_DRAW_POST | LV_EVENT_PREPROCESS, (void*) s);
+	lv_obj_add_event_cb(obj, cover_check,
+			LV_EVENT_COVER_CHECK | LV_EVENT_PREPROCESS, (void*) s);
+	stats.widgets++;
+	return true;
+}
+
+bool chrome_cache_arc(lv_obj_t *arc) {
+	if (!enabled) {
+		lv_obj_add_event_cb(arc, count_live, LV_EVENT_DRAW_MAIN, NULL);
+		return false;
+	}
+
+	// the ring alone: the indicator and knob faded out, the text (a gauge's
+	// units) too, and the children hidden, which an arc does not lay out
+	lv_opa_t indicator = lv_obj_get_style_opa(arc, LV_PART_INDICATOR);
+	lv_opa_t knob = lv_obj_get_style_opa(arc, LV_PART_KNOB);
+	lv_opa_t text = lv_obj_get_style_text_opa(arc, LV_PART_MAIN);
+	uint32_t hidden = hide_children(arc);
+
+	lv_obj_set_style_opa(arc, LV_OPA_TRANSP, LV_PART_INDICATOR);
+	lv_obj_set_style_opa(arc, LV_OPA_TRANSP, LV_PART_KNOB);
+	lv_obj_set_style_text_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
+	const snapshot_t *s = take(arc);
+	lv_obj_set_style_opa(arc, indicator, LV_PART_INDICATOR);
+	lv_obj_set_style_opa(arc, knob, LV_PART_KNOB);
+	lv_obj_set_style_text_opa(arc, text, LV_PART_MAIN);
+	show_children(arc, hidden);
+	if (s == NULL) {
+		return false;
+	}
+
+	// the ring now comes from the snapshot, drawn before the arc's own
+	// parts
+	lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
+	lv_obj_add_event_cb(arc, arc_draw,
+			LV_EVENT_DRAW_MAIN | LV_EVENT_PREPROCESS, (void*) s);
+	lv_obj_add_event_cb(arc, cover_check,
+			LV_EVENT_COVER_CHECK | LV_EVENT_PREPROCESS, (void*) s);
+	stats.widgets++;
+	return true;
+}
+
+void chrome_cache_get_stats(chrome_cache_stats_t *out) {
+	*out = stats;
+}
@@ -0,0 +1,58 @@
+/*
+ * chrome_cache.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_CHROME_CACHE_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_CHROME_CACHE_H_
+
+#include "lvgl/lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * The parts of a screen that never change, titles and the gauges' background
+ * rings, drawn once into RGB565 snapshots (lv_snapshot) at boot.
+ * Whenever LVGL redraws an area over such a widget it copies the snapshot
+ * instead, which LVGL's DMA2D backend does memory to memory, and the widget
+ * tree underneath is not drawn at all: the snapshot covers its box, so the
+ * refresh starts from it.
+ *
+ * A snapshot is drawn over black, the dashboard's background everywhere and
+ * the overlay layer's colour key, and is opaque, so the widgets it stands in
+ * for must sit on black. They may move, the snapshot moves with them, but
+ * must not change their looks. Identical snapshots, such as the three
+ * gauges' rings, are kept once, as long as the first of them fits: cache the
+ * biggest widgets first.
+ */
+
+// snapshot pixels: a gauge ring is 78 KB, the drive screen needs 127 KB
+#define CHROME_CACHE_BYTES (128U * 1024U)
+#define CHROME_CACHE_SNAPSHOTS 16U
+
+typedef struct {
+	uint32_t widgets; // drawing from a snapshot
+	uint32_t snapshots; // distinct ones
+	uint32_t bytes; // of CHROME_CACHE_BYTES used
+	uint32_t full; // widgets left drawing live, the cache was full
+	uint64_t blit_px; // copied from snapshots
+	uint64_t live_px; // the same widgets drawn live, cache disabled
+} chrome_cache_stats_t;
+
+/* Before the screens are built; on by default. Off, the widgets are drawn
+ * live but their pixels are still counted, to compare */
+void chrome_cache_enable(bool enable);
+
+/* Draw a widget and its children from a snapshot of them as they are now */
+bool chrome_cache_widget(lv_obj_t *obj);
+
+/* Draw the background ring of an arc or a gauge (gui/gauge.h) from a
+ * snapshot; the indicator, the knob, the text and the children are still
+ * drawn live */
+bool chrome_cache_arc(lv_obj_t *arc);
+
+void chrome_cache_get_stats(chrome_cache_stats_t *stats);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_CHROME_CACHE_H_ */
@@ -0,0 +1,154 @@
+/*
+ * digit_atlas.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "digit_atlas.h"
+#include <string.h>
+
+#define GLYPHS 11U
+
+static const char letters[GLYPHS + 1] = "0123456789-";
+
+typedef struct {
+	lv_font_t font; // first, atlas fonts are cast back
+	lv_coord_t cell_w;
+	lv_font_glyph_dsc_t glyphs[GLYPHS];
+	const uint8_t *bitmaps[GLYPHS];
+} atlas_t;
+
+static atlas_t atlases[DIGIT_ATLAS_FONTS];
+static __attribute__((aligned(4))) uint8_t pool[DIGIT_ATLAS_BYTES];
+static digit_atlas_stats_t stats;
+
+// the letter's glyph in letters[], or GLYPHS
+static uint32_t slot_of(uint32_t letter) {
+	if (letter - '0' <= 9U) {
+		return letter - '0';
+	}
+	return letter == '-' ? 10U : GLYPHS;
+}
+
+static bool get_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *dsc,
+		uint32_t letter, uint32_t letter_next) {
+	const atlas_t *atlas = (const atlas_t*) font;
+	uint32_t i = slot_of(letter);
+
+	LV_UNUSED(letter_next);
+	if (i == GLYPHS) {
+		return false;
+	}
+	*dsc = atlas->glyphs[i];
+	return true;
+}
+
+static const uint8_t* get_glyph_bitmap(const lv_font_t *font,
+		uint32_t letter) {
+	const atlas_t *atlas = (const atlas_t*) font;
+	uint32_t i = slot_of(letter);
+
+	return i == GLYPHS ? NULL : atlas->bitmaps[i];
+}
+
+// LVGL's 1, 2 and 4 bpp, first pixel in the top bits and rows not padded,
+// into A8 with the values LVGL's opacity tables give them
+static void expand(uint8_t *dest, const lv_font_glyph_dsc_t *g,
+		const uint8_t *map) {
+	uint32_t bpp = g->bpp == 3 ? 4 : g->bpp; // as draw_letter_normal()
+	uint32_t n = (uint32_t) g->box_w * g->box_h;
+
+	if (bpp == 8) {
+		memcpy(dest, map, n);
+		return;
+	}
+
+	uint32_t scale = 255U / ((1U << bpp) - 1U);
+	uint32_t bit = 0;
+	for (uint32_t i = 0; i < n; i++, bit += bpp) {
+		dest[i] = (uint8_t) (((map[bit >> 3] >> (8 - bpp - (bit & 7)))
+				& ((1U << bpp) - 1)) * scale);
+	}
+}
+
+static bool build(atlas_t *atlas, const lv_font_t *base) {
+	lv_coord_t cell_w = digit_atlas_cell_width(base);
+	uint32_t used = stats.bytes;
+
+	if (base->subpx != LV_FONT_SUBPX_NONE) {
+		return false;
+	}
+
+	for (uint32_t i = 0; i < GLYPHS; i++) {
+		lv_font_glyph_dsc_t *g = &atlas->glyphs[i];
+		uint32_t letter = (uint8_t) letters[i];
+
+		if (!lv_font_get_glyph_dsc(base, g, letter, '\0')) {
+			memset(g, 0, sizeof(*g)); // drawn as a space
+		}
+		uint32_t size = (uint32_t) g->box_w * g->box_h;
+		const uint8_t *map = size == 0 ? NULL :
+				lv_font_get_glyph_bitmap(g->resolved_font, letter);
+
+		if (used + size > sizeof(pool) || (size != 0 && map == NULL)) {
+			return false;
+		}
+		// the base's bitmap may be a decompression buffer: copy it now
+		if (size != 0) {
+			expand(&pool[used], g, map);
+		}
+		atlas->bitmaps[i] = &pool[used];
+		used += size;
+
+		g->ofs_x = (int16_t) (g->ofs_x + (cell_w - (lv_coord_t) g->adv_w) / 2);
+		g->adv_w = (uint16_t) cell_w;
+		g->bpp = 8;
+		g->is_placeholder = 0;
+		g->resolved_font = NULL;
+	}
+
+	atlas->cell_w = cell_w;
+	memset(&atlas->font, 0, sizeof(atlas->font));
+	atlas->font.get_glyph_dsc = get_glyph_dsc;
+	atlas->font.get_glyph_bitmap = get_glyph_bitmap;
+	atlas->font.line_height = base->line_height;
+	atlas->font.base_line = base->base_line;
+	atlas->font.underline_position = base->underline_position;
+	atlas->font.underline_thickness = base->underline_thickness;
+	atlas->font.fallback = base;
+	stats.bytes = (used + 3U) & ~3U;
+	return true;
+}
+
+const lv_font_t* digit_atlas_font(const lv_font_t *base) {
+	if (base->get_glyph_dsc == get_glyph_dsc) {
+		return base;
+	}
+	for (uint32_t i = 0; i < stats.fonts; i++) {
+		if (atlases[i].font.fallback == base) {
+			return &atlases[i].font;
+		}
+	}
+	if (stats.fonts == DIGIT_ATLAS_FONTS || !build(&atlases[stats.fonts],
+			base)) {
+		stats.full++;
+		return base;
+	}
+	return &atlases[stats.fonts++].font;
+}
+
+lv_coord_t digit_atlas_cell_width(const lv_font_t *font) {
+	if (font->get_glyph_dsc == get_glyph_dsc) {
+		return ((const atlas_t*) font)->cell_w;
+	}
+
+	lv_coord_t w = 0;
+	for (uint32_t c = '0'; c <= '9'; c++) {
+		w = LV_MAX(w, (lv_coord_t ) lv_font_get_glyph_width(font, c, '\0'));
+	}
+	return w;
+}
+
+void digit_atlas_get_stats(digit_atlas_stats_t *out) {
+	*out = stats;
+}
@@ -0,0 +1,46 @@
+/*
+ * digit_atlas.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_DIGIT_ATLAS_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_DIGIT_ATLAS_H_
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+
+/*
+ * A font's digits and '-' rasterised once into A8 bitmaps, as an
+ * LVGL font of their own. A glyph is found by indexing a table by the
+ * letter, not by lv_font_fmt_txt.c's binary search of the character map.
+ * Its bitmap is read as it is, without decompressing or unpacking. 8 bpp is
+ * what the DMA2D takes straight (gui/glyph_dma2d.c), at any column.
+ *
+ * The digits and '-' share one advance, the widest digit's, and
+ * each is centred in it, so numbers line up in fixed cells. There is no
+ * kerning between them. Every other letter comes from the base font, its
+ * fallback.
+ */
+
+// the drive screen's montserrat 24 and 48, whose bitmaps take 11,076 B
+#define DIGIT_ATLAS_FONTS 2U
+#define DIGIT_ATLAS_BYTES (11U * 1024U)
+
+typedef struct {
+	uint32_t fonts; // atlases built
+	uint32_t bytes; // of DIGIT_ATLAS_BYTES used
+	uint32_t full; // fonts left as they were, the atlas was full
+} digit_atlas_stats_t;
+
+/* The atlas font for base, built on the first call; base itself if the
+ * atlas is full */
+const lv_font_t* digit_atlas_font(const lv_font_t *base);
+
+/* The widest digit of a font, the cell width of an atlas font's numbers */
+lv_coord_t digit_atlas_cell_width(const lv_font_t *font);
+
+void digit_atlas_get_stats(digit_atlas_stats_t *stats);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_DIGIT_ATLAS_H_ */
@@ -0,0 +1,278 @@
+/*
+ * gauge.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "gauge.h"
+#include "digit_atlas.h"
+#include <string.h>
+
+static void gauge_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void gauge_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+const lv_obj_class_t gauge_class = {
+	.constructor_cb = gauge_constructor,
+	.event_cb = gauge_event,
+	.instance_size = sizeof(gauge_t),
+	.base_class = &lv_obj_class
+};
+
+// shared by every gauge, in place of a theme
+static lv_style_t style_track;
+static lv_style_t style_sweep;
+
+// where the parts go: the arcs' centre and radius, and the tops of the
+// numerals and units lines, which stack at the centre
+typedef struct {
+	lv_point_t center;
+	lv_coord_t r;
+	lv_coord_t numerals_y;
+	lv_coord_t numerals_h;
+	lv_coord_t units_y;
+	lv_coord_t units_h;
+} layout_t;
+
+static void get_layout(lv_obj_t *obj, layout_t *l) {
+	lv_coord_t w = lv_obj_get_width(obj);
+	lv_coord_t h = lv_obj_get_height(obj);
+
+	l->r = LV_MIN(w, h) / 2;
+	l->center.x = obj->coords.x1 + l->r;
+	l->center.y = obj->coords.y1 + l->r;
+	l->numerals_h = lv_font_get_line_height(
+			lv_obj_get_style_text_font(obj, LV_PART_INDICATOR));
+	l->units_h = lv_font_get_line_height(
+			lv_obj_get_style_text_font(obj, LV_PART_MAIN));
+	l->numerals_y = l->center.y - (l->numerals_h + l->units_h) / 2;
+	l->units_y = l->numerals_y + l->numerals_h;
+}
+
+// the end of the sweep for a value, clamped to 0..max as lv_arc clamps it
+static int32_t value_angle(const gauge_t *gauge, int32_t value) {
+	value = LV_CLAMP(0, value, gauge->max);
+	return GAUGE_ROTATION + value * GAUGE_SWEEP / gauge->max;
+}
+
+// digit cell i of a number n characters long
+static void get_cell(const gauge_t *gauge, const layout_t *l, size_t n,
+		size_t i, lv_area_t *cell) {
+	cell->x1 = l->center.x - (lv_coord_t) (n * gauge->cell_w) / 2
+			+ (lv_coord_t) i * gauge->cell_w;
+	cell->x2 = cell->x1 + gauge->cell_w - 1;
+	cell->y1 = l->numerals_y;
+	cell->y2 = l->numerals_y + l->numerals_h - 1;
+}
+
+static void format(int32_t value, char *text) {
+	char digits[GAUGE_DIGITS_MAX];
+	uint32_t u = value < 0 ? 0U - (uint32_t) value : (uint32_t) value;
+	size_t n = 0;
+
+	do {
+		digits[n++] = (char) ('0' + u % 10U);
+		u /= 10U;
+	} while (u != 0);
+	if (value < 0) {
+		*text++ = '-';
+	}
+	while (n > 0) {
+		*text++ = digits[--n];
+	}
+	*text = '\0';
+}
+
+// the numerals' cell width, for their font
+static void measure(gauge_t *gauge) {
+	gauge->cell_w = digit_atlas_cell_width(
+			lv_obj_get_style_text_font(&gauge->obj, LV_PART_INDICATOR));
+}
+
+static void draw(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	gauge_t *gauge = (gauge_t*) obj;
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	lv_draw_arc_dsc_t arc;
+	lv_draw_label_dsc_t label;
+	layout_t l;
+
+	get_layout(obj, &l);
+	if (l.r <= 0) {
+		return;
+	}
+
+	lv_draw_arc_dsc_init(&arc);
+	lv_obj_init_draw_arc_dsc(obj, LV_PART_MAIN, &arc);
+	lv_draw_arc(draw_ctx, &arc, &l.center, (uint16_t) l.r, GAUGE_ROTATION,
+			GAUGE_ROTATION + GAUGE_SWEEP);
+
+	int32_t end = value_angle(gauge, gauge->value);
+	if (end != GAUGE_ROTATION) {
+		lv_draw_arc_dsc_init(&arc);
+		lv_obj_init_draw_arc_dsc(obj, LV_PART_INDICATOR, &arc);
+		arc.width = LV_MIN(arc.width, l.r);
+		lv_draw_arc(draw_ctx, &arc, &l.center, (uint16_t) l.r, GAUGE_ROTATION,
+				(uint16_t) end);
+	}
+
+	// each digit centred in its cell, only those in the area being drawn
+	lv_draw_label_dsc_init(&label);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_INDICATOR, &label);
+	if (label.opa > LV_OPA_MIN) {
+		size_t n = strlen(gauge->text);
+
+		for (size_t i = 0; i < n; i++) {
+			lv_area_t cell;
+
+			get_cell(gauge, &l, n, i, &cell);
+			if (_lv_area_is_on(&cell, draw_ctx->clip_area)) {
+				uint32_t c = (uint8_t) gauge->text[i];
+				lv_point_t pos = { cell.x1 + (gauge->cell_w
+						- (lv_coord_t) lv_font_get_glyph_width(label.font, c, 0))
+						/ 2, cell.y1 };
+
+				lv_draw_letter(draw_ctx, &label, &pos, c);
+			}
+		}
+	}
+
+	lv_draw_label_dsc_init(&label);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label);
+	label.align = LV_TEXT_ALIGN_CENTER;
+	lv_area_t units = { obj->coords.x1, l.units_y, obj->coords.x2, l.units_y
+			+ l.units_h - 1 };
+	if (label.opa > LV_OPA_MIN && _lv_area_is_on(&units, draw_ctx->clip_area)) {
+		lv_draw_label(draw_ctx, &label, &units, gauge->units, NULL);
+	}
+}
+
+static void gauge_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	if (lv_obj_event_base(&gauge_class, e) != LV_RES_OK) {
+		return;
+	}
+
+	switch (lv_event_get_code(e)) {
+	case LV_EVENT_DRAW_MAIN:
+		draw(e);
+		break;
+	case LV_EVENT_STYLE_CHANGED:
+		measure((gauge_t*) lv_event_get_target(e));
+		break;
+	default:
+		break;
+	}
+}
+
+static void gauge_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	static bool styles_ready;
+	gauge_t *gauge = (gauge_t*) obj;
+
+	// the default theme's lv_arc look
+	if (!styles_ready) {
+		lv_style_init(&style_track);
+		lv_style_set_arc_color(&style_track,
+				lv_palette_lighten(LV_PALETTE_GREY, 2));
+		lv_style_set_arc_width(&style_track, lv_disp_dpx(NULL, 15));
+		lv_style_set_arc_rounded(&style_track, true);
+		lv_style_init(&style_sweep);
+		lv_style_set_arc_color(&style_sweep, lv_theme_get_color_primary(obj));
+		lv_style_set_arc_width(&style_sweep, lv_disp_dpx(NULL, 15));
+		lv_style_set_arc_rounded(&style_sweep, true);
+		styles_ready = true;
+	}
+
+	gauge->value = 0;
+	gauge->max = 1;
+	gauge->units = "";
+	format(0, gauge->text);
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+	lv_obj_add_style(obj, &style_track, LV_PART_MAIN);
+	lv_obj_add_style(obj, &style_sweep, LV_PART_INDICATOR);
+	measure(gauge);
+}
+
+lv_obj_t* gauge_create(lv_obj_t *parent, int32_t max, const char *units) {
+	lv_obj_t *obj = lv_obj_class_create_obj(&gauge_class, parent);
+	lv_obj_class_init_obj(obj);
+	gauge_t *gauge = (gauge_t*) obj;
+
+	gauge->max = max > 0 ? max : 1;
+	gauge->units = units;
+	return obj;
+}
+
+// the part of the sweep between two angles
+static void invalidate_sweep(lv_obj_t *obj, const layout_t *l, int32_t from,
+		int32_t to) {
+	int32_t start = LV_MIN(from, to);
+	int32_t end = LV_MAX(from, to);
+	lv_area_t area;
+
+	if (start == end) {
+		return;
+	}
+	if (start > 360) {
+		start -= 360;
+	}
+	if (end > 360) {
+		end -= 360;
+	}
+	lv_draw_arc_get_area(l->center.x, l->center.y, (uint16_t) l->r,
+			(uint16_t) start, (uint16_t) end,
+			lv_obj_get_style_arc_width(obj, LV_PART_INDICATOR),
+			lv_obj_get_style_arc_rounded(obj, LV_PART_INDICATOR), &area);
+	lv_obj_invalidate_area(obj, &area);
+}
+
+// the cells whose digit changed, or both numbers whole if the length did
+static void invalidate_numerals(lv_obj_t *obj, const layout_t *l,
+		const char *from, const char *to) {
+	gauge_t *gauge = (gauge_t*) obj;
+	size_t n = strlen(to);
+	size_t old_n = strlen(from);
+	lv_area_t area;
+	lv_area_t last;
+
+	if (n != old_n) {
+		get_cell(gauge, l, old_n, 0, &area);
+		get_cell(gauge, l, old_n, old_n - 1, &last);
+		area.x2 = last.x2;
+		lv_obj_invalidate_area(obj, &area);
+		get_cell(gauge, l, n, 0, &area);
+		get_cell(gauge, l, n, n - 1, &last);
+		area.x2 = last.x2;
+		lv_obj_invalidate_area(obj, &area);
+		return;
+	}
+	for (size_t i = 0; i < n; i++) {
+		if (from[i] != to[i]) {
+			get_cell(gauge, l, n, i, &area);
+			lv_obj_invalidate_area(obj, &area);
+		}
+	}
+}
+
+void gauge_set_value(lv_obj_t *obj, int32_t value) {
+	gauge_t *gauge = (gauge_t*) obj;
+	char text[GAUGE_DIGITS_MAX + 1];
+	layout_t l;
+
+	if (value == gauge->value) {
+		return;
+	}
+
+	get_layout(obj, &l);
+	format(value, text);
+	invalidate_sweep(obj, &l, value_angle(gauge, gauge->value),
+			value_angle(gauge, value));
+	invalidate_numerals(obj, &l, gauge->text, text);
+	gauge->value = value;
+	strcpy(gauge->text, text);
+}
+
+int32_t gauge_get_value(const lv_obj_t *obj) {
+	return ((const gauge_t*) obj)->value;
+}
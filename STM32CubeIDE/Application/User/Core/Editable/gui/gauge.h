@@ -0,0 +1,50 @@
+/*
+ * gauge.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_GAUGE_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_GAUGE_H_
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+
+/*
+ * A round gauge as one object: a 270 degree track, the value's sweep over
+ * it, the value in numerals at the centre and its units under them, all
+ * drawn by the object's own DRAW_MAIN handler. There is no layout. The
+ * numerals sit in fixed cells as wide as the widest digit, so a new value
+ * invalidates only the sweep between the old and new angles and the cells
+ * whose digit changed, or the whole number when its length changes.
+ *
+ * Styles: the track is LV_PART_MAIN's arc, the units its text; the sweep is
+ * LV_PART_INDICATOR's arc, the numerals its text. gauge_create() gives them
+ * the look the lv_arc gauges had under the default theme.
+ */
+
+#define GAUGE_ROTATION 135 // where 0 is, degrees clockwise from 3 o'clock
+#define GAUGE_SWEEP 270 // degrees from 0 to max
+#define GAUGE_DIGITS_MAX 11 // "-2147483648"
+
+typedef struct {
+	lv_obj_t obj;
+	int32_t value;
+	int32_t max;
+	const char *units; // not copied
+	char text[GAUGE_DIGITS_MAX + 1]; // the numerals on screen
+	lv_coord_t cell_w; // widest digit of the numerals' font
+} gauge_t;
+
+extern const lv_obj_class_t gauge_class;
+
+/* A gauge from 0 to max showing 0; units must stay valid */
+lv_obj_t* gauge_create(lv_obj_t *parent, int32_t max, const char *units);
+
+/* The numerals show value as it is; the sweep stops at 0 and max */
+void gauge_set_value(lv_obj_t *obj, int32_t value);
+
+int32_t gauge_get_value(const lv_obj_t *obj);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_GAUGE_H_ */
@@ -0,0 +1,249 @@
+/*
+ * glyph_dma2d.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "glyph_dma2d.h"
+#include "dma2d.h"
+#include <string.h>
+
+#if GLYPH_DMA2D
+
+#define MODE_M2M_BLEND (0x2U << DMA2D_CR_MODE_Pos)
+
+typedef struct {
+	const lv_font_t *font; // NULL for a free slot
+	uint32_t letter;
+	uint32_t offset; // of the A4 bitmap in the pool
+} glyph_t;
+
+static glyph_t glyphs[GLYPH_DMA2D_CACHE_GLYPHS];
+static uint32_t glyph_count;
+static __attribute__((aligned(4))) uint8_t pool[GLYPH_DMA2D_CACHE_BYTES];
+static uint32_t pool_used;
+
+static glyph_dma2d_stats_t stats;
+
+// a letter's transfer was started and nothing has waited for it since
+static bool pending;
+
+// the functions of the first display attached, every display here uses the
+// same draw context
+static void (*draw_letter)(lv_draw_ctx_t*, const lv_draw_label_dsc_t*,
+		const lv_point_t*, uint32_t);
+static void (*wait_for_finish)(lv_draw_ctx_t*);
+
+// before programming a transfer: the display port's flush copy may still
+// run, and its interrupt must see its flag before the registers change, so
+// wait for HAL to clear TCIE as well
+static void dma2d_idle(void) {
+	while (DMA2D->CR & (DMA2D_CR_START | DMA2D_CR_TCIE)) {
+	}
+	pending = false;
+}
+
+static uint32_t slot_of(const lv_font_t *font, uint32_t letter) {
+	return ((uint32_t) (uintptr_t) font ^ (letter * 2654435761U))
+			& (GLYPH_DMA2D_CACHE_GLYPHS - 1);
+}
+
+// LVGL's 1, 2 and 4 bpp, first pixel in the top bits, into A4 with the first
+// pixel in the low nibble and rows padded to a byte; the alpha values come
+// out as LVGL's opacity tables have them
+static void repack(uint8_t *dest, uint32_t stride,
+		const lv_font_glyph_dsc_t *g, const uint8_t *map) {
+	uint32_t bpp = g->bpp == 3 ? 4 : g->bpp; // as draw_letter_normal()
+	uint32_t scale = bpp == 4 ? 1 : bpp == 2 ? 5 : 15;
+	uint32_t bit = 0;
+
+	memset(dest, 0, stride * g->box_h);
+	for (uint32_t y = 0; y < g->box_h; y++) {
+		for (uint32_t x = 0; x < g->box_w; x++, bit += bpp) {
+			uint32_t v = (map[bit >> 3] >> (8 - bpp - (bit & 7)))
+					& ((1U << bpp) - 1);
+
+			dest[y * stride + x / 2] |= (uint8_t) (v * scale << (4 * (x & 1)));
+		}
+	}
+}
+
+// the glyph as A4, NULL if it does not fit the cache
+static const uint8_t* cached_a4(const lv_font_glyph_dsc_t *g, uint32_t letter,
+		const uint8_t *map, uint32_t stride) {
+	const lv_font_t *font = g->resolved_font;
+	uint32_t size = stride * g->box_h;
+	uint32_t i = slot_of(font, letter);
+
+	for (; glyphs[i].font != NULL; i = (i + 1) & (GLYPH_DMA2D_CACHE_GLYPHS - 1)) {
+		if (glyphs[i].font == font && glyphs[i].letter == letter) {
+			return &pool[glyphs[i].offset];
+		}
+	}
+	if (size > sizeof(pool)) {
+		return NULL;
+	}
+
+	// start over when full, or the probing gets long; the last letter's
+	// transfer may still read the pool
+	if (pool_used + size > sizeof(pool)
+			|| glyph_count >= GLYPH_DMA2D_CACHE_GLYPHS * 3 / 4) {
+		dma2d_idle();
+		memset(glyphs, 0, sizeof(glyphs));
+		glyph_count = 0;
+		pool_used = 0;
+		stats.flushed++;
+		i = slot_of(font, letter);
+	}
+
+	repack(&pool[pool_used], stride, g, map);
+	glyphs[i].font = font;
+	glyphs[i].letter = letter;
+	glyphs[i].offset = pool_used;
+	glyph_count++;
+	pool_used = (pool_used + size + 3) & ~3U;
+	stats.repacked++;
+	return &pool[glyphs[i].offset];
+}
+
+// true if the letter was blended, or had nothing to draw
+static bool blend_letter(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_label_dsc_t *dsc, const lv_point_t *pos,
+		uint32_t letter) {
+	lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+	const lv_font_t *font = dsc->font;
+	lv_font_glyph_dsc_t g;
+	lv_area_t box;
+	lv_area_t area;
+
+	// LVGL applies the opacity twice to letters, once in the mask and once
+	// blending it, which one transfer cannot repeat
+	if (dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL
+			|| disp->driver->set_px_cb != NULL || disp->driver->screen_transp
+			|| !lv_font_get_glyph_dsc(font, &g, letter, '\0')
+			|| g.resolved_font->subpx || g.bpp > 8) {
+		return false;
+	}
+	if (g.box_w == 0 || g.box_h == 0) {
+		return true; // a space
+	}
+
+	box.x1 = pos->x + g.ofs_x;
+	box.y1 = pos->y + (font->line_height - font->base_line) - g.box_h - g.ofs_y;
+	box.x2 = box.x1 + g.box_w - 1;
+	box.y2 = box.y1 + g.box_h - 1;
+	if (!_lv_area_intersect(&area, &box, draw_ctx->clip_area)) {
+		return true;
+	}
+	if (lv_draw_mask_is_any(&area)) {
+		return false;
+	}
+
+	const uint8_t *map = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+	uint32_t col = (uint32_t) (area.x1 - box.x1);
+	uint32_t row = (uint32_t) (area.y1 - box.y1);
+	uint32_t format;
+	uint32_t src_width; // pixels
+	const uint8_t *src;
+
+	if (map == NULL) {
+		return false;
+	}
+	if (g.bpp == 8) {
+		format = DMA2D_INPUT_A8;
+		src_width = g.box_w;
+		src = map + row * src_width + col;
+	} else {
+		uint32_t stride = (g.box_w + 1U) / 2U;
+
+		// an A4 line starts on a byte
+		if (col & 1) {
+			return false;
+		}
+		src = cached_a4(&g, letter, map, stride);
+		if (src == NULL) {
+			return false;
+		}
+		format = DMA2D_INPUT_A4;
+		src_width = 2 * stride;
+		src += row * stride + col / 2;
+	}
+
+	lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+	lv_color_t *dest = (lv_color_t*) draw_ctx->buf
+			+ dest_stride * (area.y1 - draw_ctx->buf_area->y1)
+			+ (area.x1 - draw_ctx->buf_area->x1);
+	uint32_t width = (uint32_t) lv_area_get_width(&area);
+	uint32_t height = (uint32_t) lv_area_get_height(&area);
+
+	dma2d_idle();
+	DMA2D->CR = MODE_M2M_BLEND;
+	DMA2D->FGPFCCR = format; // the glyph's alpha as it is
+	DMA2D->FGMAR = (uint32_t) (uintptr_t) src;
+	DMA2D->FGOR = src_width - width;
+	DMA2D->FGCOLR = lv_color_to32(dsc->color) & 0x00FFFFFFU;
+	DMA2D->BGPFCCR = DMA2D_INPUT_RGB565;
+	DMA2D->BGMAR = (uint32_t) (uintptr_t) dest;
+	DMA2D->BGOR = (uint32_t) dest_stride - width;
+	DMA2D->OPFCCR = DMA2D_OUTPUT_RGB565;
+	DMA2D->OMAR = (uint32_t) (uintptr_t) dest;
+	DMA2D->OOR = (uint32_t) dest_stride - width;
+	DMA2D->NLR = (width << DMA2D_NLR_PL_Pos) | (height << DMA2D_NLR_NL_Pos);
+	DMA2D->IFCR = 0x3FU;
+	DMA2D->CR |= DMA2D_CR_START;
+	pending = true;
+	stats.dma2d++;
+	return true;
+}
+
+static void dma2d_draw_letter(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_label_dsc_t *dsc, const lv_point_t *pos,
+		uint32_t letter) {
+	if (!blend_letter(draw_ctx, dsc, pos, letter)) {
+		stats.fallback++;
+		draw_letter(draw_ctx, dsc, pos, letter);
+	}
+}
+
+// LVGL calls this before it blends on the CPU, copies areas and flushes
+static void dma2d_wait_for_finish(lv_draw_ctx_t *draw_ctx) {
+	// only a letter's transfer: a flush copy running now goes on while the
+	// next buffer is drawn
+	if (pending) {
+		while (DMA2D->CR & DMA2D_CR_START) {
+		}
+		pending = false;
+	}
+	if (wait_for_finish != NULL) {
+		wait_for_finish(draw_ctx);
+	}
+}
+
+void glyph_dma2d_attach(lv_disp_drv_t *drv) {
+	lv_draw_ctx_t *ctx = drv->draw_ctx;
+
+	if (draw_letter == NULL) {
+		draw_letter = ctx->draw_letter;
+		wait_for_finish = ctx->wait_for_finish;
+	}
+	if (ctx->draw_letter == draw_letter) {
+		ctx->draw_letter = dma2d_draw_letter;
+		ctx->wait_for_finish = dma2d_wait_for_finish;
+	}
+}
+
+void glyph_dma2d_get_stats(glyph_dma2d_stats_t *out) {
+	*out = stats;
+}
+
+#else
+
+void glyph_dma2d_attach(lv_disp_drv_t *drv) {
+	(void) drv; // another colour format, LVGL draws the letters
+}
+
+void glyph_dma2d_get_stats(glyph_dma2d_stats_t *out) {
+	memset(out, 0, sizeof(*out));
+}
+
+#endif
@@ -0,0 +1,52 @@
+/*
+ * glyph_dma2d.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_GLYPH_DMA2D_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_GLYPH_DMA2D_H_
+
+#include "lvgl/lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Letters blended by DMA2D straight from their bitmaps, memory to memory
+ * with blending, the glyph as A4 or A8 foreground in the label colour over
+ * the RGB565 draw buffer. LVGL's own letter drawing expands every glyph into
+ * an A8 mask on the CPU, a row chunk at a time, and waits for each chunk's
+ * DMA2D transfer.
+ *
+ * 8 bpp glyphs are read from the font. Below that LVGL packs pixels most
+ * significant bits first and rows without padding, while the DMA2D wants
+ * the first pixel in the low nibble and each row starting on a byte, so
+ * 1, 2 and 4 bpp glyphs are repacked into A4 once, into a RAM cache.
+ *
+ * A letter's transfer is left running: the CPU places the next letter while
+ * DMA2D blends this one, and the draw context's wait_for_finish, which LVGL
+ * calls before anything else touches the buffer and before flushing, waits
+ * for it. Letters under other masks, below LV_OPA_MAX, in other blend modes
+ * or starting on an odd A4 column are drawn by LVGL.
+ */
+
+// the colour format the transfers are set up for
+#define GLYPH_DMA2D (LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0)
+
+#define GLYPH_DMA2D_CACHE_BYTES (24U * 1024U) // A4 glyphs, emptied when full
+#define GLYPH_DMA2D_CACHE_GLYPHS 256U // a power of two
+
+typedef struct {
+	uint32_t dma2d; // letters blended by DMA2D
+	uint32_t fallback; // handed to LVGL
+	uint32_t repacked; // glyphs added to the cache
+	uint32_t flushed; // times the cache was emptied
+} glyph_dma2d_stats_t;
+
+/* Draw the letters of a registered display through DMA2D */
+void glyph_dma2d_attach(lv_disp_drv_t *drv);
+
+void glyph_dma2d_get_stats(glyph_dma2d_stats_t *stats);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_GLYPH_DMA2D_H_ */
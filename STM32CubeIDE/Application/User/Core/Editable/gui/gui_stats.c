@@ -0,0 +1,48 @@
+/*
+ * gui_stats.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "gui_stats.h"
+
+static gui_frame_stats_t gui_frame_stats;
+
+void gui_stats_record_frame(uint32_t render_us, uint32_t px) {
+	gui_frame_stats_t *s = &gui_frame_stats;
+
+	s->frames++;
+	s->px_total += px;
+	s->px_last = px;
+	if (px > s->px_max) {
+		s->px_max = px;
+	}
+	s->render_us_total += render_us;
+	s->render_us_last = render_us;
+	if (render_us > s->render_us_max) {
+		s->render_us_max = render_us;
+	}
+}
+
+void gui_stats_record_switch(uint32_t switch_us) {
+	gui_frame_stats_t *s = &gui_frame_stats;
+
+	s->switches++;
+	s->switch_us_last = switch_us;
+	if (switch_us > s->switch_us_max) {
+		s->switch_us_max = switch_us;
+	}
+}
+
+void gui_stats_record_flush_wait(uint32_t wait_us) {
+	gui_frame_stats.flush_wait_us_total += wait_us;
+}
+
+void gui_stats_set_display(const char *mode, uint32_t ram_bytes) {
+	gui_frame_stats.display_mode = mode;
+	gui_frame_stats.display_ram_bytes = ram_bytes;
+}
+
+void gui_stats_read(gui_frame_stats_t *stats) {
+	*stats = gui_frame_stats;
+}
@@ -0,0 +1,45 @@
+/*
+ * gui_stats.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_GUI_STATS_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_GUI_STATS_H_
+
+#include <stdint.h>
+
+/*
+ * Per-frame render statistics fed by the LVGL display monitor callback:
+ * how many pixels each refresh redrew and how long it took. Written from the
+ * GUI task only; the totals wrap, so readers take differences between two
+ * reads to get rates.
+ */
+typedef struct {
+	uint32_t frames; // refreshes that redrew something
+	uint32_t px_total; // redrawn pixels over all frames, wraps
+	uint32_t px_last; // redrawn pixels of the newest frame
+	uint32_t px_max;
+	uint32_t render_us_total; // wraps
+	uint32_t render_us_last; // refresh start to last area drawn
+	uint32_t render_us_max;
+	uint32_t flush_wait_us_total; // GUI task blocked on the display, wraps
+	uint32_t switches; // screen changes
+	uint32_t switch_us_last; // state change to first frame of the new screen
+	uint32_t switch_us_max;
+	const char *display_mode; // display port configuration
+	uint32_t display_ram_bytes; // framebuffers and draw buffers
+} gui_frame_stats_t;
+
+void gui_stats_record_frame(uint32_t render_us, uint32_t px);
+
+void gui_stats_record_switch(uint32_t switch_us);
+
+void gui_stats_record_flush_wait(uint32_t wait_us);
+
+void gui_stats_set_display(const char *mode, uint32_t ram_bytes);
+
+void gui_stats_read(gui_frame_stats_t *stats);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_GUI_STATS_H_ */
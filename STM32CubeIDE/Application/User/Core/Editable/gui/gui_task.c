@@ -5,39 +5,73 @@
  *      Author:
  */
 #include "gui_task.h"
+#include "gui_stats.h"
+#include "render_profile.h"
+#include "../telemetry/telemetry.h"
+#include "../timing/cycles.h"
+#include "../timing/timebase.h"
+
+void gui_task_step(void) {
+	static uint32_t pending;
+	static uint32_t last_update_us;
+	uint32_t now_us = timebase_us();
+
+	if (current_display_state == UNINITIALIZED) {
+		initialize_display_screens();
+	}
+
+	pending |= telemetry_take_dirty();
+	telemetry_snapshot(&telemetry);
+	pending |= telemetry_update_stale(&telemetry, now_us);
+	telemetry.vcu.active = !telemetry.stale[CAN_DB_VCU_FAULT_SIGNAL];
+
+	if ((time_count % GUI_BLINK_LOOPS) == 0) {
+		pending |= GUI_GROUP_BLINK;
+	}
+	if ((time_count % GUI_PERIODIC_LOOPS) == 0) {
+		pending |= GUI_GROUP_PERIODIC;
+	}
+
+	if (time_count < LOGO_TIME) {
+		commanded_display_state = LOGO;
+	} else if (telemetry.vcu.fault != 0 || !telemetry.vcu.active) {
+		commanded_display_state = DIAGNOSTIC;
+	} else {
+		commanded_display_state = telemetry.vcu.rtd ? DRIVE : PRE_DRIVE;
+	}
+
+	if (commanded_display_state != current_display_state) {
+		// the screen was last updated when it was left, so fill in every
+		// widget, show it and render it now instead of on the next refresh
+		current_display_state = commanded_display_state;
+		update_display_state(current_display_state, TELEMETRY_GROUPS_ALL);
+		load_display_state(current_display_state);
+		lv_refr_now(NULL);
+		gui_stats_record_switch(timebase_us() - now_us);
+		pending = 0;
+		last_update_us = now_us;
+	}
+
+	// only widgets bound to changed groups, at most once per interval
+	if (pending != 0
+			&& now_us - last_update_us >= GUI_MIN_REFRESH_MS * 1000U) {
+		update_display_state(current_display_state, pending);
+		pending = 0;
+		last_update_us = now_us;
+	}
+
+	time_count++;
+}
 
 static void GuiTask(void *pvParameters) {
 	(void) pvParameters;
 	const TickType_t xDelay = pdMS_TO_TICKS(10);
 
 	for (;;) {
+		uint32_t start = cycles_now();
 		lv_timer_handler();   // or lv_task_handler();
-
-		if (time_count < LOGO_TIME) {
-			commanded_display_state = LOGO;
-		} else if (vcu.fault != 0 || !vcu.active) {
-			commanded_display_state = DIAGNOSTIC;
-		} else {
-			commanded_display_state = vcu.rtd ? DRIVE : PRE_DRIVE;
-		}
-		static bool init_screen = false;
-		if (init_screen) {
-			init_screen = false;
-			initialize_display_colors();
-			initialize_display_state(commanded_display_state);
-		} else if (commanded_display_state != current_display_state) {
-			clear_display_state(current_display_state);
-			init_screen = true;
-			current_display_state = commanded_display_state;
-		}
-
-		if ((time_count % 20) == 0 && !init_screen) { // since loop ticks every 10 ms
-			update_display_state(current_display_state);
-		}
-
-		time_count++;
-
-		vcu.active = (time_count - vcu.last_comm_time) <= 50;
+		render_profile_record(RENDER_PROFILE_HANDLER, cycles_now() - start);
+		gui_task_step();
 
 		osDelay(xDelay);
 	}
@@ -19,6 +19,11 @@
 /* Create the GUI task (call once during system init) */
 void CreateGuiTask(void);
 
+/* One GUI loop iteration after lv_timer_handler(): refresh the telemetry
+ * snapshot, pick the screen and update it. The first call builds every
+ * screen. Expects a 10 ms period. */
+void gui_task_step(void);
+
 /* Optional: allow starting/stopping the GUI task from other code (not required) */
 void GuiTask_Stop(void);
 void GuiTask_Start(void);
@@ -0,0 +1,131 @@
+/*
+ * label_text.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "label_text.h"
+#include <string.h>
+
+static const uint32_t pow10[LABEL_TEXT_DECIMALS_MAX + 1] = { 1U, 10U, 100U,
+		1000U, 10000U, 100000U, 1000000U };
+
+// n characters over the text being built, noting any that differ
+static void append(label_text_t *text, const char *chars, uint32_t n) {
+	char *last = &text->text[LABEL_TEXT_BYTES - 1];
+
+	for (uint32_t i = 0; i < n && text->end < last; i++) {
+		if (*text->end != chars[i]) {
+			*text->end = chars[i];
+			text->changed = true;
+		}
+		text->end++;
+	}
+}
+
+void label_text_bind(label_text_t *text, lv_obj_t *label) {
+	text->label = label;
+	text->end = text->text;
+	text->changed = false;
+	text->text[0] = '\0';
+	lv_label_set_text_static(label, text->text);
+}
+
+void label_text_begin(label_text_t *text) {
+	text->end = text->text;
+	text->changed = false;
+}
+
+void label_text_str(label_text_t *text, const char *str) {
+	append(text, str, (uint32_t) strlen(str));
+}
+
+void label_text_int(label_text_t *text, int32_t value) {
+	char number[LABEL_TEXT_NUMBER_MAX];
+
+	append(text, number,
+			(uint32_t) (label_text_format_int(number, value) - number));
+}
+
+void label_text_float(label_text_t *text, float value, uint32_t decimals) {
+	char number[LABEL_TEXT_NUMBER_MAX];
+
+	append(text, number,
+			(uint32_t) (label_text_format_float(number, value, decimals)
+					- number));
+}
+
+void label_text_end(label_text_t *text) {
+	if (*text->end != '\0') {
+		*text->end = '\0'; // the old text was longer
+		text->changed = true;
+	}
+	if (text->changed) {
+		lv_label_set_text_static(text->label, text->text);
+	}
+}
+
+char* label_text_format_int(char *out, int32_t value) {
+	return label_text_format_fixed(out, value, 0);
+}
+
+char* label_text_format_fixed(char *out, int32_t scaled, uint32_t decimals) {
+	uint32_t u = scaled < 0 ? 0U - (uint32_t) scaled : (uint32_t) scaled;
+	char digits[10];
+	uint32_t n = 0;
+
+	// least significant first, with zeros up to "0.0..." as needed
+	decimals = LV_MIN(decimals, LABEL_TEXT_DECIMALS_MAX);
+	do {
+		digits[n++] = (char) ('0' + u % 10U);
+		u /= 10U;
+	} while (u != 0 || n <= decimals);
+
+	if (scaled < 0) {
+		*out++ = '-';
+	}
+	while (n > 0) {
+		*out++ = digits[--n];
+		if (n == decimals && n != 0) {
+			*out++ = '.';
+		}
+	}
+	return out;
+}
+
+int32_t label_text_scale_float(float value, uint32_t decimals) {
+	decimals = LV_MIN(decimals, LABEL_TEXT_DECIMALS_MAX);
+	float magnitude = value < 0.0f ? -value : value;
+	float limit = 2147483520.0f / (float) pow10[decimals];
+
+	// NaN as 0, and clamped to about what an int32_t holds scaled
+	if (!(magnitude < limit)) {
+		magnitude = magnitude != magnitude ? 0.0f : limit;
+	}
+
+	// the fraction scaled on its own, exactly as lv_vsnprintf() does, so a
+	// value just off a half rounds the same way; then half to even
+	uint32_t whole = (uint32_t) magnitude;
+	float rest = (magnitude - (float) whole) * (float) pow10[decimals];
+	uint32_t frac = (uint32_t) rest;
+	rest -= (float) frac;
+	if (rest > 0.5f || (rest == 0.5f && (frac & 1U) != 0)) {
+		frac++;
+	}
+
+	int32_t scaled = (int32_t) LV_MIN(whole * pow10[decimals] + frac,
+			(uint32_t) INT32_MAX);
+	return value < 0.0f ? -scaled : scaled;
+}
+
+char* label_text_format_float(char *out, float value, uint32_t decimals) {
+	int32_t scaled = label_text_scale_float(value, decimals);
+
+	// the sign on its own, so a negative value that rounds to zero still
+	// shows as "-0.0", as it did with lv_vsnprintf()
+	if (value < 0.0f) {
+		*out++ = '-';
+		scaled = -scaled;
+	}
+	return label_text_format_fixed(out, scaled, decimals);
+}
@@ -0,0 +1,62 @@
+/*
+ * label_text.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_LABEL_TEXT_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_LABEL_TEXT_H_
+
+#include "lvgl/lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * A label's text built piece by piece in a buffer the label shows as it is
+ * (lv_label_set_text_static), instead of through lv_vsnprintf() into a
+ * temporary and a copy onto LVGL's heap. Each piece is compared with the
+ * text it overwrites, so an unchanged text costs no re-layout and no redraw.
+ * Building and drawing both happen on the GUI task, so the label never draws
+ * a half-built text.
+ *
+ * Numbers are integers, or fixed-point decimals with a number of decimals
+ * the caller knows: a float is scaled and rounded to an integer once, half
+ * to even as lv_vsnprintf() rounds, and written digit by digit with no
+ * format string to parse and no double arithmetic.
+ */
+
+#define LABEL_TEXT_BYTES 160U // longest text, with its terminator
+#define LABEL_TEXT_DECIMALS_MAX 6U
+#define LABEL_TEXT_NUMBER_MAX 12U // "-2147483648", "-2147.483648"
+
+typedef struct {
+	lv_obj_t *label;
+	char *end; // where the next piece goes
+	bool changed;
+	char text[LABEL_TEXT_BYTES];
+} label_text_t;
+
+/* The label shows text's buffer from now on, empty */
+void label_text_bind(label_text_t *text, lv_obj_t *label);
+
+void label_text_begin(label_text_t *text);
+void label_text_str(label_text_t *text, const char *str);
+void label_text_int(label_text_t *text, int32_t value);
+void label_text_float(label_text_t *text, float value, uint32_t decimals);
+
+/* Terminates the text; the label re-lays it out only if it changed. Pieces
+ * that do not fit are cut */
+void label_text_end(label_text_t *text);
+
+/* The formatters underneath: at most LABEL_TEXT_NUMBER_MAX characters at
+ * out, not terminated; they return the end */
+char* label_text_format_int(char *out, int32_t value);
+char* label_text_format_fixed(char *out, int32_t scaled, uint32_t decimals);
+char* label_text_format_float(char *out, float value, uint32_t decimals);
+
+/* value times 10^decimals, rounded as label_text_format_float() rounds it;
+ * NaN as 0, and clamped to what an int32_t holds */
+int32_t label_text_scale_float(float value, uint32_t decimals);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_LABEL_TEXT_H_ */
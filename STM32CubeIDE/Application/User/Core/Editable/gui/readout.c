@@ -0,0 +1,220 @@
+/*
+ * readout.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "readout.h"
+#include "digit_atlas.h"
+#include <string.h>
+
+static void readout_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj);
+static void readout_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+const lv_obj_class_t readout_class = {
+	.constructor_cb = readout_constructor,
+	.event_cb = readout_event,
+	.instance_size = sizeof(readout_t),
+	.base_class = &lv_obj_class
+};
+
+static lv_coord_t ascent(const lv_font_t *font) {
+	return font->line_height - font->base_line;
+}
+
+static lv_coord_t text_width(lv_obj_t *obj, lv_part_t part, const char *text) {
+	if (text == NULL) {
+		return 0;
+	}
+	return lv_txt_get_width(text, (uint32_t) strlen(text),
+			lv_obj_get_style_text_font(obj, part),
+			lv_obj_get_style_text_letter_space(obj, part), LV_TEXT_FLAG_NONE);
+}
+
+// the parts' widths and the shared base line, for the current styles
+static void measure(readout_t *readout) {
+	lv_obj_t *obj = &readout->obj;
+	const lv_font_t *main_font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+	const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_INDICATOR);
+
+	readout->cell_w = digit_atlas_cell_width(font);
+	readout->prefix_w = text_width(obj, LV_PART_MAIN, readout->prefix);
+	readout->suffix_w = text_width(obj, LV_PART_INDICATOR, readout->suffix);
+	readout->ascent = LV_MAX(ascent(main_font), ascent(font));
+	readout->height = readout->ascent
+			+ LV_MAX(main_font->base_line, font->base_line);
+}
+
+// right aligned in the cells, blanks before
+static void format(const readout_t *readout, int32_t value, char *cells) {
+	uint32_t u = value < 0 ? 0U - (uint32_t) value : (uint32_t) value;
+	uint32_t i = readout->digits;
+
+	cells[i] = '\0';
+	do {
+		cells[--i] = (char) ('0' + u % 10U);
+		u /= 10U;
+	} while (u != 0 && i > 0);
+	if (value < 0 && i > 0) {
+		cells[--i] = '-';
+	}
+	while (i > 0) {
+		cells[--i] = ' ';
+	}
+}
+
+// digit cell i, the content's height
+static void get_cell(readout_t *readout, uint32_t i, lv_area_t *cell) {
+	lv_obj_get_content_coords(&readout->obj, cell);
+	cell->x1 += readout->prefix_w + (lv_coord_t) i * readout->cell_w;
+	cell->x2 = cell->x1 + readout->cell_w - 1;
+}
+
+static void draw(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	readout_t *readout = (readout_t*) obj;
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	lv_draw_label_dsc_t label;
+	lv_area_t content;
+	lv_area_t area;
+
+	lv_obj_get_content_coords(obj, &content);
+
+	lv_draw_label_dsc_init(&label);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label);
+	label.align = LV_TEXT_ALIGN_LEFT;
+	area.x1 = content.x1;
+	area.x2 = area.x1 + readout->prefix_w - 1;
+	area.y1 = content.y1 + readout->ascent - ascent(label.font);
+	area.y2 = area.y1 + label.font->line_height - 1;
+	if (readout->prefix != NULL && label.opa > LV_OPA_MIN
+			&& _lv_area_is_on(&area, draw_ctx->clip_area)) {
+		lv_draw_label(draw_ctx, &label, &area, readout->prefix, NULL);
+	}
+
+	lv_draw_label_dsc_init(&label);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_INDICATOR, &label);
+	label.align = LV_TEXT_ALIGN_LEFT;
+	if (label.opa <= LV_OPA_MIN) {
+		return;
+	}
+	lv_coord_t y = content.y1 + readout->ascent - ascent(label.font);
+
+	// each digit centred in its cell, only those in the area being drawn
+	for (uint32_t i = 0; i < readout->digits; i++) {
+		uint32_t c = (uint8_t) readout->cells[i];
+
+		get_cell(readout, i, &area);
+		if (c != ' ' && _lv_area_is_on(&area, draw_ctx->clip_area)) {
+			lv_point_t pos = { area.x1 + (readout->cell_w
+					- (lv_coord_t) lv_font_get_glyph_width(label.font, c, '\0'))
+					/ 2, y };
+
+			lv_draw_letter(draw_ctx, &label, &pos, c);
+		}
+	}
+
+	area.x1 = content.x1 + readout->prefix_w
+			+ (lv_coord_t) readout->digits * readout->cell_w;
+	area.x2 = area.x1 + readout->suffix_w - 1;
+	area.y1 = y;
+	area.y2 = y + label.font->line_height - 1;
+	if (readout->suffix != NULL && _lv_area_is_on(&area, draw_ctx->clip_area)) {
+		lv_draw_label(draw_ctx, &label, &area, readout->suffix, NULL);
+	}
+}
+
+static void readout_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	if (lv_obj_event_base(&readout_class, e) != LV_RES_OK) {
+		return;
+	}
+
+	lv_obj_t *obj = lv_event_get_target(e);
+	readout_t *readout = (readout_t*) obj;
+
+	switch (lv_event_get_code(e)) {
+	case LV_EVENT_DRAW_MAIN:
+		draw(e);
+		break;
+	case LV_EVENT_GET_SELF_SIZE: {
+		lv_point_t *size = lv_event_get_param(e);
+
+		size->x = LV_MAX(size->x, readout->prefix_w
+				+ (lv_coord_t) readout->digits * readout->cell_w
+				+ readout->suffix_w);
+		size->y = LV_MAX(size->y, readout->height);
+		break;
+	}
+	case LV_EVENT_STYLE_CHANGED:
+		measure(readout);
+		lv_obj_refresh_self_size(obj);
+		break;
+	default:
+		break;
+	}
+}
+
+static void readout_constructor(const lv_obj_class_t *class_p, lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	readout_t *readout = (readout_t*) obj;
+
+	readout->value = 0;
+	readout->min = 0;
+	readout->max = 9;
+	readout->digits = 1;
+	readout->prefix = NULL;
+	readout->suffix = NULL;
+	format(readout, 0, readout->cells);
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+	lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+	measure(readout);
+}
+
+lv_obj_t* readout_create(lv_obj_t *parent, uint32_t digits, const char *prefix,
+		const char *suffix) {
+	lv_obj_t *obj = lv_obj_class_create_obj(&readout_class, parent);
+	lv_obj_class_init_obj(obj);
+	readout_t *readout = (readout_t*) obj;
+	int32_t max = 1;
+
+	digits = LV_CLAMP(1U, digits, READOUT_DIGITS_MAX - 1U);
+	for (uint32_t i = 0; i < digits; i++) {
+		max *= 10;
+	}
+	readout->digits = (uint8_t) digits;
+	readout->max = max - 1;
+	readout->min = -(max / 10 - 1);
+	readout->prefix = prefix;
+	readout->suffix = suffix;
+	format(readout, 0, readout->cells);
+	measure(readout);
+	lv_obj_refresh_self_size(obj);
+	return obj;
+}
+
+void readout_set_value(lv_obj_t *obj, int32_t value) {
+	readout_t *readout = (readout_t*) obj;
+	char cells[READOUT_DIGITS_MAX + 1];
+	lv_area_t area;
+
+	value = LV_CLAMP(readout->min, value, readout->max);
+	if (value == readout->value) {
+		return;
+	}
+
+	format(readout, value, cells);
+	for (uint32_t i = 0; i < readout->digits; i++) {
+		if (cells[i] != readout->cells[i]) {
+			get_cell(readout, i, &area);
+			lv_obj_invalidate_area(obj, &area);
+		}
+	}
+	readout->value = value;
+	memcpy(readout->cells, cells, sizeof(cells));
+}
+
+int32_t readout_get_value(const lv_obj_t *obj) {
+	return ((const readout_t*) obj)->value;
+}
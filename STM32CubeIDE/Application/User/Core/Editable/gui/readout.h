@@ -0,0 +1,58 @@
+/*
+ * readout.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_READOUT_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_READOUT_H_
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+
+/*
+ * A number in a fixed row of digit cells, right aligned, between a prefix
+ * and a suffix that do not change, such as "SOC: " and "%". It is one
+ * object with no text layout. The cells are as wide as the widest digit and
+ * never move, so a new value invalidates only the cells whose digit
+ * changed. With the numbers' font from digit_atlas_font(), each digit is a
+ * single table lookup and an A8 blit.
+ *
+ * Styles: the prefix is LV_PART_MAIN's text, the number and suffix
+ * LV_PART_INDICATOR's, which falls back to the main part's. A colour for
+ * the value is one style change on the indicator. The object sizes itself
+ * to its content.
+ */
+
+#define READOUT_DIGITS_MAX 10U
+
+typedef struct {
+	lv_obj_t obj;
+	int32_t value;
+	int32_t min; // the most the cells can show
+	int32_t max;
+	uint8_t digits;
+	const char *prefix; // not copied
+	const char *suffix; // not copied
+	char cells[READOUT_DIGITS_MAX + 1]; // on screen, ' ' blank
+	lv_coord_t cell_w;
+	lv_coord_t prefix_w;
+	lv_coord_t suffix_w;
+	lv_coord_t ascent; // the taller font's, above the shared base line
+	lv_coord_t height;
+} readout_t;
+
+extern const lv_obj_class_t readout_class;
+
+/* A readout of up to digits cells, '-' included, showing 0; prefix and
+ * suffix may be NULL and must stay valid */
+lv_obj_t* readout_create(lv_obj_t *parent, uint32_t digits, const char *prefix,
+		const char *suffix);
+
+/* Clamped to what the cells can show */
+void readout_set_value(lv_obj_t *obj, int32_t value);
+
+int32_t readout_get_value(const lv_obj_t *obj);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_READOUT_H_ */
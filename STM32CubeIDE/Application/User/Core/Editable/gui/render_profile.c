@@ -0,0 +1,239 @@
+/*
+ * render_profile.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "render_profile.h"
+#include "../timing/cycles.h"
+#include "../timing/timebase.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include <string.h>
+
+static uint16_t histograms[RENDER_PROFILE_SERIES][RENDER_PROFILE_BUCKETS];
+static uint16_t snapshot[RENDER_PROFILE_SERIES][RENDER_PROFILE_BUCKETS];
+static uint16_t sequence;
+static uint32_t last_encode_us;
+
+static uint32_t refresh_start;
+static uint32_t render_start;
+static bool refreshing;
+
+// the draw functions of the first display attached, every display here uses
+// the same draw context
+static void (*draw_rect)(lv_draw_ctx_t*, const lv_draw_rect_dsc_t*,
+		const lv_area_t*);
+static void (*draw_arc)(lv_draw_ctx_t*, const lv_draw_arc_dsc_t*,
+		const lv_point_t*, uint16_t, uint16_t, uint16_t);
+static void (*draw_letter)(lv_draw_ctx_t*, const lv_draw_label_dsc_t*,
+		const lv_point_t*, uint32_t);
+static void (*draw_img_decoded)(lv_draw_ctx_t*, const lv_draw_img_dsc_t*,
+		const lv_area_t*, const uint8_t*, lv_img_cf_t);
+static void (*draw_line)(lv_draw_ctx_t*, const lv_draw_line_dsc_t*,
+		const lv_point_t*, const lv_point_t*);
+
+static uint8_t bucket_of(uint32_t value) {
+	if (value < 4) {
+		return (uint8_t) value;
+	}
+
+	// octave of the value, then its next two bits
+	uint32_t octave = 31 - (uint32_t) __builtin_clz(value);
+
+	return (uint8_t) (4 + (octave - 2) * 4 + ((value >> (octave - 2)) & 3));
+}
+
+void render_profile_record(render_profile_series_t series, uint32_t value) {
+	uint16_t *count = &histograms[series][bucket_of(value)];
+
+	if (*count != UINT16_MAX) {
+		(*count)++;
+	}
+}
+
+static void profile_draw_rect(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_rect_dsc_t *dsc, const lv_area_t *coords) {
+	uint32_t start = cycles_now();
+
+	draw_rect(draw_ctx, dsc, coords);
+	render_profile_record(RENDER_PROFILE_DRAW_RECT, cycles_now() - start);
+}
+
+static void profile_draw_arc(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_arc_dsc_t *dsc, const lv_point_t *center, uint16_t radius,
+		uint16_t start_angle, uint16_t end_angle) {
+	uint32_t start = cycles_now();
+
+	draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle);
+	render_profile_record(RENDER_PROFILE_DRAW_ARC, cycles_now() - start);
+}
+
+static void profile_draw_letter(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_label_dsc_t *dsc, const lv_point_t *pos, uint32_t letter) {
+	uint32_t start = cycles_now();
+
+	draw_letter(draw_ctx, dsc, pos, letter);
+	render_profile_record(RENDER_PROFILE_DRAW_LETTER, cycles_now() - start);
+}
+
+static void profile_draw_img_decoded(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_img_dsc_t *dsc, const lv_area_t *coords,
+		const uint8_t *map, lv_img_cf_t cf) {
+	uint32_t start = cycles_now();
+
+	draw_img_decoded(draw_ctx, dsc, coords, map, cf);
+	render_profile_record(RENDER_PROFILE_DRAW_IMG, cycles_now() - start);
+}
+
+static void profile_draw_line(lv_draw_ctx_t *draw_ctx,
+		const lv_draw_line_dsc_t *dsc, const lv_point_t *point1,
+		const lv_point_t *point2) {
+	uint32_t start = cycles_now();
+
+	draw_line(draw_ctx, dsc, point1, point2);
+	render_profile_record(RENDER_PROFILE_DRAW_LINE, cycles_now() - start);
+}
+
+// everything before it in the refresh is layout, area joining and syncing
+static void profile_render_start(lv_disp_drv_t *drv) {
+	lv_disp_t *disp = _lv_refr_get_disp_refreshing();
+	uint32_t areas = 0;
+
+	render_start = cycles_now();
+
+	// lv_refr_now() refreshes outside the timer, without a start time
+	if (!refreshing) {
+		return;
+	}
+	render_profile_record(RENDER_PROFILE_LAYOUT, render_start - refresh_start);
+	for (uint16_t i = 0; i < disp->inv_p; i++) {
+		if (!disp->inv_area_joined[i]) {
+			areas++;
+		}
+	}
+	render_profile_record(RENDER_PROFILE_AREAS, areas);
+}
+
+void render_profile_attach(lv_disp_drv_t *drv) {
+	lv_draw_ctx_t *ctx = drv->draw_ctx;
+
+	// needed from the first refresh on
+	cycles_init();
+
+	if (draw_rect == NULL) {
+		draw_rect = ctx->draw_rect;
+		draw_arc = ctx->draw_arc;
+		draw_letter = ctx->draw_letter;
+		draw_img_decoded = ctx->draw_img_decoded;
+		draw_line = ctx->draw_line;
+	}
+	if (ctx->draw_rect == draw_rect) {
+		ctx->draw_rect = profile_draw_rect;
+		ctx->draw_arc = profile_draw_arc;
+		ctx->draw_letter = profile_draw_letter;
+		ctx->draw_img_decoded = profile_draw_img_decoded;
+		ctx->draw_line = profile_draw_line;
+	}
+	drv->render_start_cb = profile_render_start;
+}
+
+void render_profile_refresh_begin(void) {
+	refreshing = true;
+	refresh_start = cycles_now();
+}
+
+void render_profile_refresh_end(uint32_t px) {
+	refreshing = false;
+
+	// nothing was invalidated, there was no rendering
+	if (px == 0) {
+		return;
+	}
+	render_profile_record(RENDER_PROFILE_RENDER, cycles_now() - render_start);
+	render_profile_record(RENDER_PROFILE_PX, px);
+}
+
+void render_profile_record_flush(uint32_t cycles) {
+	render_profile_record(RENDER_PROFILE_FLUSH, cycles);
+}
+
+void render_profile_record_flush_wait(uint32_t cycles) {
+	render_profile_record(RENDER_PROFILE_FLUSH_WAIT, cycles);
+}
+
+static uint8_t* put_u16(uint8_t *p, uint16_t value) {
+	p[0] = (uint8_t) value;
+	p[1] = (uint8_t) (value >> 8);
+	return p + 2;
+}
+
+static uint8_t* put_u32(uint8_t *p, uint32_t value) {
+	p = put_u16(p, (uint16_t) value);
+	return put_u16(p, (uint16_t) (value >> 16));
+}
+
+// CRC-16/CCITT-FALSE, bitwise, a record a second does not need a table
+static uint16_t crc16(const uint8_t *data, size_t length) {
+	uint16_t crc = 0xFFFF;
+
+	while (length--) {
+		crc ^= (uint16_t) (*data++ << 8);
+		for (uint8_t bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ?
+					(uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+		}
+	}
+	return crc;
+}
+
+size_t render_profile_encode(uint8_t *buf, size_t size) {
+	uint32_t now_us = timebase_us();
+	uint8_t *p = buf + 6;
+	uint8_t series = 0;
+
+	if (size < RENDER_PROFILE_RECORD_MAX) {
+		return 0;
+	}
+
+	// the flush series is written from interrupts
+	taskENTER_CRITICAL();
+	memcpy(snapshot, histograms, sizeof(snapshot));
+	memset(histograms, 0, sizeof(histograms));
+	taskEXIT_CRITICAL();
+
+	p = put_u16(p, sequence++);
+	p = put_u32(p, cycles_hz());
+	p = put_u32(p, now_us - last_encode_us);
+	last_encode_us = now_us;
+
+	for (uint8_t id = 0; id < RENDER_PROFILE_SERIES; id++) {
+		uint8_t *entry = p;
+		uint8_t buckets = 0;
+
+		p += 2;
+		for (uint8_t b = 0; b < RENDER_PROFILE_BUCKETS; b++) {
+			if (snapshot[id][b] != 0) {
+				*p++ = b;
+				p = put_u16(p, snapshot[id][b]);
+				buckets++;
+			}
+		}
+		if (buckets == 0) {
+			p = entry;
+			continue;
+		}
+		entry[0] = id;
+		entry[1] = buckets;
+		series++;
+	}
+
+	buf[0] = RENDER_PROFILE_SYNC0;
+	buf[1] = RENDER_PROFILE_SYNC1;
+	buf[2] = RENDER_PROFILE_VERSION;
+	buf[3] = series;
+	put_u16(buf + 4, (uint16_t) (p - (buf + 6)));
+	p = put_u16(p, crc16(buf + 2, (size_t) (p - (buf + 2))));
+
+	return (size_t) (p - buf);
+}
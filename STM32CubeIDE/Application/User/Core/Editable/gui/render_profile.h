@@ -0,0 +1,80 @@
+/*
+ * render_profile.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_RENDER_PROFILE_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_RENDER_PROFILE_H_
+
+#include "lvgl/lvgl.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Where every LVGL refresh spends its time, from the cycle counter, kept as
+ * histograms until the next render_profile_encode(). Buckets are log2 with
+ * four steps per octave, so a value is known to within 25 %. Each series has
+ * one writer, the GUI task or the flush interrupts, and the encoder copies
+ * and clears them in a critical section.
+ *
+ * A record, little endian, as sent on USART1 and read by
+ * Tools/render_profile.py:
+ *
+ *     u8  sync[2]      0xA5 0x5A
+ *     u8  version      RENDER_PROFILE_VERSION
+ *     u8  series       number of series that follow
+ *     u16 length       bytes from sequence up to the CRC
+ *     u16 sequence
+ *     u32 clock_hz     cycle counter rate
+ *     u32 interval_us  since the previous record
+ *     per series with samples:
+ *         u8 id, u8 buckets, buckets x { u8 bucket, u16 count }
+ *     u16 crc          CRC-16/CCITT-FALSE from version up to here
+ */
+
+#define RENDER_PROFILE_VERSION 1
+#define RENDER_PROFILE_SYNC0 0xA5
+#define RENDER_PROFILE_SYNC1 0x5A
+#define RENDER_PROFILE_BUCKETS 124 // up to 2^32
+
+typedef enum {
+	RENDER_PROFILE_HANDLER, // lv_timer_handler() call, cycles
+	RENDER_PROFILE_LAYOUT, // refresh start to drawing: layout, area join, buffer sync
+	RENDER_PROFILE_RENDER, // refr_invalid_areas(), drawing and flushing all areas
+	RENDER_PROFILE_DRAW_RECT, // one draw call, cycles
+	RENDER_PROFILE_DRAW_ARC,
+	RENDER_PROFILE_DRAW_LETTER,
+	RENDER_PROFILE_DRAW_IMG,
+	RENDER_PROFILE_DRAW_LINE,
+	RENDER_PROFILE_FLUSH, // DMA2D copy or page flip, started to done, cycles
+	RENDER_PROFILE_FLUSH_WAIT, // GUI task blocked on the display, cycles
+	RENDER_PROFILE_AREAS, // areas drawn per refresh
+	RENDER_PROFILE_PX, // pixels drawn per refresh
+	RENDER_PROFILE_SERIES
+} render_profile_series_t;
+
+#define RENDER_PROFILE_RECORD_MAX \
+	(16 + RENDER_PROFILE_SERIES * (2 + 3 * RENDER_PROFILE_BUCKETS) + 2)
+
+void render_profile_record(render_profile_series_t series, uint32_t value);
+
+/* Time the draw calls of a registered display and its refreshes */
+void render_profile_attach(lv_disp_drv_t *drv);
+
+/* Around each refresh timer run, px as reported to the monitor callback */
+void render_profile_refresh_begin(void);
+void render_profile_refresh_end(uint32_t px);
+
+/* From the display port, which has no access to the series */
+void render_profile_record_flush(uint32_t cycles);
+void render_profile_record_flush_wait(uint32_t cycles);
+
+/*
+ * Write a record of everything since the previous call into buf and start
+ * over; returns its length, 0 if size is below RENDER_PROFILE_RECORD_MAX
+ */
+size_t render_profile_encode(uint8_t *buf, size_t size);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_RENDER_PROFILE_H_ */
@@ -0,0 +1,56 @@
+/*
+ * scanout.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "scanout.h"
+
+static int32_t active_lines = 480;
+static int32_t total_lines = 500;
+
+void scanout_configure(uint32_t active, uint32_t total) {
+	active_lines = (int32_t) active;
+	total_lines = (int32_t) total;
+}
+
+// lines the beam still has to scan before it reaches line y
+static int32_t lines_until(uint32_t beam, int32_t y) {
+	int32_t lines = (y - (int32_t) beam) % total_lines;
+
+	return lines < 0 ? lines + total_lines : lines;
+}
+
+int32_t scanout_copy_line(uint32_t beam, int32_t y1, int32_t y2) {
+	// behind the beam, or far enough ahead of it
+	if (lines_until(beam, y1) > SCANOUT_GUARD_LINES
+			&& lines_until(beam, y2) >= lines_until(beam, y1)) {
+		return SCANOUT_NOW;
+	}
+
+	// wait until the beam has left the area; an area reaching the bottom
+	// waits for the blanking
+	return y2 + 1 < active_lines ? y2 + 1 : active_lines;
+}
+
+void scanout_order_areas(lv_disp_t *disp, int32_t y_offset, uint32_t beam) {
+	// insertion sort, there are at most LV_INV_BUF_SIZE areas; nothing is
+	// joined yet, the refresh does that, but the flags move with their areas
+	for (uint16_t i = 1; i < disp->inv_p; i++) {
+		lv_area_t area = disp->inv_areas[i];
+		uint8_t joined = disp->inv_area_joined[i];
+		int32_t key = lines_until(beam + SCANOUT_GUARD_LINES,
+				area.y1 + y_offset);
+		uint16_t j = i;
+
+		while (j > 0
+				&& lines_until(beam + SCANOUT_GUARD_LINES,
+						disp->inv_areas[j - 1].y1 + y_offset) > key) {
+			disp->inv_areas[j] = disp->inv_areas[j - 1];
+			disp->inv_area_joined[j] = disp->inv_area_joined[j - 1];
+			j--;
+		}
+		disp->inv_areas[j] = area;
+		disp->inv_area_joined[j] = joined;
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * scanout.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_SCANOUT_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_SCANOUT_H_
+
+#include "lvgl/lvgl.h"
+#include <stdint.h>
+
+/*
+ * Beam racing for DMA2D copies into a framebuffer the LTDC is scanning out.
+ * Positions are LTDC lines counted from the first visible one; the lines
+ * after the last visible one up to the frame total are the blanking.
+ *
+ * An area is copied either entirely behind the beam, or ahead of it with
+ * SCANOUT_GUARD_LINES to spare: DMA2D writes a line in about a third of the
+ * time the LTDC takes to scan one, so a copy that starts ahead stays ahead.
+ * Either way every line of the area changes between two reads of it and no
+ * frame shows half an update.
+ */
+
+// interrupt latency and DMA2D start, in lines of 32.8 us
+#define SCANOUT_GUARD_LINES 4
+
+// scanout_copy_line(): the copy can start straight away
+#define SCANOUT_NOW (-1)
+
+/* Frame geometry: visible lines and lines per frame including blanking */
+void scanout_configure(uint32_t active_lines, uint32_t total_lines);
+
+/*
+ * SCANOUT_NOW when screen lines y1..y2 can be copied with the beam at line
+ * beam, otherwise the line to wait for, the first one after the area
+ */
+int32_t scanout_copy_line(uint32_t beam, int32_t y1, int32_t y2);
+
+/*
+ * Order the display's invalidated areas for the next refresh so they are
+ * drawn, and copied, in the order the beam reaches them, starting just ahead
+ * of it; an area the beam is in goes last. y_offset is the screen line of
+ * the display's first row.
+ */
+void scanout_order_areas(lv_disp_t *disp, int32_t y_offset, uint32_t beam);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_SCANOUT_H_ */
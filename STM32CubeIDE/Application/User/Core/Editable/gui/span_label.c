@@ -0,0 +1,362 @@
+/*
+ * span_label.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "span_label.h"
+#include "label_text.h"
+#include <string.h>
+
+static void span_label_constructor(const lv_obj_class_t *class_p,
+		lv_obj_t *obj);
+static void span_label_event(const lv_obj_class_t *class_p, lv_event_t *e);
+
+const lv_obj_class_t span_label_class = {
+	.constructor_cb = span_label_constructor,
+	.event_cb = span_label_event,
+	.instance_size = sizeof(span_label_t),
+	.base_class = &lv_obj_class
+};
+
+static lv_coord_t line_pitch(lv_obj_t *obj) {
+	return lv_font_get_line_height(lv_obj_get_style_text_font(obj, LV_PART_MAIN))
+			+ lv_obj_get_style_text_line_space(obj, LV_PART_MAIN);
+}
+
+static void measure(lv_obj_t *obj, span_label_segment_t *segment) {
+	segment->w = lv_txt_get_width(segment->text,
+			(uint32_t) strlen(segment->text),
+			lv_obj_get_style_text_font(obj, LV_PART_MAIN),
+			lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN),
+			LV_TEXT_FLAG_NONE);
+}
+
+// the segments of a line side by side, as lv_txt_get_width() would measure
+// their text joined; returns the line's width
+static lv_coord_t place_line(span_label_t *label, uint32_t line) {
+	lv_coord_t space = lv_obj_get_style_text_letter_space(&label->obj,
+			LV_PART_MAIN);
+	lv_coord_t x = 0;
+
+	for (uint32_t i = 0; i < label->count; i++) {
+		span_label_segment_t *segment = &label->segments[i];
+
+		if (segment->line == line) {
+			segment->x = x;
+			x += segment->w + (segment->w > 0 ? space : 0);
+		}
+	}
+	return x > 0 ? x - space : 0;
+}
+
+static lv_coord_t line_width(const span_label_t *label, uint32_t line) {
+	lv_coord_t w = 0;
+
+	for (uint32_t i = 0; i < label->count; i++) {
+		const span_label_segment_t *segment = &label->segments[i];
+
+		if (segment->line == line) {
+			w = LV_MAX(w, segment->x + segment->w);
+		}
+	}
+	return w;
+}
+
+// where a line of width w starts, in the content box, by the text align
+static void line_origin(lv_obj_t *obj, uint32_t line, lv_coord_t w,
+		lv_point_t *origin) {
+	lv_area_t content;
+
+	lv_obj_get_content_coords(obj, &content);
+	origin->x = content.x1;
+	origin->y = content.y1 + (lv_coord_t) line * line_pitch(obj);
+	switch (lv_obj_get_style_text_align(obj, LV_PART_MAIN)) {
+	case LV_TEXT_ALIGN_CENTER:
+		origin->x += (lv_area_get_width(&content) - w) / 2;
+		break;
+	case LV_TEXT_ALIGN_RIGHT:
+		origin->x += lv_area_get_width(&content) - w;
+		break;
+	default:
+		break;
+	}
+}
+
+// a line from x to its end, or all of it unless it is left aligned
+static void invalidate_line(lv_obj_t *obj, uint32_t line, lv_coord_t x) {
+	span_label_t *label = (span_label_t*) obj;
+	lv_coord_t w = line_width(label, line);
+	lv_point_t origin;
+	lv_area_t area;
+
+	if (lv_obj_get_style_text_align(obj, LV_PART_MAIN) != LV_TEXT_ALIGN_LEFT
+			&& lv_obj_get_style_text_align(obj, LV_PART_MAIN)
+					!= LV_TEXT_ALIGN_AUTO) {
+		x = 0;
+	}
+	line_origin(obj, line, w, &origin);
+	area.x1 = origin.x + x;
+	area.x2 = origin.x + w - 1;
+	area.y1 = origin.y;
+	area.y2 = origin.y + line_pitch(obj) - 1;
+	if (area.x2 >= area.x1) {
+		lv_obj_invalidate_area(obj, &area);
+	}
+}
+
+static void invalidate_segment(lv_obj_t *obj, uint32_t i) {
+	span_label_t *label = (span_label_t*) obj;
+	span_label_segment_t *segment = &label->segments[i];
+	lv_point_t origin;
+	lv_area_t area;
+
+	line_origin(obj, segment->line, line_width(label, segment->line), &origin);
+	area.x1 = origin.x + segment->x;
+	area.x2 = area.x1 + segment->w - 1;
+	area.y1 = origin.y;
+	area.y2 = origin.y + line_pitch(obj) - 1;
+	if (segment->w > 0) {
+		lv_obj_invalidate_area(obj, &area);
+	}
+}
+
+// a segment's new text, measured; only what moved is redrawn
+static void text_changed(lv_obj_t *obj, uint32_t i) {
+	span_label_t *label = (span_label_t*) obj;
+	span_label_segment_t *segment = &label->segments[i];
+	lv_coord_t old_w = segment->w;
+
+	measure(obj, segment);
+	if (segment->w == old_w) {
+		invalidate_segment(obj, i);
+		return;
+	}
+
+	// the line as it was from here on, then as it is
+	lv_coord_t w = segment->w;
+	segment->w = old_w;
+	invalidate_line(obj, segment->line, segment->x);
+	segment->w = w;
+	place_line(label, segment->line);
+	invalidate_line(obj, segment->line, segment->x);
+	lv_obj_refresh_self_size(obj);
+}
+
+static void draw(lv_event_t *e) {
+	lv_obj_t *obj = lv_event_get_target(e);
+	span_label_t *label = (span_label_t*) obj;
+	lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+	const lv_area_t *clip_area = draw_ctx->clip_area;
+	lv_draw_label_dsc_t dsc;
+	lv_area_t content;
+	lv_area_t clip;
+
+	lv_obj_get_content_coords(obj, &content);
+	if (!_lv_area_intersect(&clip, &content, clip_area)) {
+		return;
+	}
+	lv_draw_label_dsc_init(&dsc);
+	lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+	if (dsc.opa <= LV_OPA_MIN) {
+		return;
+	}
+	lv_color_t color = dsc.color;
+	lv_coord_t pitch = line_pitch(obj);
+	lv_coord_t w = 0;
+	lv_point_t origin = { 0, 0 };
+	int32_t line = -1;
+
+	dsc.align = LV_TEXT_ALIGN_LEFT;
+	draw_ctx->clip_area = &clip;
+	for (uint32_t i = 0; i < label->count; i++) {
+		const span_label_segment_t *segment = &label->segments[i];
+		lv_area_t area;
+
+		if (segment->line != line) {
+			line = segment->line;
+			w = line_width(label, (uint32_t) line);
+			line_origin(obj, (uint32_t) line, w, &origin);
+		}
+		area.x1 = origin.x + segment->x;
+		area.x2 = area.x1 + segment->w - 1;
+		area.y1 = origin.y;
+		area.y2 = origin.y + pitch - 1;
+		if (segment->w > 0 && _lv_area_is_on(&area, &clip)) {
+			dsc.color = segment->own_color ? segment->color : color;
+			lv_draw_label(draw_ctx, &dsc, &area, segment->text, NULL);
+		}
+	}
+	draw_ctx->clip_area = clip_area;
+}
+
+static void span_label_event(const lv_obj_class_t *class_p, lv_event_t *e) {
+	LV_UNUSED(class_p);
+
+	if (lv_obj_event_base(&span_label_class, e) != LV_RES_OK) {
+		return;
+	}
+
+	lv_obj_t *obj = lv_event_get_target(e);
+	span_label_t *label = (span_label_t*) obj;
+
+	switch (lv_event_get_code(e)) {
+	case LV_EVENT_DRAW_MAIN:
+		draw(e);
+		break;
+	case LV_EVENT_GET_SELF_SIZE: {
+		lv_point_t *size = lv_event_get_param(e);
+		uint32_t lines = label->count > 0 ?
+				label->segments[label->count - 1].line + 1U : 0U;
+		lv_coord_t w = 0;
+
+		for (uint32_t line = 0; line < lines; line++) {
+			w = LV_MAX(w, line_width(label, line));
+		}
+		size->x = LV_MAX(size->x, w);
+		size->y = LV_MAX(size->y, lines == 0 ? 0 : (lv_coord_t) lines
+				* line_pitch(obj)
+				- lv_obj_get_style_text_line_space(obj, LV_PART_MAIN));
+		break;
+	}
+	case LV_EVENT_STYLE_CHANGED:
+		for (uint32_t i = 0; i < label->count; i++) {
+			measure(obj, &label->segments[i]);
+		}
+		for (uint32_t line = 0; line < label->next_line + 1U; line++) {
+			place_line(label, line);
+		}
+		lv_obj_refresh_self_size(obj);
+		break;
+	default:
+		break;
+	}
+}
+
+static void span_label_constructor(const lv_obj_class_t *class_p,
+		lv_obj_t *obj) {
+	LV_UNUSED(class_p);
+	span_label_t *label = (span_label_t*) obj;
+
+	label->count = 0;
+	label->next_line = 0;
+	lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+	lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+}
+
+lv_obj_t* span_label_create(lv_obj_t *parent) {
+	lv_obj_t *obj = lv_obj_class_create_obj(&span_label_class, parent);
+	lv_obj_class_init_obj(obj);
+	return obj;
+}
+
+uint32_t span_label_add(lv_obj_t *obj, const char *text) {
+	span_label_t *label = (span_label_t*) obj;
+
+	if (label->count == SPAN_LABEL_SEGMENTS) {
+		return SPAN_LABEL_SEGMENTS;
+	}
+
+	uint32_t i = label->count++;
+	span_label_segment_t *segment = &label->segments[i];
+
+	segment->text = text;
+	segment->w = 0;
+	segment->x = 0;
+	segment->line = label->next_line;
+	segment->own_color = false;
+	segment->text_buf[0] = '\0';
+	text_changed(obj, i);
+	return i;
+}
+
+void span_label_new_line(lv_obj_t *obj) {
+	((span_label_t*) obj)->next_line++;
+}
+
+void span_label_set_text(lv_obj_t *obj, uint32_t segment, const char *text) {
+	span_label_t *label = (span_label_t*) obj;
+
+	if (segment >= label->count || label->segments[segment].text == text) {
+		return;
+	}
+
+	bool same = strcmp(label->segments[segment].text, text) == 0;
+	label->segments[segment].text = text;
+	if (!same) {
+		text_changed(obj, segment);
+	}
+}
+
+// the segment's own text, if it changed
+static void set_own_text(lv_obj_t *obj, uint32_t i, const char *text) {
+	span_label_segment_t *segment = &((span_label_t*) obj)->segments[i];
+
+	if (segment->text == segment->text_buf
+			&& strcmp(segment->text_buf, text) == 0) {
+		return;
+	}
+	strcpy(segment->text_buf, text);
+	segment->text = segment->text_buf;
+	text_changed(obj, i);
+}
+
+// a formatted number and units into text, cut to fit
+static void number_text(char *text, char *end, const char *units) {
+	size_t n = units != NULL ? strlen(units) : 0;
+	size_t room = SPAN_LABEL_TEXT_BYTES - 1U - (size_t) (end - text);
+
+	n = LV_MIN(n, room);
+	if (n > 0) {
+		memcpy(end, units, n);
+	}
+	end[n] = '\0';
+}
+
+void span_label_set_int(lv_obj_t *obj, uint32_t segment, int32_t value,
+		const char *units) {
+	char text[LABEL_TEXT_NUMBER_MAX + SPAN_LABEL_TEXT_BYTES];
+
+	if (segment < ((span_label_t*) obj)->count) {
+		number_text(text, label_text_format_int(text, value), units);
+		set_own_text(obj, segment, text);
+	}
+}
+
+void span_label_set_fixed(lv_obj_t *obj, uint32_t segment, int32_t scaled,
+		uint32_t decimals, const char *units) {
+	char text[LABEL_TEXT_NUMBER_MAX + SPAN_LABEL_TEXT_BYTES];
+
+	if (segment < ((span_label_t*) obj)->count) {
+		number_text(text, label_text_format_fixed(text, scaled, decimals),
+				units);
+		set_own_text(obj, segment, text);
+	}
+}
+
+void span_label_set_float(lv_obj_t *obj, uint32_t segment, float value,
+		uint32_t decimals, const char *units) {
+	char text[LABEL_TEXT_NUMBER_MAX + SPAN_LABEL_TEXT_BYTES];
+
+	if (segment < ((span_label_t*) obj)->count) {
+		number_text(text, label_text_format_float(text, value, decimals),
+				units);
+		set_own_text(obj, segment, text);
+	}
+}
+
+void span_label_set_color(lv_obj_t *obj, uint32_t segment, lv_color_t color) {
+	span_label_t *label = (span_label_t*) obj;
+
+	if (segment >= label->count) {
+		return;
+	}
+
+	span_label_segment_t *s = &label->segments[segment];
+	if (s->own_color && s->color.full == color.full) {
+		return;
+	}
+	s->own_color = true;
+	s->color = color;
+	invalidate_segment(obj, segment);
+}
@@ -0,0 +1,77 @@
+/*
+ * span_label.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_GUI_SPAN_LABEL_H_
+#define APPLICATION_USER_CORE_EDITABLE_GUI_SPAN_LABEL_H_
+
+#include "lvgl/lvgl.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * A label of coloured segments, like an lv_spangroup's spans, in place of a
+ * recoloured lv_label's "#RRGGBB text#" commands. Each segment keeps its
+ * text, its colour and its measured width. A colour change is a field set
+ * and the segment's box invalidated; new text re-measures that segment
+ * alone, and redraws it, or the rest of its line when its width changed.
+ * Nothing is parsed when drawing or sizing, and segments are laid out from
+ * the cached widths, unlike lv_spangroup, which lays out every span on every
+ * draw and redraws the whole group for any change.
+ *
+ * Segments run left to right, a new line starting after
+ * span_label_new_line(). Styles are LV_PART_MAIN's: the font, letter and
+ * line space and text align for every segment, and the text colour for
+ * those not given one. The object sizes itself to its content unless given
+ * a size.
+ */
+
+#define SPAN_LABEL_SEGMENTS 8U
+#define SPAN_LABEL_TEXT_BYTES 16U // a segment's own text, a number and units
+
+typedef struct {
+	const char *text; // text_buf, or the caller's, not copied
+	lv_coord_t w;
+	lv_coord_t x; // from the start of its line
+	uint8_t line;
+	bool own_color; // else the style's
+	lv_color_t color;
+	char text_buf[SPAN_LABEL_TEXT_BYTES];
+} span_label_segment_t;
+
+typedef struct {
+	lv_obj_t obj;
+	uint8_t count;
+	uint8_t next_line; // the next segment's
+	span_label_segment_t segments[SPAN_LABEL_SEGMENTS];
+} span_label_t;
+
+extern const lv_obj_class_t span_label_class;
+
+lv_obj_t* span_label_create(lv_obj_t *parent);
+
+/* A segment after the last, showing text, which must stay valid; its index,
+ * or SPAN_LABEL_SEGMENTS when there is no room */
+uint32_t span_label_add(lv_obj_t *obj, const char *text);
+
+/* The next segment starts a new line */
+void span_label_new_line(lv_obj_t *obj);
+
+/* text must stay valid */
+void span_label_set_text(lv_obj_t *obj, uint32_t segment, const char *text);
+
+/* A number and units in the segment's own text, as gui/label_text.h formats
+ * them, cut to SPAN_LABEL_TEXT_BYTES */
+void span_label_set_int(lv_obj_t *obj, uint32_t segment, int32_t value,
+		const char *units);
+void span_label_set_fixed(lv_obj_t *obj, uint32_t segment, int32_t scaled,
+		uint32_t decimals, const char *units);
+void span_label_set_float(lv_obj_t *obj, uint32_t segment, float value,
+		uint32_t decimals, const char *units);
+
+void span_label_set_color(lv_obj_t *obj, uint32_t segment, lv_color_t color);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_GUI_SPAN_LABEL_H_ */
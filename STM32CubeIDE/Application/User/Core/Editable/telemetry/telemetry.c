@@ -0,0 +1,94 @@
+/*
+ * telemetry.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "telemetry.h"
+#include <string.h>
+
+inv_t inv1 = { 0 };
+inv_t inv2 = { 0 };
+battery_t battery = { 0 };
+vcu_t vcu = { 0 };
+uint32_t signal_rx_us[CAN_DB_SIGNAL_COUNT];
+
+_Static_assert(CAN_DB_MESSAGE_COUNT <= 24,
+		"dirty groups need one bit per CAN message");
+
+// odd while a write is in progress
+static uint32_t telemetry_seq;
+
+static uint32_t telemetry_dirty;
+
+void telemetry_write_begin(void) {
+	__atomic_store_n(&telemetry_seq, telemetry_seq + 1, __ATOMIC_RELAXED);
+	// the odd sequence number must be visible before any field changes
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+void telemetry_write_end(void) {
+	__atomic_store_n(&telemetry_seq, telemetry_seq + 1, __ATOMIC_RELEASE);
+}
+
+void telemetry_mark_dirty(uint32_t message_index) {
+	__atomic_fetch_or(&telemetry_dirty, 1U << message_index, __ATOMIC_RELAXED);
+}
+
+uint32_t telemetry_take_dirty(void) {
+	return __atomic_exchange_n(&telemetry_dirty, 0, __ATOMIC_ACQUIRE);
+}
+
+void telemetry_snapshot(telemetry_t *snapshot) {
+	uint32_t start;
+
+	do {
+		start = __atomic_load_n(&telemetry_seq, __ATOMIC_ACQUIRE);
+
+		snapshot->inv1 = inv1;
+		snapshot->inv2 = inv2;
+		snapshot->battery = battery;
+		snapshot->vcu = vcu;
+		memcpy(snapshot->signal_rx_us, signal_rx_us, sizeof(signal_rx_us));
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	} while ((start & 1) != 0
+			|| start != __atomic_load_n(&telemetry_seq, __ATOMIC_RELAXED));
+}
+
+uint32_t telemetry_update_stale(telemetry_t *snapshot, uint32_t now_us) {
+	const uint32_t *rx_us = snapshot->signal_rx_us;
+	const uint32_t *timeouts_us = can_db.timeouts_us;
+	uint8_t *stale = snapshot->stale;
+	uint8_t flipped[CAN_DB_SIGNAL_COUNT];
+	uint32_t count = 0;
+	uint8_t changed = 0;
+
+	// one branchless pass over the flat arrays, no per-widget checks
+	for (uint32_t i = 0; i < CAN_DB_SIGNAL_COUNT; i++) {
+		uint8_t s = (uint8_t) ((now_us - rx_us[i] > timeouts_us[i])
+				| (rx_us[i] == 0));
+		flipped[i] = stale[i] ^ s;
+		changed |= flipped[i];
+		stale[i] = s;
+		count += s;
+	}
+
+	snapshot->stale_count = count;
+	if (!changed) {
+		return 0;
+	}
+
+	// rare: find the messages whose signals flipped
+	uint32_t groups = 0;
+	for (uint32_t m = 0; m < CAN_DB_MESSAGE_COUNT; m++) {
+		const can_message_t *msg = &can_db.messages[m];
+		for (uint32_t i = 0; i < msg->signal_count; i++) {
+			if (flipped[msg->first_signal + i]) {
+				groups |= 1U << m;
+				break;
+			}
+		}
+	}
+	return groups;
+}
@@ -0,0 +1,55 @@
+/*
+ * telemetry.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_TELEMETRY_TELEMETRY_H_
+#define APPLICATION_USER_CORE_EDITABLE_TELEMETRY_TELEMETRY_H_
+
+#include "../dashboard.h"
+
+/*
+ * Live telemetry, written only by the CAN decoder task inside a
+ * telemetry_write_begin()/telemetry_write_end() pair. Everyone else reads a
+ * consistent copy with telemetry_snapshot() - never read these directly.
+ *
+ * Publication uses a sequence lock: the writer never blocks, and a reader
+ * that raced with a write simply copies again. The writer must not run at a
+ * lower priority than any reader.
+ */
+extern inv_t inv1;
+extern inv_t inv2;
+extern battery_t battery;
+extern vcu_t vcu;
+extern uint32_t signal_rx_us[CAN_DB_SIGNAL_COUNT];
+
+/*
+ * Dirty groups: one bit per CAN database message, set by the decoder for
+ * every message it decodes and collected by the GUI so it only redraws the
+ * widgets showing something that changed. The top bits are left for GUI
+ * events that are not CAN messages.
+ */
+#define TELEMETRY_GROUP(message) (1U << CAN_DB_##message##_MESSAGE)
+#define TELEMETRY_GROUPS_ALL 0xFFFFFFFFU
+
+void telemetry_write_begin(void);
+void telemetry_write_end(void);
+
+/* Writer side, inside a write section: mark a message as updated */
+void telemetry_mark_dirty(uint32_t message_index);
+
+/* Reader side: fetch and clear the dirty groups. Call before
+ * telemetry_snapshot() so an update racing with it is seen next time. */
+uint32_t telemetry_take_dirty(void);
+
+void telemetry_snapshot(telemetry_t *snapshot);
+
+/* Recompute snapshot->stale from the signal timestamps and the CAN database
+ * timeouts. Returns the dirty groups of the messages whose signals went stale
+ * or fresh again. Ages are 32-bit, so a signal lost for longer than ~71
+ * minutes briefly reads as fresh once per wrap. */
+uint32_t telemetry_update_stale(telemetry_t *snapshot, uint32_t now_us);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_TELEMETRY_TELEMETRY_H_ */
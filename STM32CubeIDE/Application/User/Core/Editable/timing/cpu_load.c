@@ -0,0 +1,25 @@
+/*
+ * cpu_load.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "cpu_load.h"
+#include "timebase.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+uint32_t cpu_idle_permille(cpu_load_window_t *window) {
+	uint32_t idle_us = (uint32_t) ulTaskGetIdleRunTimeCounter();
+	uint32_t now_us = timebase_us();
+	uint32_t idle = idle_us - window->idle_us;
+	uint32_t elapsed = now_us - window->time_us;
+
+	window->idle_us = idle_us;
+	window->time_us = now_us;
+
+	if (elapsed == 0) {
+		return 0;
+	}
+	return (uint32_t) ((uint64_t) idle * 1000U / elapsed);
+}
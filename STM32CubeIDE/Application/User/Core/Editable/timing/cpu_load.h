@@ -0,0 +1,27 @@
+/*
+ * cpu_load.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_TIMING_CPU_LOAD_H_
+#define APPLICATION_USER_CORE_EDITABLE_TIMING_CPU_LOAD_H_
+
+#include <stdint.h>
+
+/*
+ * Idle task share of the CPU from the FreeRTOS run time statistics, which
+ * count in timebase_us() microseconds (see FreeRTOSConfig.h). Each reader
+ * keeps its own window so readers at different rates do not disturb each
+ * other.
+ */
+typedef struct {
+	uint32_t idle_us; // idle task run time at the previous call
+	uint32_t time_us; // timebase_us() at the previous call
+} cpu_load_window_t;
+
+/* Idle time in 0.1 % since the previous call with the same window */
+uint32_t cpu_idle_permille(cpu_load_window_t *window);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_TIMING_CPU_LOAD_H_ */
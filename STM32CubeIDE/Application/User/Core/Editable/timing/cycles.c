@@ -0,0 +1,22 @@
+/*
+ * cycles.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "cycles.h"
+#include "main.h"
+
+void cycles_init(void) {
+	DCB->DEMCR |= DCB_DEMCR_TRCENA_Msk;
+	DWT->CYCCNT = 0;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+uint32_t cycles_now(void) {
+	return DWT->CYCCNT;
+}
+
+uint32_t cycles_hz(void) {
+	return SystemCoreClock;
+}
@@ -0,0 +1,26 @@
+/*
+ * cycles.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_TIMING_CYCLES_H_
+#define APPLICATION_USER_CORE_EDITABLE_TIMING_CYCLES_H_
+
+#include <stdint.h>
+
+/*
+ * Core clock cycle counter (DWT CYCCNT) for timing code paths shorter than
+ * timebase_us() resolves. Wraps every ~27 s at 160 MHz, so only take
+ * differences of nearby readings. Safe to call from tasks and ISRs once
+ * cycles_init() has run.
+ */
+void cycles_init(void);
+
+uint32_t cycles_now(void);
+
+/* Counter rate in Hz, the core clock */
+uint32_t cycles_hz(void);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_TIMING_CYCLES_H_ */
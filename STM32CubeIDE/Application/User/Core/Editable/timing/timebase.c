@@ -0,0 +1,27 @@
+/*
+ * timebase.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "timebase.h"
+#include "main.h"
+
+uint32_t timebase_us(void) {
+	uint32_t ms;
+	uint32_t cnt;
+	uint32_t pending;
+
+	do {
+		ms = HAL_GetTick();
+		cnt = TIM2->CNT;
+		pending = TIM2->SR & TIM_SR_UIF;
+	} while (ms != HAL_GetTick());
+
+	// the counter wrapped but the (lowest priority) tick ISR has not run yet
+	if (pending && cnt < 500) {
+		ms++;
+	}
+
+	return ms * 1000u + cnt;
+}
@@ -0,0 +1,20 @@
+/*
+ * timebase.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef APPLICATION_USER_CORE_EDITABLE_TIMING_TIMEBASE_H_
+#define APPLICATION_USER_CORE_EDITABLE_TIMING_TIMEBASE_H_
+
+#include <stdint.h>
+
+/*
+ * Free-running microsecond clock built from the HAL tick (TIM2, 1 kHz) and
+ * the TIM2 counter (1 MHz). Wraps every ~71 minutes, so always compare
+ * timestamps with unsigned subtraction. Safe to call from tasks and ISRs.
+ */
+uint32_t timebase_us(void);
+
+#endif /* APPLICATION_USER_CORE_EDITABLE_TIMING_TIMEBASE_H_ */
@@ -0,0 +1,322 @@
+#!/usr/bin/env python3
+"""
+Generate the dashboard's CAN decode tables from a DBC file.
+
+    python3 Tools/dbc2c.py STM32CubeIDE/Application/User/Core/Editable/fdcan/our5.dbc
+
+writes can_db.h and can_db.c next to the DBC file; with --check it writes
+nothing and fails if they differ from what it would write, which the
+firmware build runs as its pre-build step. Signal names must be
+<struct>_<field> (e.g. inv1_motor_speed); each signal is decoded straight
+into that telemetry field, whose C type selects how the value is stored.
+Multiplexed signals are not supported. Messages may be CAN FD frames of
+up to 64 bytes. Extended IDs are looked up on their low 25 bits, as
+CAN_KEY() does, so no two messages may differ only in the priority bits.
+
+A signal is stale once it has not been received for its timeout: the
+GenSigTimeoutTime attribute of the signal if set, otherwise
+CYCLE_TIMEOUT_FACTOR times the GenMsgCycleTime of its message, otherwise the
+GenSigTimeoutTime default. All times are in ms.
+"""
+
+import argparse
+import os
+import re
+import sys
+
+BO_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s+(\w+)')
+SG_RE = re.compile(
+    r'^SG_\s+(\w+)\s*(\S+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+    r'\(([^,]+),([^)]+)\)\s*\[([^|]*)\|([^\]]*)\]\s*"([^"]*)"')
+
+BA_DEF_DEF_RE = re.compile(r'^BA_DEF_DEF_\s+"(\w+)"\s+(\d+)\s*;')
+BA_BO_RE = re.compile(r'^BA_\s+"(\w+)"\s+BO_\s+(\d+)\s+(\d+)\s*;')
+BA_SG_RE = re.compile(r'^BA_\s+"(\w+)"\s+SG_\s+(\d+)\s+(\w+)\s+(\d+)\s*;')
+
+CAN_KEY_EXTENDED = 0x80000000
+CAN_EXT_MATCH_MASK = 0x01FFFFFF
+MAX_WINDOW_BITS = 64
+FRAME_LENGTHS = (0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64)
+CYCLE_TIMEOUT_FACTOR = 5
+DEFAULT_TIMEOUT_MS = 500
+
+
+class Signal:
+    def __init__(self, name, start, length, little_endian, signed, scale,
+                 offset):
+        self.name = name
+        self.start = start
+        self.length = length
+        self.little_endian = little_endian
+        self.signed = signed
+        self.scale = scale
+        self.offset = offset
+        self.timeout_ms = None
+
+    def dest(self):
+        struct, sep, field = self.name.partition('_')
+        if not sep or not field:
+            raise ValueError('signal %s is not named <struct>_<field>'
+                             % self.name)
+        return '%s.%s' % (struct, field)
+
+    def window(self):
+        """Byte offset and shift of the signal in a 64-bit load window."""
+        if self.little_endian:
+            byte_offset = self.start // 8
+            shift = self.start % 8
+            top = shift + self.length
+        else:
+            # Motorola: start bit is the MSB, the window is loaded big-endian
+            byte_offset = self.start // 8
+            shift = 56 + self.start % 8 - (self.length - 1)
+            top = 56 + self.start % 8 + 1
+            if shift < 0:
+                raise ValueError('signal %s is too long' % self.name)
+        if top > MAX_WINDOW_BITS:
+            raise ValueError('signal %s does not fit a 64-bit window'
+                             % self.name)
+        return byte_offset, shift
+
+    def end_byte(self):
+        """One past the last payload byte the signal occupies."""
+        if self.little_endian:
+            return (self.start + self.length - 1) // 8 + 1
+        # Motorola bits run towards lower bit numbers within a byte and on
+        # into the following bytes
+        msb = (self.start // 8) * 8 + 7 - self.start % 8
+        return (msb + self.length - 1) // 8 + 1
+
+
+class Message:
+    def __init__(self, frame_id, name, length):
+        self.extended = bool(frame_id & CAN_KEY_EXTENDED)
+        self.id = frame_id & 0x1FFFFFFF
+        self.name = name
+        self.length = length
+        self.signals = []
+        self.cycle_time_ms = None
+
+    @property
+    def key(self):
+        """The message's CAN_KEY()."""
+        if self.extended:
+            return (self.id & CAN_EXT_MATCH_MASK) | CAN_KEY_EXTENDED
+        return self.id
+
+
+def parse_dbc(path):
+    messages = []
+    current = None
+    defaults = {}
+    attributes = []
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line in f:
+            line = line.strip()
+            m = BO_RE.match(line)
+            if m:
+                current = Message(int(m.group(1)), m.group(2),
+                                  int(m.group(3)))
+                messages.append(current)
+                continue
+            m = SG_RE.match(line)
+            if m:
+                if current is None:
+                    raise ValueError('signal outside of a message: ' + line)
+                if m.group(2):
+                    raise ValueError('multiplexed signal %s not supported'
+                                     % m.group(1))
+                current.signals.append(Signal(
+                    name=m.group(1),
+                    start=int(m.group(3)),
+                    length=int(m.group(4)),
+                    little_endian=m.group(5) == '1',
+                    signed=m.group(6) == '-',
+                    scale=float(m.group(7)),
+                    offset=float(m.group(8))))
+                continue
+            m = BA_DEF_DEF_RE.match(line)
+            if m:
+                defaults[m.group(1)] = int(m.group(2))
+                continue
+            m = BA_BO_RE.match(line) or BA_SG_RE.match(line)
+            if m:
+                attributes.append(m.groups())
+                continue
+
+    by_id = {m.id | (CAN_KEY_EXTENDED if m.extended else 0): m
+             for m in messages}
+    for attr in attributes:
+        message = by_id.get(int(attr[1]))
+        if message is None:
+            raise ValueError('attribute %s of unknown message %s'
+                             % (attr[0], attr[1]))
+        if attr[0] == 'GenMsgCycleTime' and len(attr) == 3:
+            message.cycle_time_ms = int(attr[2])
+        elif attr[0] == 'GenSigTimeoutTime' and len(attr) == 4:
+            signal = next((s for s in message.signals if s.name == attr[2]),
+                          None)
+            if signal is None:
+                raise ValueError('attribute %s of unknown signal %s'
+                                 % (attr[0], attr[2]))
+            signal.timeout_ms = int(attr[3])
+
+    default_timeout = defaults.get('GenSigTimeoutTime', DEFAULT_TIMEOUT_MS)
+    for message in messages:
+        if message.length not in FRAME_LENGTHS:
+            raise ValueError('message %s has length %d, not a CAN FD size'
+                             % (message.name, message.length))
+        for signal in message.signals:
+            if signal.end_byte() > message.length:
+                raise ValueError('signal %s runs past the end of %s'
+                                 % (signal.name, message.name))
+
+    for message in messages:
+        for signal in message.signals:
+            if signal.timeout_ms is not None:
+                continue
+            if message.cycle_time_ms:
+                signal.timeout_ms = CYCLE_TIMEOUT_FACTOR * message.cycle_time_ms
+            else:
+                signal.timeout_ms = default_timeout
+
+    # messages without signals cost a lookup but decode nothing
+    decoded = sorted((m for m in messages if m.signals), key=lambda m: m.key)
+    for a, b in zip(decoded, decoded[1:]):
+        if a.key == b.key:
+            raise ValueError('messages %s and %s have the same key 0x%08x'
+                             % (a.name, b.name, a.key))
+    return decoded
+
+
+def c_float(value):
+    text = repr(float(value))
+    if 'e' not in text and '.' not in text:
+        text += '.0'
+    return text + 'f'
+
+
+def macro_name(name):
+    return re.sub(r'[^A-Z0-9]', '_', name.upper())
+
+
+def generate(messages, dbc_name, guard):
+    banner = '/* Generated by Tools/dbc2c.py from %s - do not edit */\n' \
+        % dbc_name
+    signal_count = sum(len(m.signals) for m in messages)
+
+    h = [banner, '#ifndef %s' % guard, '#define %s' % guard, '',
+         '#include "can_decode.h"', '',
+         '#define CAN_DB_MESSAGE_COUNT %d' % len(messages),
+         '#define CAN_DB_SIGNAL_COUNT %d' % signal_count, '',
+         '// Lookup keys of the decoded messages, see CAN_KEY()']
+    for m in messages:
+        h.append('#define CAN_DB_%s_KEY 0x%08xU' % (macro_name(m.name), m.key))
+    h += ['', '// Message indices, e.g. for telemetry dirty groups']
+    for index, m in enumerate(messages):
+        h.append('#define CAN_DB_%s_MESSAGE %d' % (macro_name(m.name), index))
+    h += ['', '// Signal indices, e.g. for telemetry_t.stale']
+    index = 0
+    for m in messages:
+        for s in m.signals:
+            h.append('#define CAN_DB_%s_SIGNAL %d' % (macro_name(s.name), index))
+            index += 1
+    h += ['', 'extern const can_db_t can_db;', '',
+          '#endif /* %s */' % guard, '']
+
+    c = [banner, '#include "can_db.h"', '#include "../telemetry/telemetry.h"', '',
+         'static const uint32_t can_db_keys[CAN_DB_MESSAGE_COUNT] = {']
+    for m in messages:
+        c.append('\tCAN_DB_%s_KEY,' % macro_name(m.name))
+    c += ['};', '',
+          'static const can_message_t can_db_messages[CAN_DB_MESSAGE_COUNT] = {']
+    first = 0
+    for m in messages:
+        c.append('\t{ .first_signal = %d, .signal_count = %d, .length = %d }, '
+                 '// %s' % (first, len(m.signals), m.length, m.name))
+        first += len(m.signals)
+    c += ['};', '',
+          'static const can_signal_t can_db_signals[CAN_DB_SIGNAL_COUNT] = {']
+    for m in messages:
+        c.append('\t// %s' % m.name)
+        for s in m.signals:
+            byte_offset, shift = s.window()
+            flags = []
+            if s.signed:
+                flags.append('CAN_SIG_SIGNED')
+            if not s.little_endian:
+                flags.append('CAN_SIG_BIG_ENDIAN')
+            if s.scale == 1.0 and s.offset == 0.0:
+                flags.append('CAN_SIG_RAW')
+            c.append('\t{ CAN_SIGNAL_DEST(%s), .scale = %s, .offset = %s,'
+                     % (s.dest(), c_float(s.scale), c_float(s.offset)))
+            c.append('\t\t.byte_offset = %d, .end = %d, .shift = %d, '
+                     '.length = %d, .flags = %s },'
+                     % (byte_offset, s.end_byte(), shift, s.length,
+                        ' | '.join(flags) or '0'))
+    c += ['};', '',
+          'static const uint32_t can_db_timeouts_us[CAN_DB_SIGNAL_COUNT] = {']
+    for m in messages:
+        c.append('\t// %s' % m.name)
+        for s in m.signals:
+            c.append('\t%dU, // %s' % (s.timeout_ms * 1000, s.name))
+    c += ['};', '',
+          'static const char *const can_db_names[CAN_DB_MESSAGE_COUNT] = {']
+    for m in messages:
+        c.append('\t"%s",' % m.name)
+    c += ['};', '',
+          'const can_db_t can_db = {',
+          '\t.keys = can_db_keys,',
+          '\t.messages = can_db_messages,',
+          '\t.signals = can_db_signals,',
+          '\t.names = can_db_names,',
+          '\t.rx_us = signal_rx_us,',
+          '\t.timeouts_us = can_db_timeouts_us,',
+          '\t.message_count = CAN_DB_MESSAGE_COUNT',
+          '};', '']
+    return '\n'.join(h), '\n'.join(c)
+
+
+def read_crlf(path):
+    """A generated file as generate() returned it, or None if missing."""
+    try:
+        with open(path, encoding='utf-8', newline='') as f:
+            return f.read().replace('\r\n', '\n')
+    except FileNotFoundError:
+        return None
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('dbc')
+    parser.add_argument('-o', '--outdir',
+                        help='output directory (default: next to the DBC)')
+    parser.add_argument('--check', action='store_true',
+                        help='fail if the generated files are out of date')
+    args = parser.parse_args()
+
+    outdir = args.outdir or os.path.dirname(os.path.abspath(args.dbc))
+    try:
+        messages = parse_dbc(args.dbc)
+        header, source = generate(
+            messages, os.path.basename(args.dbc),
+            'APPLICATION_USER_CORE_EDITABLE_FDCAN_CAN_DB_H_')
+    except ValueError as e:
+        sys.exit('dbc2c: %s' % e)
+
+    outputs = (('can_db.h', header), ('can_db.c', source))
+    if args.check:
+        stale = [name for name, text in outputs
+                 if read_crlf(os.path.join(outdir, name)) != text]
+        if stale:
+            sys.exit('dbc2c: %s out of date with %s, run Tools/dbc2c.py'
+                     % (' and '.join(stale), os.path.basename(args.dbc)))
+        return
+
+    for name, text in outputs:
+        with open(os.path.join(outdir, name), 'w', newline='\r\n') as f:
+            f.write(text)
+
+
+if __name__ == '__main__':
+    main()
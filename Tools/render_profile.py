@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""
+Decode the render profile records the dashboard sends on USART1.
+
+    stty -F /dev/ttyACM0 115200 raw
+    python3 Tools/render_profile.py /dev/ttyACM0
+    python3 Tools/render_profile.py --summary profile.bin
+
+The firmware follows each CAN statistics report with a binary record of
+render timing histograms (gui/render_profile.h); Tools/replay writes the same
+records with -r. Text between records is passed through unless --quiet. For
+each record the sample count and p50/p90/p99/max of every series are
+printed, times in us; --summary prints one table for the whole input at the
+end instead. Values are known to within their histogram bucket, a quarter
+octave.
+"""
+
+import argparse
+import struct
+import sys
+
+SYNC = b'\xa5\x5a'
+VERSION = 1
+HEADER = 6  # sync, version, series, length
+BUCKETS = 124
+
+# (name, in cycles), in render_profile_series_t order
+SERIES = (
+    ('handler', True),
+    ('layout', True),
+    ('render', True),
+    ('draw rect', True),
+    ('draw arc', True),
+    ('draw letter', True),
+    ('draw img', True),
+    ('draw line', True),
+    ('flush', True),
+    ('flush wait', True),
+    ('areas', False),
+    ('px', False),
+)
+
+
+def crc16(data):
+    """CRC-16/CCITT-FALSE, as render_profile.c."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if crc & 0x8000 else crc << 1
+            crc &= 0xFFFF
+    return crc
+
+
+def bucket_low(bucket):
+    """Smallest value that falls in a bucket."""
+    if bucket < 4:
+        return bucket
+    octave = (bucket - 4) // 4 + 2
+    return (4 + (bucket - 4) % 4) << (octave - 2)
+
+
+def bucket_value(bucket):
+    """A bucket's midpoint, standing in for the values in it."""
+    low = bucket_low(bucket)
+    high = bucket_low(bucket + 1) if bucket + 1 < BUCKETS else 1 << 32
+    return (low + high - 1) / 2
+
+
+class Record:
+    def __init__(self, sequence, clock_hz, interval_us, histograms):
+        self.sequence = sequence
+        self.clock_hz = clock_hz
+        self.interval_us = interval_us
+        self.histograms = histograms  # series id: {bucket: count}
+
+
+def parse_record(payload):
+    sequence, clock_hz, interval_us = struct.unpack_from('<HII', payload)
+    histograms = {}
+    pos = 10
+    while pos < len(payload):
+        series, buckets = payload[pos], payload[pos + 1]
+        pos += 2
+        histogram = histograms.setdefault(series, {})
+        for _ in range(buckets):
+            bucket, count = struct.unpack_from('<BH', payload, pos)
+            histogram[bucket] = histogram.get(bucket, 0) + count
+            pos += 3
+    return Record(sequence, clock_hz, interval_us, histograms)
+
+
+def split(buf, final=False):
+    """Records and text from the start of buf; returns what is left over,
+    an incomplete record or a sync byte that may start one. At the end of
+    the input nothing is left over: an incomplete record was text."""
+    items = []
+    while True:
+        start = buf.find(SYNC)
+        if start < 0:
+            keep = 1 if buf.endswith(SYNC[:1]) and not final else 0
+            if len(buf) > keep:
+                items.append(buf[:len(buf) - keep])
+            return items, buf[len(buf) - keep:]
+        if start > 0:
+            items.append(buf[:start])
+            buf = buf[start:]
+        if len(buf) < HEADER and not final:
+            return items, buf
+        version, _, length = (struct.unpack_from('<BBH', buf, 2)
+                              if len(buf) >= HEADER else (None, 0, 0))
+        end = HEADER + length + 2
+        if version != VERSION or (final and len(buf) < end):
+            items.append(buf[:1])  # not a record after all
+            buf = buf[1:]
+            continue
+        if len(buf) < end:
+            return items, buf
+        crc, = struct.unpack_from('<H', buf, end - 2)
+        if crc != crc16(buf[2:end - 2]):
+            items.append(buf[:1])
+            buf = buf[1:]
+            continue
+        items.append(parse_record(buf[HEADER:end - 2]))
+        buf = buf[end:]
+
+
+def percentile(histogram, p):
+    total = sum(histogram.values())
+    rank = p * (total - 1)
+    seen = 0
+    for bucket in sorted(histogram):
+        seen += histogram[bucket]
+        if seen > rank:
+            return bucket_value(bucket)
+    return bucket_value(max(histogram))
+
+
+def print_table(title, histograms, clock_hz):
+    print(title)
+    print('  %-14s %8s %10s %10s %10s %10s' % ('series', 'samples', 'p50',
+                                               'p90', 'p99', 'max'))
+    for series, histogram in sorted(histograms.items()):
+        if not histogram:
+            continue
+        name, cycles = (SERIES[series] if series < len(SERIES)
+                        else ('series %d' % series, False))
+        scale = 1e6 / clock_hz if cycles else 1
+        unit = ' us' if cycles else ''
+        values = [percentile(histogram, p) * scale
+                  for p in (0.50, 0.90, 0.99)]
+        values.append(bucket_value(max(histogram)) * scale)
+        print('  %-14s %8d %10s %10s %10s %10s' % (
+            name + unit, sum(histogram.values()),
+            *('%.1f' % v if cycles else '%.0f' % v for v in values)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().split('\n')[0])
+    parser.add_argument('input', nargs='?',
+                        help='serial port or file (default: stdin)')
+    parser.add_argument('-s', '--summary', action='store_true',
+                        help='one table for the whole input')
+    parser.add_argument('-q', '--quiet', action='store_true',
+                        help='leave out the text between records')
+    args = parser.parse_args()
+
+    try:
+        stream = (open(args.input, 'rb', buffering=0) if args.input
+                  else sys.stdin.buffer)
+    except OSError as e:
+        sys.exit('render_profile: %s' % e)
+
+    totals = {}
+    clock_hz = None
+    records = 0
+    buf = b''
+    try:
+        while True:
+            chunk = stream.read(4096)
+            items, buf = split(buf + chunk, final=not chunk)
+            for item in items:
+                if not isinstance(item, Record):
+                    if not args.quiet and not args.summary:
+                        sys.stdout.write(item.decode('ascii', 'replace'))
+                    continue
+                records += 1
+                clock_hz = item.clock_hz
+                if args.summary:
+                    for series, histogram in item.histograms.items():
+                        total = totals.setdefault(series, {})
+                        for bucket, count in histogram.items():
+                            total[bucket] = total.get(bucket, 0) + count
+                else:
+                    print_table('profile #%d, %.2f s' % (
+                        item.sequence, item.interval_us / 1e6),
+                        item.histograms, item.clock_hz)
+                sys.stdout.flush()
+            if not chunk:
+                break
+    except KeyboardInterrupt:
+        pass
+
+    if args.summary:
+        if records == 0:
+            sys.exit('render_profile: no records')
+        print_table('%d records' % records, totals, clock_hz)
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,926 @@
+/*
+ * can_check.c
+ *
+ *  Created on: 18/10/2026
+ *      Author:
+ */
+#include "can_check.h"
+#include "host_port.h"
+#include "fdcan/can_db.h"
+#include "fdcan/can_stats.h"
+#include "fdcan/fdcan_handlers.h"
+#include "fdcan/can_decode.h"
+#include "fdcan/can_filter.h"
+#include "telemetry/telemetry.h"
+#include <inttypes.h>
+#include <math.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <float.h>
+
+#define RX_STRESS_US 3000000U // of frames back to back
+#define RX_STRESS_STALL_EVERY_US 20000U // the decoder is held off
+#define RX_STRESS_STALL_US 5000U // for this long, like a busy higher priority
+#define DECODE_FRAMES 4096U // random frames, the database's messages in turn
+#define DECODE_RUNS 200U
+#define LOCK_US 1000000U // of each seqlock phase
+#define LOCK_READERS 2U
+#define LOCK_BURST 16U // writes back to back, as frames queue in the ring
+#define LOCK_BURST_GAP_NS 20000U // then the writer sleeps, letting readers in
+#define LOCK_YIELD_EVERY 64U // writes the writer is preempted in the middle of
+#define FILTER_TRIALS 20000U // random ID sets of each ID type
+#define FILTER_CLUSTERS_MAX 100U // runs of IDs in a set, past can_filter.c's
+#define FILTER_CLUSTER_MAX 16U // IDs in a run
+#define FILTER_PLAN_RUNS 64U // can_filter.c's MAX_RUNS
+#define FILTER_BANK_MAX 32U // filters offered, the FDCAN has 28 and 8
+
+static uint64_t wall_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+}
+
+static uint32_t check_seed = 1;
+
+static uint32_t check_random(void) {
+	check_seed = check_seed * 1664525U + 1013904223U;
+	return check_seed >> 8;
+}
+
+static void sleep_until(uint64_t t_ns) {
+	struct timespec ts = { .tv_sec = (time_t) (t_ns / 1000000000U),
+			.tv_nsec = (long) (t_ns % 1000000000U) };
+
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+	}
+}
+
+/* Frames the decoder task hands to can_stats_record(), seen through the
+ * linker's --wrap (see the Makefile) */
+
+static void (*frame_hook)(const can_frame_t *frame);
+
+void __real_can_stats_record(uint32_t slot, const can_frame_t *frame,
+		uint32_t now_us);
+
+void __wrap_can_stats_record(uint32_t slot, const can_frame_t *frame,
+		uint32_t now_us) {
+	if (frame_hook != NULL) {
+		frame_hook(frame);
+	}
+	__real_can_stats_record(slot, frame, now_us);
+}
+
+/* RX stress -------------------------------------------------------------- */
+
+static bool rx_stress_done;
+static uint32_t rx_stress_seen; // frames decoded, in the decoder thread
+static uint32_t rx_stress_out_of_order;
+
+// frame n of the stress: the database's messages in turn, n in its payload,
+// the extended ones with each priority in turn
+static void rx_stress_frame(uint32_t n, can_frame_t *frame) {
+	uint32_t m = n % CAN_DB_MESSAGE_COUNT;
+	uint32_t key = can_db.keys[m];
+
+	memset(frame, 0, sizeof(*frame));
+	frame->extended = (key & CAN_KEY_EXTENDED) != 0;
+	frame->id = key & ~CAN_KEY_EXTENDED;
+	if (frame->extended) {
+		frame->id |= ((n / CAN_DB_MESSAGE_COUNT) << 25) & CAN_EXT_ID_MASK;
+	}
+	frame->len = can_db.messages[m].length;
+	memcpy(frame->data, &n, sizeof(n));
+}
+
+// the frame's bits at the nominal rate without stuff bits, as can_stats.c
+// counts them: the shortest a frame can take on a 1 Mbit/s bus
+static uint32_t rx_stress_frame_us(const can_frame_t *frame) {
+	return ((frame->extended ? 67U : 47U) + 8U * frame->len) * 1000000U
+			/ CAN_BITRATE;
+}
+
+static void rx_stress_check(const can_frame_t *frame) {
+	can_frame_t expected;
+
+	rx_stress_frame(rx_stress_seen, &expected);
+	if (frame->id != expected.id || frame->extended != expected.extended
+			|| frame->len != expected.len
+			|| memcmp(frame->data, expected.data, expected.len) != 0) {
+		rx_stress_out_of_order++;
+	}
+	rx_stress_seen++;
+}
+
+// the decoder task: drains the ring, then is held off now and then as the
+// scheduler would hold it off for a higher priority task
+static void* rx_stress_decoder(void *arg) {
+	uint64_t next_stall = wall_ns() + RX_STRESS_STALL_EVERY_US * 1000ULL;
+	(void) arg;
+
+	while (!__atomic_load_n(&rx_stress_done, __ATOMIC_ACQUIRE)) {
+		can_rx_process();
+
+		uint64_t now = wall_ns();
+		if (now >= next_stall) {
+			sleep_until(now + RX_STRESS_STALL_US * 1000ULL);
+			next_stall = now + RX_STRESS_STALL_EVERY_US * 1000ULL;
+		} else {
+			sleep_until(now + 50000U); // woken by the next interrupts
+		}
+	}
+	can_rx_process();
+	return NULL;
+}
+
+/* Frames back to back at 1 Mbit/s through the firmware's acceptance filters,
+ * the FDCAN model's FIFO and the real RX interrupt callback, in this thread,
+ * while can_rx_process() decodes them in another. Every frame must pass the
+ * filters whatever its priority bits, and arrive once and in order, with no
+ * FIFO or ring losses. */
+int rx_stress(void) {
+	can_rx_counters_t counters;
+	can_frame_t frame;
+	pthread_t decoder;
+	uint32_t sent = 0;
+	uint32_t filtered = 0;
+	uint64_t bus_us = 0;
+
+	host_fdcan_init();
+	can_configure_filters();
+	frame_hook = rx_stress_check;
+	if (pthread_create(&decoder, NULL, rx_stress_decoder, NULL) != 0) {
+		perror("pthread_create");
+		return 1;
+	}
+
+	// frames that have finished on the bus by the wall clock go through the
+	// interrupt one at a time, as the FIFO takes them
+	uint64_t start = wall_ns();
+	while (bus_us < RX_STRESS_US) {
+		uint64_t now_us = (wall_ns() - start) / 1000U;
+
+		while (bus_us <= now_us && bus_us < RX_STRESS_US) {
+			rx_stress_frame(sent, &frame);
+			bus_us += rx_stress_frame_us(&frame);
+			if (host_fdcan_receive(&frame)) {
+				sent++;
+			} else {
+				filtered++;
+			}
+		}
+		sleep_until(start + bus_us * 1000U);
+	}
+	double wall_s = (wall_ns() - start) / 1e9;
+
+	__atomic_store_n(&rx_stress_done, true, __ATOMIC_RELEASE);
+	pthread_join(decoder, NULL);
+	frame_hook = NULL;
+	can_rx_get_counters(&counters);
+
+	printf("rx stress   %" PRIu32 " frames in %.2f s (%.0f frames/s), "
+			"%" PRIu32 " filtered\n", sent, wall_s, sent / wall_s, filtered);
+	printf("            %" PRIu32 " received, %" PRIu32 " decoded, %" PRIu32
+			" out of order, %" PRIu32 " FIFO lost, %" PRIu32 " ring overflows, "
+			"ring high water %" PRIu32 " of %u\n", counters.received,
+			rx_stress_seen, rx_stress_out_of_order, counters.fifo_lost,
+			counters.ring_overflow, counters.ring_high_water, CAN_RX_RING_SIZE);
+
+	bool ok = filtered == 0 && counters.received == sent
+			&& rx_stress_seen == sent && counters.decoded == sent
+			&& rx_stress_out_of_order == 0 && counters.fifo_lost == 0
+			&& counters.ring_overflow == 0;
+	if (!ok) {
+		printf("rx stress   FAILED\n");
+	}
+	return ok ? 0 : 1;
+}
+
+/* FD frames -------------------------------------------------------------- */
+
+#define FD_KEY 0x123U
+#define FD_LENGTHS 16U // of the DLC codes
+#define FD_SIGNALS (FD_LENGTHS + 3U)
+
+static const uint8_t fd_lengths[FD_LENGTHS] = { 0, 1, 2, 3, 4, 5, 6, 7, 8,
+		12, 16, 20, 24, 32, 48, 64 };
+
+// one byte at the end of each length, then signals across the last bytes
+// of the 64 and across the classic frame's end
+static uint8_t fd_last_byte[FD_LENGTHS];
+static uint32_t fd_le32; // bytes 60 to 63, Intel
+static uint16_t fd_be16; // bytes 62 and 63, Motorola
+static uint16_t fd_le16; // bytes 7 and 8, Intel
+
+static const uint32_t fd_keys[] = { FD_KEY };
+static const can_message_t fd_messages[] = {
+	{ .first_signal = 0, .signal_count = FD_SIGNALS, .length = 64 }
+};
+static const char *const fd_names[] = { "FD_Test" };
+static can_signal_t fd_signals[FD_SIGNALS];
+static uint32_t fd_rx_us[FD_SIGNALS];
+static uint32_t fd_timeouts_us[FD_SIGNALS];
+
+static const can_db_t fd_db = {
+	.keys = fd_keys,
+	.messages = fd_messages,
+	.signals = fd_signals,
+	.names = fd_names,
+	.rx_us = fd_rx_us,
+	.timeouts_us = fd_timeouts_us,
+	.message_count = 1
+};
+
+// the signals as dbc2c.py lays them out
+static void fd_db_init(void) {
+	for (uint32_t i = 1; i < FD_LENGTHS; i++) {
+		fd_signals[i] = (can_signal_t) { CAN_SIGNAL_DEST(fd_last_byte[i]),
+				.scale = 1.0f, .byte_offset = fd_lengths[i] - 1U,
+				.end = fd_lengths[i], .length = 8, .flags = CAN_SIG_RAW };
+	}
+	// DLC 0 has no byte: the slot carries the Intel word instead
+	fd_signals[0] = (can_signal_t) { CAN_SIGNAL_DEST(fd_le32), .scale = 1.0f,
+			.byte_offset = 60, .end = 64, .length = 32, .flags = CAN_SIG_RAW };
+	fd_signals[FD_LENGTHS] = (can_signal_t) { CAN_SIGNAL_DEST(fd_be16),
+			.scale = 1.0f, .byte_offset = 62, .end = 64, .shift = 48,
+			.length = 16, .flags = CAN_SIG_BIG_ENDIAN | CAN_SIG_RAW };
+	fd_signals[FD_LENGTHS + 1U] = (can_signal_t) { CAN_SIGNAL_DEST(fd_le16),
+			.scale = 1.0f, .byte_offset = 7, .end = 9, .length = 16,
+			.flags = CAN_SIG_RAW };
+	// and one whose window starts past a short frame's zero padding
+	fd_signals[FD_LENGTHS + 2U] = (can_signal_t) {
+			CAN_SIGNAL_DEST(fd_last_byte[0]), .scale = 1.0f, .byte_offset = 40,
+			.end = 41, .length = 8, .flags = CAN_SIG_RAW };
+}
+
+// what a signal holds after decoding data, or its old value if it runs past
+// len
+static uint32_t fd_expected(uint32_t signal, const uint8_t *data, uint8_t len,
+		uint32_t old) {
+	const can_signal_t *sig = &fd_signals[signal];
+
+	if (sig->end > len) {
+		return old;
+	}
+	if (signal == 0) {
+		return data[60] | (uint32_t) data[61] << 8 | (uint32_t) data[62] << 16
+				| (uint32_t) data[63] << 24;
+	}
+	if (signal == FD_LENGTHS) {
+		return (uint32_t) data[62] << 8 | data[63];
+	}
+	if (signal == FD_LENGTHS + 1U) {
+		return data[7] | (uint32_t) data[8] << 8;
+	}
+	return data[sig->byte_offset];
+}
+
+static uint32_t fd_value(uint32_t signal) {
+	if (signal == 0) {
+		return fd_le32;
+	}
+	if (signal == FD_LENGTHS) {
+		return fd_be16;
+	}
+	if (signal == FD_LENGTHS + 1U) {
+		return fd_le16;
+	}
+	if (signal == FD_LENGTHS + 2U) {
+		return fd_last_byte[0];
+	}
+	return fd_last_byte[signal];
+}
+
+static can_frame_t fd_received;
+
+static void fd_hook(const can_frame_t *frame) {
+	fd_received = *frame;
+}
+
+/* A classic and an FD frame of every DLC code, full of random bytes, through
+ * the real RX interrupt (classic frames with DLC 9 to 15 carry 8 bytes),
+ * then the payload it queued through can_decode() with a database of one
+ * 64-byte message. Signals ending at every FD length and at byte 63 must
+ * decode, and those past the end of a shorter frame must keep their value
+ * and RX time. Returns the failures. */
+static uint32_t fd_check(void) {
+	uint32_t failed = 0;
+	uint32_t decoded = 0;
+	uint32_t kept = 0;
+
+	fd_db_init();
+	host_fdcan_init();
+	can_configure_filters();
+	frame_hook = fd_hook;
+
+	for (uint32_t fd = 0; fd < 2U; fd++) {
+		for (uint32_t dlc = 0; dlc < FD_LENGTHS; dlc++) {
+			uint8_t len = fd ? fd_lengths[dlc] : (uint8_t) (dlc > 8 ? 8 : dlc);
+			uint32_t old[FD_SIGNALS];
+			can_frame_t frame = { .id = can_db.keys[0], .fd = fd != 0,
+					.brs = fd != 0 };
+
+			for (uint32_t b = 0; b < CAN_FRAME_MAX_LEN; b++) {
+				frame.data[b] = (uint8_t) check_random();
+			}
+			memset(&fd_received, 0, sizeof(fd_received));
+			host_fdcan_receive_dlc(&frame, dlc);
+			can_rx_process();
+			if (fd_received.len != len || fd_received.fd != frame.fd
+					|| memcmp(fd_received.data, frame.data, len) != 0) {
+				printf("            %s DLC %" PRIu32 ": %u bytes queued, "
+						"not %u\n", fd ? "FD" : "classic", dlc,
+						fd_received.len, len);
+				failed++;
+				continue;
+			}
+
+			// the RX times say which signals were decoded
+			for (uint32_t i = 0; i < FD_SIGNALS; i++) {
+				old[i] = fd_value(i);
+				fd_rx_us[i] = 0;
+			}
+			can_decode(&fd_db, FD_KEY, fd_received.data, fd_received.len, 1);
+			for (uint32_t i = 0; i < FD_SIGNALS; i++) {
+				bool past = fd_signals[i].end > len;
+
+				if (fd_value(i) != fd_expected(i, frame.data, len, old[i])
+						|| (fd_rx_us[i] == 0) != past) {
+					printf("            %s DLC %" PRIu32 ": signal ending at "
+							"byte %u wrong\n", fd ? "FD" : "classic", dlc,
+							fd_signals[i].end);
+					failed++;
+				}
+				decoded += !past;
+				kept += past;
+			}
+		}
+	}
+	frame_hook = NULL;
+	printf("fd frames   DLC 0 to 15, classic and FD: %" PRIu32 " signals "
+			"decoded, %" PRIu32 " past the frame kept, %" PRIu32 " wrong\n",
+			decoded, kept, failed);
+	return failed;
+}
+
+/* Decoding --------------------------------------------------------------- */
+
+static inv_t old_inv1;
+static inv_t old_inv2;
+static battery_t old_battery;
+static vcu_t old_vcu;
+
+/* The hand-written decoder can_decode() replaced, as it was in the RX
+ * interrupt but into its own copies of the telemetry, and without the VCU's
+ * last_comm_time, which is gone */
+static void decode_switch(const can_frame_t *frame) {
+	const uint8_t *rxData = frame->data;
+
+	if (frame->extended) {
+		switch (frame->id & 0x01FFFFFF) {
+		case 0x118ff71:
+			old_inv1.output_torque = ((rxData[0]) | (rxData[1] << 8)) / 160.0f;
+			old_inv1.motor_speed = (int16_t) ((rxData[2]) | (rxData[3] << 8));
+			old_inv1.battery_current = (int16_t) ((rxData[4])
+					| (rxData[5] << 8));
+			break;
+		case 0x118ff72:
+			old_inv2.output_torque = ((rxData[0]) | (rxData[1] << 8)) / 160.0f;
+			old_inv2.motor_speed = (int16_t) ((rxData[2]) | (rxData[3] << 8));
+			old_inv2.battery_current = (int16_t) ((rxData[4])
+					| (rxData[5] << 8));
+			break;
+		case 0x119ff71:
+			old_inv1.available_forward_torque = ((rxData[0]) | (rxData[1] << 8))
+					/ 160.0f;
+			old_inv1.available_reverse_torque = ((rxData[2]) | (rxData[3] << 8))
+					/ 160.0f;
+			old_inv1.statusword = (statusword_t) rxData[4];
+			break;
+		case 0x119ff72:
+			old_inv2.available_forward_torque = ((rxData[0]) | (rxData[1] << 8))
+					/ 160.0f;
+			old_inv2.available_reverse_torque = ((rxData[2]) | (rxData[3] << 8))
+					/ 160.0f;
+			old_inv2.statusword = (statusword_t) rxData[4];
+			break;
+		case 0x11aff71:
+			old_inv1.capacitor_voltage = ((rxData[4]) | (rxData[5] << 8))
+					/ 16.0f;
+			old_inv1.temperature = INVERTER_CUTOFF_TEMP
+					- (int16_t) ((rxData[0]) | (rxData[1] << 8));
+			old_inv1.motor_temp = (int16_t) ((rxData[2]) | (rxData[3] << 8));
+			break;
+		case 0x11aff72:
+			old_inv2.capacitor_voltage = ((rxData[4]) | (rxData[5] << 8))
+					/ 16.0f;
+			old_inv2.temperature = INVERTER_CUTOFF_TEMP
+					- (int16_t) ((rxData[0]) | (rxData[1] << 8));
+			old_inv2.motor_temp = (int16_t) ((rxData[2]) | (rxData[3] << 8));
+			break;
+		default:
+			break;
+		}
+	} else {
+		switch (frame->id) {
+		case 0x6B1:
+			old_battery.pack_dcl = (uint16_t) (rxData[0] << 8) | rxData[1];
+			old_battery.temperature = rxData[4];
+			break;
+		case 0x6B0:
+			old_battery.pack_soc = rxData[4] / 2;
+			old_battery.pack_voltage = (((uint16_t) rxData[2] << 8)
+					| rxData[3]) * 0.1f;
+			old_battery.pack_current = (((uint16_t) rxData[0] << 8)
+					| rxData[1]) * 0.1f;
+			break;
+		case 0x7A4:
+			old_vcu.lv_voltage = (rxData[0] + ((uint16_t) rxData[1] << 8))
+					* 12.58f / 2561.0f;
+			old_vcu.current_limit = rxData[4];
+			old_vcu.rtd_switch_state = (rxData[6] >> 4) & 1;
+			old_vcu.rtd = (rxData[6] >> 3) & 1;
+			old_battery.active = (rxData[6] >> 2) & 1;
+			old_inv1.active = (rxData[6] >> 1) & 1;
+			old_inv2.active = (rxData[6] >> 0) & 1;
+			old_vcu.fault = rxData[7];
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static uint32_t float_differs(float a, float b, uint32_t *rounding) {
+	if (a == b) {
+		return 0;
+	}
+	// the scales are the same numbers written differently, 0.00625 for
+	// 1 / 160, so the products may be an ulp or two apart
+	if (fabsf(a - b) <= fabsf(b) * 4.0f * FLT_EPSILON) {
+		(*rounding)++;
+		return 0;
+	}
+	return 1;
+}
+
+// the old arithmetic wrapped where the table saturates: a differing value
+// at the field's limit is that, anything else a mismatch
+static uint32_t int_differs(int32_t a, int32_t b, int32_t min, int32_t max,
+		uint32_t *saturated) {
+	if (a == b) {
+		return 0;
+	}
+	if (a == min || a == max) {
+		(*saturated)++;
+		return 0;
+	}
+	return 1;
+}
+
+static uint32_t inv_differs(const inv_t *a, const inv_t *b, uint32_t *rounding,
+		uint32_t *saturated) {
+	return float_differs(a->output_torque, b->output_torque, rounding)
+			+ (a->motor_speed != b->motor_speed)
+			+ (a->battery_current != b->battery_current)
+			+ float_differs(a->available_forward_torque,
+					b->available_forward_torque, rounding)
+			+ float_differs(a->available_reverse_torque,
+					b->available_reverse_torque, rounding)
+			+ (a->statusword != b->statusword)
+			+ float_differs(a->capacitor_voltage, b->capacitor_voltage,
+					rounding) + (a->active != b->active)
+			+ int_differs(a->temperature, b->temperature, INT16_MIN,
+					INT16_MAX, saturated) + (a->motor_temp != b->motor_temp);
+}
+
+static uint32_t telemetry_differs(uint32_t *rounding, uint32_t *saturated) {
+	return inv_differs(&inv1, &old_inv1, rounding, saturated)
+			+ inv_differs(&inv2, &old_inv2, rounding, saturated)
+			+ (battery.pack_dcl != old_battery.pack_dcl)
+			+ (battery.temperature != old_battery.temperature)
+			+ float_differs(battery.pack_voltage, old_battery.pack_voltage,
+					rounding) + (battery.pack_soc != old_battery.pack_soc)
+			+ float_differs(battery.pack_current, old_battery.pack_current,
+					rounding) + (battery.active != old_battery.active)
+			+ float_differs(vcu.lv_voltage, old_vcu.lv_voltage, rounding)
+			+ (vcu.current_limit != old_vcu.current_limit)
+			+ (vcu.rtd != old_vcu.rtd)
+			+ (vcu.rtd_switch_state != old_vcu.rtd_switch_state)
+			+ (vcu.fault != old_vcu.fault) + (vcu.active != old_vcu.active);
+}
+
+static void decode_table(const can_frame_t *frame) {
+	can_decode(&can_db, CAN_KEY(frame->id, frame->extended), frame->data,
+			frame->len, 1);
+}
+
+static double decode_ns(const can_frame_t *frames,
+		void (*decode)(const can_frame_t *frame)) {
+	uint64_t t0 = wall_ns();
+
+	for (uint32_t r = 0; r < DECODE_RUNS; r++) {
+		for (uint32_t i = 0; i < DECODE_FRAMES; i++) {
+			decode(&frames[i]);
+		}
+	}
+	return (double) (wall_ns() - t0) / ((double) DECODE_RUNS * DECODE_FRAMES);
+}
+
+/* Random payloads of the database's messages through can_decode() and
+ * through the switch it replaced: the telemetry must come out the same,
+ * and each is timed per frame. Extended frames carry random priority bits,
+ * which both ignore. */
+int decode_check(void) {
+	static can_frame_t frames[DECODE_FRAMES];
+	uint32_t differ = 0;
+	uint32_t rounding = 0;
+	uint32_t saturated = 0;
+	uint32_t prioritised = 0;
+	uint32_t missed = 0;
+	int status = fd_check() != 0 ? 1 : 0;
+
+	for (uint32_t i = 0; i < DECODE_FRAMES; i++) {
+		rx_stress_frame(i, &frames[i]);
+		for (uint32_t b = 0; b < frames[i].len; b++) {
+			frames[i].data[b] = (uint8_t) check_random();
+		}
+		if (frames[i].extended) {
+			frames[i].id |= (check_random() << 25) & ~CAN_EXT_MATCH_MASK
+					& CAN_EXT_ID_MASK;
+			prioritised += (frames[i].id & ~CAN_EXT_MATCH_MASK) != 0;
+		}
+		missed += can_db_find(&can_db,
+				CAN_KEY(frames[i].id, frames[i].extended)) < 0;
+		decode_table(&frames[i]);
+		decode_switch(&frames[i]);
+		differ += telemetry_differs(&rounding, &saturated);
+	}
+	printf("decode      %" PRIu32 " random frames: %" PRIu32 " fields differ "
+			"from the old switch, %" PRIu32 " by float rounding, %" PRIu32
+			" saturated where it wrapped\n", DECODE_FRAMES, differ, rounding,
+			saturated);
+	printf("            %" PRIu32 " with priority bits set, %" PRIu32
+			" frames not found\n", prioritised, missed);
+	if (differ != 0 || missed != 0) {
+		status = 1;
+	}
+
+	double table = decode_ns(frames, decode_table);
+	double old = decode_ns(frames, decode_switch);
+	printf("            %.1f ns/frame table, %.1f ns/frame switch\n", table,
+			old);
+	return status;
+}
+
+/* Filter plans ----------------------------------------------------------- */
+
+static bool filter_accepts(const can_filter_t *f, uint32_t id) {
+	switch (f->type) {
+	case CAN_FILTER_RANGE:
+		return id >= f->id1 && id <= f->id2;
+	case CAN_FILTER_DUAL:
+		return id == f->id1 || id == f->id2;
+	case CAN_FILTER_MASK:
+		return (id & f->id2) == f->id1;
+	default:
+		return false;
+	}
+}
+
+// IDs a filter accepts, or 0 if it is malformed
+static uint64_t filter_size(const can_filter_t *f, uint32_t id_mask) {
+	if ((f->id1 & ~id_mask) != 0 || (f->id2 & ~id_mask) != 0) {
+		return 0;
+	}
+	switch (f->type) {
+	case CAN_FILTER_RANGE:
+		return f->id1 <= f->id2 ? (uint64_t) f->id2 - f->id1 + 1U : 0;
+	case CAN_FILTER_DUAL:
+		return f->id1 == f->id2 ? 1U : 2U;
+	case CAN_FILTER_MASK:
+		return (f->id1 & ~f->id2) == 0 ?
+				1ULL << __builtin_popcount(id_mask & ~f->id2) : 0;
+	default:
+		return 0;
+	}
+}
+
+static int compare_ids(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t*) a;
+	uint32_t y = *(const uint32_t*) b;
+
+	return (x > y) - (x < y);
+}
+
+// a sorted set of IDs in runs, as a DBC's messages cluster; returns the count
+static uint32_t filter_ids(uint32_t *ids, uint32_t id_mask) {
+	uint32_t clusters = 1U + check_random() % FILTER_CLUSTERS_MAX;
+	uint32_t count = 0;
+	uint32_t unique = 0;
+
+	for (uint32_t c = 0; c < clusters; c++) {
+		uint32_t base = ((check_random() << 8) ^ check_random()) & id_mask;
+		uint32_t length = 1U;
+
+		// mostly single IDs, some runs and some aligned power of two blocks
+		switch (check_random() % 4U) {
+		case 0:
+			length = 1U + check_random() % FILTER_CLUSTER_MAX;
+			break;
+		case 1:
+			length = 1U << (check_random() % 5U);
+			base &= ~(length - 1U);
+			break;
+		default:
+			break;
+		}
+		for (uint32_t i = 0; i < length && base + i <= id_mask; i++) {
+			ids[count++] = base + i;
+		}
+	}
+	qsort(ids, count, sizeof(ids[0]), compare_ids);
+	for (uint32_t i = 0; i < count; i++) {
+		if (unique == 0 || ids[i] != ids[unique - 1U]) {
+			ids[unique++] = ids[i];
+		}
+	}
+	return unique;
+}
+
+typedef struct {
+	uint32_t failed;
+	uint32_t exact; // plans that had room and accept exactly the IDs
+	uint32_t merged; // plans that merged runs to fit the bank
+	uint32_t overflowed; // sets of more runs than can_filter.c keeps
+	uint64_t extra; // unwanted IDs the merged plans accept
+} filter_result_t;
+
+// IDs in the smallest aligned power-of-two block that holds lo..hi
+static uint64_t filter_block(uint32_t lo, uint32_t hi) {
+	uint64_t size = 1U;
+
+	while (lo / size != hi / size) {
+		size *= 2U;
+	}
+	return size;
+}
+
+static void filter_trial(uint32_t id_mask, filter_result_t *result) {
+	static uint32_t ids[FILTER_CLUSTERS_MAX * FILTER_CLUSTER_MAX];
+	can_filter_t filters[FILTER_BANK_MAX + 1U];
+	uint32_t count = filter_ids(ids, id_mask);
+	uint32_t max_filters = 1U + check_random() % FILTER_BANK_MAX;
+	// matched on the low bits only, as the firmware's extended filters
+	bool masks_only = id_mask == CAN_EXT_MATCH_MASK;
+	uint32_t runs = 0;
+	uint32_t singles = 0;
+	uint32_t lo = 0;
+	uint64_t blocks = 0; // IDs in the runs' blocks, what masks accept
+	uint64_t accepted = 0;
+	bool ok = true;
+
+	for (uint32_t i = 0; i < count; i++) {
+		bool last = i + 1U == count || ids[i + 1U] != ids[i] + 1U;
+
+		if (i == 0 || ids[i] != ids[i - 1U] + 1U) {
+			runs++;
+			singles += last;
+			lo = ids[i];
+		}
+		if (last) {
+			blocks += filter_block(lo, ids[i]);
+		}
+	}
+	// what can_filter_plan() needs for the runs as they are, at most
+	uint32_t needed =
+			masks_only ? runs : runs - singles + (singles + 1U) / 2U;
+
+	// a guard after the bank catches writes past max_filters
+	filters[max_filters].type = (can_filter_type_t) 0xA5;
+	uint32_t n = can_filter_plan(ids, count, id_mask, filters, max_filters);
+
+	if (n == 0 || n > max_filters
+			|| filters[max_filters].type != (can_filter_type_t) 0xA5) {
+		ok = false;
+		n = 0;
+	}
+	for (uint32_t f = 0; f < n; f++) {
+		uint64_t size = filter_size(&filters[f], id_mask);
+
+		ok = ok && size != 0
+				&& (!masks_only || filters[f].type == CAN_FILTER_MASK);
+		accepted += size;
+	}
+	for (uint32_t i = 0; i < count && ok; i++) {
+		uint32_t id = ids[i];
+		bool hit = false;
+
+		// whatever priority bits the sender sets
+		if (masks_only) {
+			id |= (check_random() << 25) & ~id_mask & CAN_EXT_ID_MASK;
+		}
+		for (uint32_t f = 0; f < n && !hit; f++) {
+			hit = filter_accepts(&filters[f], id);
+		}
+		ok = hit;
+	}
+	// every wanted ID is accepted, so if the filters' sizes add up to the
+	// count nothing else is; masks accept no more than the runs' blocks
+	if (runs > FILTER_PLAN_RUNS) {
+		result->overflowed++;
+	} else if (needed <= max_filters) {
+		ok = ok && (masks_only ? accepted <= blocks : accepted == count);
+		result->exact += ok;
+	} else {
+		result->merged++;
+		result->extra += accepted - count;
+	}
+	if (!ok) {
+		result->failed++;
+		if (result->failed <= 5U) {
+			printf("            %" PRIu32 " IDs from 0x%" PRIx32
+					" in %" PRIu32 " runs, %" PRIu32 " filters: wrong plan\n",
+					count, ids[0], runs, max_filters);
+		}
+	}
+}
+
+/* Random ID sets of both types through can_filter_plan(): every ID must be
+ * accepted by a filter of the bank, and exactly the IDs whenever the bank
+ * holds their runs. Extended IDs matched on their low 25 bits, as the
+ * firmware plans them, must get only mask filters, which accept the IDs with
+ * any priority bits and, when the bank holds the runs, no more than the
+ * runs' blocks. Sets of more runs than the planner keeps, and banks too
+ * small for the runs, must come up. */
+int filter_check(void) {
+	static const uint32_t masks[] = { CAN_STD_ID_MASK, CAN_EXT_ID_MASK,
+			CAN_EXT_MATCH_MASK };
+	static const char *const names[] = { "11-bit", "29-bit", "25-bit" };
+	int status = 0;
+
+	for (uint32_t m = 0; m < 3U; m++) {
+		filter_result_t result = { 0 };
+
+		for (uint32_t t = 0; t < FILTER_TRIALS; t++) {
+			filter_trial(masks[m], &result);
+		}
+		printf("filters     %s: %" PRIu32 " ID sets, %" PRIu32 " wrong plans,"
+				" %" PRIu32 " exact, %" PRIu32 " merged (%.1f extra IDs"
+				" each), %" PRIu32 " past %u runs\n",
+				names[m], FILTER_TRIALS, result.failed,
+				result.exact, result.merged,
+				result.merged != 0 ? (double) result.extra / result.merged : 0.0,
+				result.overflowed, FILTER_PLAN_RUNS);
+		if (result.failed != 0 || result.exact == 0 || result.merged == 0
+				|| result.overflowed == 0) {
+			status = 1;
+		}
+	}
+	return status;
+}
+
+/* Telemetry seqlock ------------------------------------------------------ */
+
+static bool lock_done;
+static bool lock_unlocked; // the control: readers copy without the seqlock
+
+// Write k into fields at both ends of the telemetry and in between, in two
+// halves with the writer sometimes preempted between them. Float fields
+// take the low 24 bits, which they hold exactly.
+static void lock_write(uint32_t k) {
+	float f = (float) (k & 0xFFFFFFU);
+
+	battery.pack_voltage = f;
+	inv1.capacitor_voltage = f;
+	signal_rx_us[0] = k;
+	if (k % LOCK_YIELD_EVERY == 0) {
+		sched_yield();
+	}
+	battery.pack_current = -f;
+	vcu.lv_voltage = f;
+	inv2.motor_speed = (int16_t) k;
+	signal_rx_us[CAN_DB_SIGNAL_COUNT - 1U] = k;
+}
+
+static void *lock_writer(void *arg) {
+	uint32_t *writes = arg;
+	uint32_t k = 0;
+
+	while (!__atomic_load_n(&lock_done, __ATOMIC_ACQUIRE)) {
+		for (uint32_t i = 0; i < LOCK_BURST; i++) {
+			telemetry_write_begin();
+			lock_write(++k);
+			telemetry_write_end();
+		}
+		// waking up, the writer preempts the readers mid-copy when they
+		// share a CPU
+		sleep_until(wall_ns() + LOCK_BURST_GAP_NS);
+	}
+	*writes = k;
+	return NULL;
+}
+
+// a copy of the fields lock_write() sets, torn or not
+static bool lock_consistent(const telemetry_t *t) {
+	uint32_t k = t->signal_rx_us[0];
+	float f = (float) (k & 0xFFFFFFU);
+
+	return t->battery.pack_voltage == f && t->battery.pack_current == -f
+			&& t->inv1.capacitor_voltage == f && t->vcu.lv_voltage == f
+			&& t->inv2.motor_speed == (int16_t) k
+			&& t->signal_rx_us[CAN_DB_SIGNAL_COUNT - 1U] == k;
+}
+
+typedef struct {
+	uint32_t reads;
+	uint32_t torn; // the fields were not all from one write
+	uint32_t backwards; // older than the reader's previous copy
+} lock_reader_t;
+
+static void *lock_reader(void *arg) {
+	lock_reader_t *reader = arg;
+	bool unlocked = __atomic_load_n(&lock_unlocked, __ATOMIC_RELAXED);
+	uint32_t last = 0;
+	telemetry_t t;
+
+	while (!__atomic_load_n(&lock_done, __ATOMIC_ACQUIRE)) {
+		if (unlocked) {
+			t.battery = battery;
+			t.inv1 = inv1;
+			t.vcu = vcu;
+			t.inv2 = inv2;
+			memcpy(t.signal_rx_us, signal_rx_us, sizeof(signal_rx_us));
+		} else {
+			telemetry_snapshot(&t);
+		}
+		reader->reads++;
+		reader->torn += !lock_consistent(&t);
+		reader->backwards += t.signal_rx_us[0] < last;
+		last = t.signal_rx_us[0];
+	}
+	return NULL;
+}
+
+// one phase: the writer against LOCK_READERS readers for LOCK_US
+static bool lock_phase(bool unlocked, lock_reader_t *total) {
+	pthread_t writer;
+	pthread_t threads[LOCK_READERS];
+	lock_reader_t readers[LOCK_READERS] = { 0 };
+	uint32_t writes = 0;
+
+	telemetry_write_begin();
+	lock_write(0);
+	telemetry_write_end();
+	lock_done = false;
+	lock_unlocked = unlocked;
+	if (pthread_create(&writer, NULL, lock_writer, &writes) != 0) {
+		perror("pthread_create");
+		return false;
+	}
+	for (uint32_t i = 0; i < LOCK_READERS; i++) {
+		if (pthread_create(&threads[i], NULL, lock_reader, &readers[i]) != 0) {
+			perror("pthread_create");
+			return false;
+		}
+	}
+	sleep_until(wall_ns() + LOCK_US * 1000ULL);
+	__atomic_store_n(&lock_done, true, __ATOMIC_RELEASE);
+	pthread_join(writer, NULL);
+	*total = (lock_reader_t) { 0 };
+	for (uint32_t i = 0; i < LOCK_READERS; i++) {
+		pthread_join(threads[i], NULL);
+		total->reads += readers[i].reads;
+		total->torn += readers[i].torn;
+		total->backwards += readers[i].backwards;
+	}
+	printf("%s %" PRIu32 " writes, %" PRIu32 " reads: %" PRIu32 " torn, %"
+			PRIu32 " went backwards\n",
+			unlocked ? "            unlocked" : "seqlock     snapshots", writes,
+			total->reads, total->torn, total->backwards);
+	return true;
+}
+
+/* A writer thread fills paired telemetry fields with the same count inside
+ * telemetry_write_begin()/_end() while readers take telemetry_snapshot()s:
+ * no snapshot may mix two writes or be older than the one before it. The
+ * same readers copying the fields without the lock must see torn writes, or
+ * the check is not catching anything. */
+int lock_check(void) {
+	lock_reader_t locked;
+	lock_reader_t control;
+
+	if (!lock_phase(false, &locked) || !lock_phase(true, &control)) {
+		return 1;
+	}
+	if (locked.reads == 0 || locked.torn != 0 || locked.backwards != 0
+			|| control.torn == 0) {
+		printf("seqlock     FAILED\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,28 @@
+/*
+ * can_check.h
+ *
+ *  Created on: 18/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_CAN_CHECK_H_
+#define TOOLS_REPLAY_CAN_CHECK_H_
+
+/*
+ * The replay's checks of the CAN receive path, see replay.c. Each returns
+ * the process exit status: 0 if everything held, 1 if not.
+ */
+
+/* replay -x: the RX interrupt against a concurrent decoder at bus rate */
+int rx_stress(void);
+
+/* replay -e: can_decode() against the switch it replaced, and its timing */
+int decode_check(void);
+
+/* replay -i: can_filter_plan() on random ID sets */
+int filter_check(void);
+
+/* replay -l: telemetry_snapshot() against a writer thread */
+int lock_check(void);
+
+#endif /* TOOLS_REPLAY_CAN_CHECK_H_ */
@@ -0,0 +1,20 @@
+/*
+ * FreeRTOS.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_FREERTOS_H_
+#define TOOLS_REPLAY_HOST_FREERTOS_H_
+
+/* Host stand-in for the few FreeRTOS definitions the GUI code uses */
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+
+#define configTICK_RATE_HZ 1000U
+#define pdMS_TO_TICKS(ms) ((TickType_t) (((TickType_t) (ms) * configTICK_RATE_HZ) / 1000U))
+
+#endif /* TOOLS_REPLAY_HOST_FREERTOS_H_ */
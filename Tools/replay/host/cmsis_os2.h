@@ -0,0 +1,54 @@
+/*
+ * cmsis_os2.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_CMSIS_OS2_H_
+#define TOOLS_REPLAY_HOST_CMSIS_OS2_H_
+
+/*
+ * Host stand-in for the CMSIS-RTOS2 API. The replay drives the task bodies
+ * directly from one thread, so threads are never created and delays return
+ * at once. A flags wait, a task blocked until an interrupt, lets the DMA2D
+ * and LTDC models run to their next interrupt or the timeout instead.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef void *osThreadId_t;
+typedef void (*osThreadFunc_t)(void *argument);
+typedef int32_t osStatus_t;
+
+typedef enum {
+	osPriorityLow = 8,
+	osPriorityNormal = 24,
+	osPriorityAboveNormal = 32,
+	osPriorityHigh = 40
+} osPriority_t;
+
+typedef struct {
+	const char *name;
+	uint32_t attr_bits;
+	void *cb_mem;
+	uint32_t cb_size;
+	void *stack_mem;
+	uint32_t stack_size;
+	osPriority_t priority;
+} osThreadAttr_t;
+
+#define osOK 0
+#define osFlagsWaitAny 0x00000000U
+#define osWaitForever 0xFFFFFFFFU
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument,
+		const osThreadAttr_t *attr);
+osThreadId_t osThreadGetId(void);
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags);
+uint32_t osThreadFlagsClear(uint32_t flags);
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout);
+osStatus_t osDelay(uint32_t ticks);
+
+#endif /* TOOLS_REPLAY_HOST_CMSIS_OS2_H_ */
@@ -0,0 +1,138 @@
+/*
+ * dma2d.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_DMA2D_H_
+#define TOOLS_REPLAY_HOST_DMA2D_H_
+
+/*
+ * Host stand-in for Core/Inc/dma2d.h: the DMA2D register block with the
+ * CMSIS layout and bit names, behind a register-level model in host_dma2d.c,
+ * and the HAL handle with its interrupt handler. It also stands in for the
+ * CMSIS device header LVGL's DMA2D backend includes.
+ *
+ * DMA2D expands to a call that returns the registers, so every access lets
+ * the model catch up first. A transfer whose START bit was written starts at
+ * the next access, or when model time next passes (host_port.h), and writes
+ * its pixels at once; it then stays busy for as long as it would take on the
+ * target, and finishes by clearing START and setting TCIF, or CEIF for a
+ * configuration the hardware rejects, calling HAL_DMA2D_IRQHandler() if the
+ * interrupt is enabled. An access while a transfer is busy waits for it, as
+ * the firmware's polls of START do, and counts as CPU time lost to DMA2D.
+ * IFCR clears ISR flags at the next access.
+ *
+ * Addresses are 32 bits as on the target, so the replay is linked without
+ * PIE and the buffers handed to DMA2D are static.
+ */
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+	volatile uint32_t CR;
+	volatile uint32_t ISR;
+	volatile uint32_t IFCR;
+	volatile uint32_t FGMAR;
+	volatile uint32_t FGOR;
+	volatile uint32_t BGMAR;
+	volatile uint32_t BGOR;
+	volatile uint32_t FGPFCCR;
+	volatile uint32_t FGCOLR;
+	volatile uint32_t BGPFCCR;
+	volatile uint32_t BGCOLR;
+	volatile uint32_t FGCMAR;
+	volatile uint32_t BGCMAR;
+	volatile uint32_t OPFCCR;
+	volatile uint32_t OCOLR;
+	volatile uint32_t OMAR;
+	volatile uint32_t OOR;
+	volatile uint32_t NLR;
+	volatile uint32_t LWR;
+	volatile uint32_t AMTCR;
+} DMA2D_TypeDef;
+
+#define DMA2D (host_dma2d())
+
+#define DMA2D_CR_START 0x00000001U
+#define DMA2D_CR_TCIE 0x00000200U
+#define DMA2D_CR_CEIE 0x00002000U
+#define DMA2D_CR_MODE_Pos 16U
+#define DMA2D_CR_MODE_Msk (0x7U << DMA2D_CR_MODE_Pos)
+
+#define DMA2D_ISR_TEIF 0x00000001U
+#define DMA2D_ISR_TCIF 0x00000002U
+#define DMA2D_ISR_CEIF 0x00000020U
+
+#define DMA2D_FGPFCCR_CM_Msk 0x0000000FU
+#define DMA2D_FGPFCCR_AM_Pos 16U
+#define DMA2D_FGPFCCR_AM_Msk (0x3U << DMA2D_FGPFCCR_AM_Pos)
+#define DMA2D_FGPFCCR_AI 0x00100000U
+#define DMA2D_FGPFCCR_RBS 0x00200000U
+#define DMA2D_FGPFCCR_ALPHA_Pos 24U
+#define DMA2D_BGPFCCR_RBS_Pos 21U
+#define DMA2D_FGPFCCR_RBS_Pos 21U
+#define DMA2D_OPFCCR_CM_Msk 0x00000007U
+#define DMA2D_OPFCCR_RBS_Pos 21U
+
+#define DMA2D_NLR_NL_Pos 0U
+#define DMA2D_NLR_NL_Msk 0x0000FFFFU
+#define DMA2D_NLR_PL_Pos 16U
+#define DMA2D_NLR_PL_Msk 0x3FFF0000U
+
+#define DMA2D_OUTPUT_ARGB8888 0x00000000U
+#define DMA2D_OUTPUT_RGB888 0x00000001U
+#define DMA2D_OUTPUT_RGB565 0x00000002U
+#define DMA2D_OUTPUT_ARGB1555 0x00000003U
+#define DMA2D_OUTPUT_ARGB4444 0x00000004U
+
+#define DMA2D_INPUT_ARGB8888 0x00000000U
+#define DMA2D_INPUT_RGB888 0x00000001U
+#define DMA2D_INPUT_RGB565 0x00000002U
+#define DMA2D_INPUT_ARGB1555 0x00000003U
+#define DMA2D_INPUT_ARGB4444 0x00000004U
+#define DMA2D_INPUT_A8 0x00000009U
+#define DMA2D_INPUT_A4 0x0000000AU
+
+typedef enum {
+	HAL_DMA2D_STATE_RESET, HAL_DMA2D_STATE_READY, HAL_DMA2D_STATE_BUSY
+} HAL_DMA2D_StateTypeDef;
+
+typedef struct __DMA2D_HandleTypeDef {
+	DMA2D_TypeDef *Instance;
+	void (*XferCpltCallback)(struct __DMA2D_HandleTypeDef *hdma2d);
+	void (*XferErrorCallback)(struct __DMA2D_HandleTypeDef *hdma2d);
+	HAL_DMA2D_StateTypeDef State;
+} DMA2D_HandleTypeDef;
+
+extern DMA2D_HandleTypeDef hdma2d;
+
+/* As the HAL's: clears the interrupt's flag and enable bit and calls the
+ * handle's callback */
+void HAL_DMA2D_IRQHandler(DMA2D_HandleTypeDef *hdma2d);
+
+typedef struct {
+	uint32_t transfers;
+	uint32_t by_mode[4]; // M2M, M2M with PFC, with blending, R2M
+	uint32_t config_errors;
+	uint64_t pixels;
+	uint64_t busy_ns; // model time transferring
+	uint64_t wait_ns; // of it, the CPU waiting at a register access
+} host_dma2d_stats_t;
+
+/* The registers, after running anything started since the last access */
+DMA2D_TypeDef* host_dma2d(void);
+
+/* When the running transfer ends, UINT64_MAX if none; host_port.c runs the
+ * models' events in time order */
+uint64_t host_dma2d_next_event(void);
+
+/* End the running transfer, at host_dma2d_next_event() */
+void host_dma2d_event(void);
+
+void host_dma2d_get_stats(host_dma2d_stats_t *stats);
+
+#endif /* TOOLS_REPLAY_HOST_DMA2D_H_ */
@@ -0,0 +1,87 @@
+/*
+ * fdcan.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_FDCAN_H_
+#define TOOLS_REPLAY_HOST_FDCAN_H_
+
+/*
+ * Host stand-in for Core/Inc/fdcan.h: just enough of the STM32 HAL FDCAN API
+ * for fdcan_handlers.c. Constants have the HAL values; host_port.c emulates
+ * the RX FIFO and the acceptance filters.
+ */
+
+#include "main.h"
+#include <stdint.h>
+
+typedef struct {
+	uint32_t StdFiltersNbr;
+	uint32_t ExtFiltersNbr;
+} FDCAN_InitTypeDef;
+
+typedef struct {
+	void *Instance;
+	FDCAN_InitTypeDef Init;
+} FDCAN_HandleTypeDef;
+
+typedef struct {
+	uint32_t IdType;
+	uint32_t FilterIndex;
+	uint32_t FilterType;
+	uint32_t FilterConfig;
+	uint32_t FilterID1;
+	uint32_t FilterID2;
+} FDCAN_FilterTypeDef;
+
+typedef struct {
+	uint32_t Identifier;
+	uint32_t IdType;
+	uint32_t RxFrameType;
+	uint32_t DataLength; // DLC code, as on the target
+	uint32_t ErrorStateIndicator;
+	uint32_t BitRateSwitch;
+	uint32_t FDFormat;
+	uint32_t RxTimestamp;
+	uint32_t FilterIndex;
+	uint32_t IsFilterMatchingFrame;
+} FDCAN_RxHeaderTypeDef;
+
+#define FDCAN_STANDARD_ID 0x00000000U
+#define FDCAN_EXTENDED_ID 0x40000000U
+#define FDCAN_BRS_OFF 0x00000000U
+#define FDCAN_BRS_ON 0x00100000U
+#define FDCAN_CLASSIC_CAN 0x00000000U
+#define FDCAN_FD_CAN 0x00200000U
+
+#define FDCAN_FILTER_RANGE 0x00000000U
+#define FDCAN_FILTER_DUAL 0x00000001U
+#define FDCAN_FILTER_MASK 0x00000002U
+#define FDCAN_FILTER_TO_RXFIFO0 0x00000001U
+
+#define FDCAN_RX_FIFO0 0x00000040U
+#define FDCAN_ACCEPT_IN_RX_FIFO0 0x00000000U
+#define FDCAN_REJECT 0x00000002U
+#define FDCAN_FILTER_REMOTE 0x00000000U
+#define FDCAN_REJECT_REMOTE 0x00000001U
+
+#define FDCAN_IT_RX_FIFO0_MESSAGE_LOST 0x00000004U
+#define FDCAN_IT_RX_FIFO0_NEW_MESSAGE 0x00000001U
+
+extern FDCAN_HandleTypeDef hfdcan1;
+
+void HAL_FDCAN_IRQHandler(FDCAN_HandleTypeDef *hfdcan);
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan,
+		const FDCAN_FilterTypeDef *sFilterConfig);
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan,
+		uint32_t NonMatchingStd, uint32_t NonMatchingExt,
+		uint32_t RejectRemoteStd, uint32_t RejectRemoteExt);
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(const FDCAN_HandleTypeDef *hfdcan,
+		uint32_t RxFifo);
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan,
+		uint32_t RxLocation, FDCAN_RxHeaderTypeDef *pRxHeader,
+		uint8_t *pRxData);
+
+#endif /* TOOLS_REPLAY_HOST_FDCAN_H_ */
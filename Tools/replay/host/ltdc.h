@@ -0,0 +1,208 @@
+/*
+ * ltdc.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_LTDC_H_
+#define TOOLS_REPLAY_HOST_LTDC_H_
+
+/*
+ * Host stand-in for Core/Inc/ltdc.h: the LTDC registers with the CMSIS
+ * layout and bit names, the HAL calls the display port makes on them, and a
+ * model of the scan-out in host_ltdc.c.
+ *
+ * The LTDC scans from model time 0 (host_port.h) at the pixel clock
+ * MX_LTDC_Init sets up, so CPSR follows the clock. Layer registers written
+ * by software are shadows: SRCR IMR makes them active at the next access,
+ * VBR at the start of the next vertical blanking, which then raises the
+ * reload interrupt. The line interrupt fires when the scan next starts the
+ * line in LIPCR. Both call HAL_LTDC_IRQHandler() if enabled in IER, which
+ * calls the HAL's callbacks as on the target.
+ *
+ * The model composes the active layers into a frame on request, with their
+ * windows, constant alpha and colour keying, and checks every DMA2D write
+ * into a framebuffer being scanned out against the scan for a torn frame.
+ */
+
+#include "main.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+	uint32_t RESERVED0[2];
+	volatile uint32_t SSCR;
+	volatile uint32_t BPCR;
+	volatile uint32_t AWCR;
+	volatile uint32_t TWCR;
+	volatile uint32_t GCR;
+	uint32_t RESERVED1[2];
+	volatile uint32_t SRCR;
+	uint32_t RESERVED2[1];
+	volatile uint32_t BCCR;
+	uint32_t RESERVED3[1];
+	volatile uint32_t IER;
+	volatile uint32_t ISR;
+	volatile uint32_t ICR;
+	volatile uint32_t LIPCR;
+	volatile uint32_t CPSR;
+	volatile uint32_t CDSR;
+} LTDC_TypeDef;
+
+typedef struct {
+	volatile uint32_t CR;
+	volatile uint32_t WHPCR;
+	volatile uint32_t WVPCR;
+	volatile uint32_t CKCR;
+	volatile uint32_t PFCR;
+	volatile uint32_t CACR;
+	volatile uint32_t DCCR;
+	volatile uint32_t BFCR;
+	uint32_t RESERVED0[2];
+	volatile uint32_t CFBAR;
+	volatile uint32_t CFBLR;
+	volatile uint32_t CFBLNR;
+	uint32_t RESERVED1[3];
+	volatile uint32_t CLUTWR;
+} LTDC_Layer_TypeDef;
+
+#define LTDC (host_ltdc())
+#define LTDC_Layer1 (host_ltdc_layer(0))
+#define LTDC_Layer2 (host_ltdc_layer(1))
+
+#define LTDC_GCR_LTDCEN 0x00000001U
+#define LTDC_SRCR_IMR 0x00000001U
+#define LTDC_SRCR_VBR 0x00000002U
+#define LTDC_IER_LIE 0x00000001U
+#define LTDC_IER_RRIE 0x00000008U
+#define LTDC_ISR_LIF 0x00000001U
+#define LTDC_ISR_RRIF 0x00000008U
+#define LTDC_LIPCR_LIPOS 0x000007FFU
+#define LTDC_CPSR_CYPOS_Pos 0U
+#define LTDC_CPSR_CYPOS 0x0000FFFFU
+#define LTDC_CPSR_CXPOS_Pos 16U
+#define LTDC_LxCR_LEN 0x00000001U
+#define LTDC_LxCR_COLKEN 0x00000002U
+
+#define LTDC_PIXEL_FORMAT_ARGB8888 0x00000000U
+#define LTDC_PIXEL_FORMAT_RGB888 0x00000001U
+#define LTDC_PIXEL_FORMAT_RGB565 0x00000002U
+
+#define LTDC_BLENDING_FACTOR1_CA 0x00000400U
+#define LTDC_BLENDING_FACTOR1_PAxCA 0x00000600U
+#define LTDC_BLENDING_FACTOR2_CA 0x00000005U
+#define LTDC_BLENDING_FACTOR2_PAxCA 0x00000007U
+
+#define LTDC_RELOAD_IMMEDIATE LTDC_SRCR_IMR
+#define LTDC_RELOAD_VERTICAL_BLANKING LTDC_SRCR_VBR
+
+#define LTDC_HSPOLARITY_AL 0x00000000U
+#define LTDC_VSPOLARITY_AL 0x00000000U
+#define LTDC_DEPOLARITY_AL 0x00000000U
+#define LTDC_PCPOLARITY_IPC 0x00000000U
+
+typedef struct {
+	uint8_t Blue;
+	uint8_t Green;
+	uint8_t Red;
+	uint8_t Reserved;
+} LTDC_ColorTypeDef;
+
+typedef struct {
+	uint32_t HSPolarity;
+	uint32_t VSPolarity;
+	uint32_t DEPolarity;
+	uint32_t PCPolarity;
+	uint32_t HorizontalSync;
+	uint32_t VerticalSync;
+	uint32_t AccumulatedHBP;
+	uint32_t AccumulatedVBP;
+	uint32_t AccumulatedActiveW;
+	uint32_t AccumulatedActiveH;
+	uint32_t TotalWidth;
+	uint32_t TotalHeigh;
+	LTDC_ColorTypeDef Backcolor;
+} LTDC_InitTypeDef;
+
+typedef struct {
+	uint32_t WindowX0;
+	uint32_t WindowX1;
+	uint32_t WindowY0;
+	uint32_t WindowY1;
+	uint32_t PixelFormat;
+	uint32_t Alpha;
+	uint32_t Alpha0;
+	uint32_t BlendingFactor1;
+	uint32_t BlendingFactor2;
+	uint32_t FBStartAdress;
+	uint32_t ImageWidth;
+	uint32_t ImageHeight;
+	LTDC_ColorTypeDef Backcolor;
+} LTDC_LayerCfgTypeDef;
+
+typedef struct {
+	LTDC_TypeDef *Instance;
+	LTDC_InitTypeDef Init;
+	LTDC_LayerCfgTypeDef LayerCfg[2];
+} LTDC_HandleTypeDef;
+
+extern LTDC_HandleTypeDef hltdc;
+
+HAL_StatusTypeDef HAL_LTDC_Init(LTDC_HandleTypeDef *hltdc);
+HAL_StatusTypeDef HAL_LTDC_ConfigLayer(LTDC_HandleTypeDef *hltdc,
+		LTDC_LayerCfgTypeDef *pLayerCfg, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_ConfigColorKeying(LTDC_HandleTypeDef *hltdc,
+		uint32_t RGBValue, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_EnableColorKeying(LTDC_HandleTypeDef *hltdc,
+		uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_SetAddress_NoReload(LTDC_HandleTypeDef *hltdc,
+		uint32_t Address, uint32_t LayerIdx);
+HAL_StatusTypeDef HAL_LTDC_Reload(LTDC_HandleTypeDef *hltdc,
+		uint32_t ReloadType);
+HAL_StatusTypeDef HAL_LTDC_ProgramLineEvent(LTDC_HandleTypeDef *hltdc,
+		uint32_t Line);
+void HAL_LTDC_IRQHandler(LTDC_HandleTypeDef *hltdc);
+void HAL_LTDC_ReloadEventCallback(LTDC_HandleTypeDef *hltdc);
+void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef *hltdc);
+
+typedef struct {
+	uint32_t reloads; // vertical blanking reloads
+	uint32_t line_events;
+	uint32_t writes; // DMA2D transfers into a framebuffer on screen
+	uint32_t torn; // of them, shown half written in some frame
+} host_ltdc_stats_t;
+
+/* MX_LTDC_Init with layer 0 showing the framebuffer at fb */
+void host_ltdc_init(uint32_t fb);
+
+/* The registers, CPSR at the current model time */
+LTDC_TypeDef* host_ltdc(void);
+
+/* A layer's registers as software writes them */
+LTDC_Layer_TypeDef* host_ltdc_layer(uint32_t layer);
+
+/* When the next reload or line interrupt is due, UINT64_MAX if none */
+uint64_t host_ltdc_next_event(void);
+
+/* Raise the reload or line interrupt, at host_ltdc_next_event() */
+void host_ltdc_event(void);
+
+/* A DMA2D transfer writing lines from address, one every line_ns from
+ * start_ns: counted in the stats if a layer scans them out */
+void host_ltdc_check_write(uint32_t address, uint32_t lines,
+		uint64_t start_ns, uint64_t line_ns);
+
+/* Frames scanned out so far */
+uint64_t host_ltdc_frames(void);
+
+/* The active area's size, 0 before host_ltdc_init() */
+void host_ltdc_size(uint32_t *width, uint32_t *height);
+
+/* The active layers over the background as the next frame shows them,
+ * width * height RGB888 pixels */
+void host_ltdc_compose(uint8_t *rgb);
+
+void host_ltdc_get_stats(host_ltdc_stats_t *stats);
+
+#endif /* TOOLS_REPLAY_HOST_LTDC_H_ */
@@ -0,0 +1,30 @@
+/*
+ * lv_conf.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_LV_CONF_H_
+#define TOOLS_REPLAY_HOST_LV_CONF_H_
+
+/* The firmware's LVGL configuration, its STM32 DMA2D GPU backend drawing
+ * through the register model in host/dma2d.h */
+
+#include "Middlewares/Third_Party/LVGL/lv_conf.h"
+
+#undef LV_GPU_DMA2D_CMSIS_INCLUDE
+#define LV_GPU_DMA2D_CMSIS_INCLUDE "dma2d.h"
+
+/* A failed assertion, such as LVGL's heap running out, ends the run with
+ * where it failed instead of halting in a loop as the target does */
+#undef LV_ASSERT_HANDLER_INCLUDE
+#define LV_ASSERT_HANDLER_INCLUDE <stdio.h>
+#undef LV_ASSERT_HANDLER
+#define LV_ASSERT_HANDLER { \
+		fprintf(stderr, "LVGL assertion failed at %s:%d\n", __FILE__, \
+				__LINE__); \
+		__builtin_abort(); \
+	}
+
+#endif /* TOOLS_REPLAY_HOST_LV_CONF_H_ */
@@ -0,0 +1,24 @@
+/*
+ * main.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_MAIN_H_
+#define TOOLS_REPLAY_HOST_MAIN_H_
+
+/* Host stand-in for Core/Inc/main.h: what the HAL stand-ins share */
+
+#include <stdint.h>
+
+#define __IO volatile
+
+typedef enum {
+	HAL_OK = 0x00, HAL_ERROR = 0x01, HAL_BUSY = 0x02, HAL_TIMEOUT = 0x03
+} HAL_StatusTypeDef;
+
+/* Exits the replay, the target stops there */
+void Error_Handler(void);
+
+#endif /* TOOLS_REPLAY_HOST_MAIN_H_ */
@@ -0,0 +1,21 @@
+/*
+ * task.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_TASK_H_
+#define TOOLS_REPLAY_HOST_TASK_H_
+
+/* Host stand-in for the FreeRTOS task API used by the CPU load report and
+ * the render profile; there is nothing to preempt the replay */
+
+#include <stdint.h>
+
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+uint32_t ulTaskGetIdleRunTimeCounter(void);
+
+#endif /* TOOLS_REPLAY_HOST_TASK_H_ */
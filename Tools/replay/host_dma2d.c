@@ -0,0 +1,391 @@
+/*
+ * host_dma2d.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ *
+ * Register-level DMA2D model, see host/dma2d.h. Pixels go through the
+ * reference manual's pipeline: the foreground and background PFCs expand
+ * each pixel to ARGB8888 (5 and 6 bit channels by repeating their top bits,
+ * A4 by repeating the nibble, A8 and A4 taking their colour from FGCOLR or
+ * BGCOLR), apply the alpha mode, blend
+ *
+ *     a_mult = a_fg * a_bg / 255
+ *     a_out  = a_fg + a_bg - a_mult
+ *     c_out  = (c_fg * a_fg + c_bg * a_bg - c_bg * a_mult) / a_out
+ *
+ * and the output PFC truncates to the output format. The manual gives the
+ * formula but not its rounding; the model rounds the divisions to nearest.
+ * 4-bit formats have the first pixel in the low nibble.
+ *
+ * A transfer takes DMA2D_SETUP_NS plus DMA2D_BYTE_NS for every byte it reads
+ * and writes, estimates for the target's SRAM over AHB; an RGB565 copy comes
+ * to replay.c's DMA2D_PX_NS a pixel. Its output lines are written evenly over
+ * that time, which the LTDC model checks against the scan.
+ */
+#include "dma2d.h"
+#include "host_port.h"
+#include "ltdc.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MODE_M2M 0U
+#define MODE_M2M_PFC 1U
+#define MODE_M2M_BLEND 2U
+#define MODE_R2M 3U
+
+#define DMA2D_SETUP_NS 100U
+#define DMA2D_BYTE_NS 3U
+
+DMA2D_HandleTypeDef hdma2d;
+
+static DMA2D_TypeDef regs;
+static host_dma2d_stats_t stats;
+
+static bool busy; // a transfer's pixels are written, it ends at busy_end
+static uint64_t busy_end;
+
+typedef struct {
+	uint8_t a, r, g, b;
+} argb_t;
+
+static argb_t argb(uint32_t a, uint32_t r, uint32_t g, uint32_t b) {
+	argb_t c = { (uint8_t) a, (uint8_t) r, (uint8_t) g, (uint8_t) b };
+	return c;
+}
+
+static uint8_t* address(uint32_t reg) {
+	return (uint8_t*) (uintptr_t) reg;
+}
+
+static uint32_t div255(uint32_t x) {
+	return (x + 127U) / 255U;
+}
+
+// bits per pixel of an input colour mode, 0 if the model has no such mode
+static uint32_t input_bits(uint32_t cm) {
+	switch (cm) {
+	case DMA2D_INPUT_ARGB8888:
+		return 32;
+	case DMA2D_INPUT_RGB888:
+		return 24;
+	case DMA2D_INPUT_RGB565:
+	case DMA2D_INPUT_ARGB1555:
+	case DMA2D_INPUT_ARGB4444:
+		return 16;
+	case DMA2D_INPUT_A8:
+		return 8;
+	case DMA2D_INPUT_A4:
+		return 4;
+	default:
+		return 0;
+	}
+}
+
+static uint32_t output_bits(uint32_t cm) {
+	return cm == DMA2D_OUTPUT_ARGB8888 ? 32 : cm == DMA2D_OUTPUT_RGB888 ? 24 :
+			cm <= DMA2D_OUTPUT_ARGB4444 ? 16 : 0;
+}
+
+static uint8_t expand(uint32_t v, uint32_t bits) {
+	return (uint8_t) (v << (8 - bits) | v >> (2 * bits - 8));
+}
+
+/* One pixel of a layer through its PFC: pixel x of line y */
+static argb_t fetch(uint32_t mar, uint32_t offset, uint32_t pfccr,
+		uint32_t colr, uint32_t width, uint32_t x, uint32_t y) {
+	uint32_t cm = pfccr & DMA2D_FGPFCCR_CM_Msk;
+	uint32_t bits = input_bits(cm);
+	uint64_t bit = ((uint64_t) y * (width + offset) + x) * bits;
+	const uint8_t *p = address(mar) + bit / 8;
+	argb_t c = argb(0xFF, colr >> 16, colr >> 8, colr);
+	uint32_t v;
+
+	switch (cm) {
+	case DMA2D_INPUT_ARGB8888:
+		c = argb(p[3], p[2], p[1], p[0]);
+		break;
+	case DMA2D_INPUT_RGB888:
+		c = argb(0xFF, p[2], p[1], p[0]);
+		break;
+	case DMA2D_INPUT_RGB565:
+		v = (uint32_t) p[0] | (uint32_t) p[1] << 8;
+		c = argb(0xFF, expand(v >> 11, 5), expand((v >> 5) & 0x3F, 6),
+				expand(v & 0x1F, 5));
+		break;
+	case DMA2D_INPUT_ARGB1555:
+		v = (uint32_t) p[0] | (uint32_t) p[1] << 8;
+		c = argb((v & 0x8000) ? 0xFF : 0, expand((v >> 10) & 0x1F, 5),
+				expand((v >> 5) & 0x1F, 5), expand(v & 0x1F, 5));
+		break;
+	case DMA2D_INPUT_ARGB4444:
+		v = (uint32_t) p[0] | (uint32_t) p[1] << 8;
+		c = argb((v >> 12) * 17, ((v >> 8) & 0xF) * 17, ((v >> 4) & 0xF) * 17,
+				(v & 0xF) * 17);
+		break;
+	case DMA2D_INPUT_A8:
+		c.a = p[0];
+		break;
+	case DMA2D_INPUT_A4:
+		c.a = (uint8_t) (((p[0] >> (bit & 4)) & 0xF) * 17);
+		break;
+	}
+
+	if (pfccr & DMA2D_FGPFCCR_RBS) {
+		uint8_t r = c.r;
+		c.r = c.b;
+		c.b = r;
+	}
+	if (pfccr & DMA2D_FGPFCCR_AI) {
+		c.a = (uint8_t) (255 - c.a);
+	}
+	uint32_t alpha = pfccr >> DMA2D_FGPFCCR_ALPHA_Pos;
+	switch ((pfccr & DMA2D_FGPFCCR_AM_Msk) >> DMA2D_FGPFCCR_AM_Pos) {
+	case 1:
+		c.a = (uint8_t) alpha;
+		break;
+	case 2:
+		c.a = (uint8_t) div255(c.a * alpha);
+		break;
+	}
+	return c;
+}
+
+static argb_t blend(argb_t fg, argb_t bg) {
+	uint32_t mult = div255((uint32_t) fg.a * bg.a);
+	uint32_t a = fg.a + bg.a - mult;
+	argb_t out = { (uint8_t) a, 0, 0, 0 };
+
+	if (a == 0) {
+		return out;
+	}
+#define CHANNEL(c) (uint8_t) (((uint32_t) fg.c * fg.a + (uint32_t) bg.c * bg.a \
+		- (uint32_t) bg.c * mult + a / 2) / a)
+	out.r = CHANNEL(r);
+	out.g = CHANNEL(g);
+	out.b = CHANNEL(b);
+#undef CHANNEL
+	return out;
+}
+
+static void store(uint8_t *p, uint32_t cm, argb_t c) {
+	uint32_t v;
+
+	switch (cm) {
+	case DMA2D_OUTPUT_ARGB8888:
+		p[3] = c.a;
+		/* fall through */
+	case DMA2D_OUTPUT_RGB888:
+		p[2] = c.r;
+		p[1] = c.g;
+		p[0] = c.b;
+		return;
+	case DMA2D_OUTPUT_RGB565:
+		v = (uint32_t) (c.r >> 3) << 11 | (uint32_t) (c.g >> 2) << 5 | c.b >> 3;
+		break;
+	case DMA2D_OUTPUT_ARGB1555:
+		v = (uint32_t) (c.a >> 7) << 15 | (uint32_t) (c.r >> 3) << 10
+				| (uint32_t) (c.g >> 3) << 5 | c.b >> 3;
+		break;
+	default:
+		v = (uint32_t) (c.a >> 4) << 12 | (uint32_t) (c.r >> 4) << 8
+				| (uint32_t) (c.g >> 4) << 4 | c.b >> 4;
+		break;
+	}
+	p[0] = (uint8_t) v;
+	p[1] = (uint8_t) (v >> 8);
+}
+
+// the OCOLR value in the output format, as R2M writes it
+static argb_t output_color(uint32_t cm, uint32_t v) {
+	switch (cm) {
+	case DMA2D_OUTPUT_RGB565:
+		return argb(0xFF, (v >> 11) << 3, ((v >> 5) & 0x3F) << 2,
+				(v & 0x1F) << 3);
+	case DMA2D_OUTPUT_ARGB1555:
+		return argb((v & 0x8000) ? 0xFF : 0, ((v >> 10) & 0x1F) << 3,
+				((v >> 5) & 0x1F) << 3, (v & 0x1F) << 3);
+	case DMA2D_OUTPUT_ARGB4444:
+		return argb((v >> 12) << 4, ((v >> 8) & 0xF) << 4,
+				((v >> 4) & 0xF) << 4, (v & 0xF) << 4);
+	default:
+		return argb(v >> 24, v >> 16, v >> 8, v);
+	}
+}
+
+// configurations the hardware refuses with CEIF, those the model can meet
+static bool config_error(uint32_t mode, uint32_t width, uint32_t height) {
+	uint32_t fg_cm = regs.FGPFCCR & DMA2D_FGPFCCR_CM_Msk;
+	uint32_t bg_cm = regs.BGPFCCR & DMA2D_FGPFCCR_CM_Msk;
+	bool fg = mode != MODE_R2M;
+	bool bg = mode == MODE_M2M_BLEND;
+
+	if (mode > MODE_R2M || width == 0 || height == 0
+			|| output_bits(regs.OPFCCR & DMA2D_OPFCCR_CM_Msk) == 0) {
+		return true;
+	}
+	if ((fg && input_bits(fg_cm) == 0) || (bg && input_bits(bg_cm) == 0)) {
+		return true;
+	}
+	// a 4-bit line has to start on a byte
+	if (fg && fg_cm == DMA2D_INPUT_A4 && ((width + regs.FGOR) & 1)) {
+		return true;
+	}
+	if (bg && bg_cm == DMA2D_INPUT_A4 && ((width + regs.BGOR) & 1)) {
+		return true;
+	}
+	return false;
+}
+
+// the pixels of the transfer started now; the time it takes
+static uint64_t run(void) {
+	uint32_t mode = (regs.CR & DMA2D_CR_MODE_Msk) >> DMA2D_CR_MODE_Pos;
+	uint32_t width = (regs.NLR & DMA2D_NLR_PL_Msk) >> DMA2D_NLR_PL_Pos;
+	uint32_t height = (regs.NLR & DMA2D_NLR_NL_Msk) >> DMA2D_NLR_NL_Pos;
+	uint32_t out_cm = regs.OPFCCR & DMA2D_OPFCCR_CM_Msk;
+	uint32_t out_bytes = output_bits(out_cm) / 8;
+
+	for (uint32_t y = 0; y < height; y++) {
+		uint8_t *out = address(regs.OMAR)
+				+ (uint64_t) y * (width + regs.OOR) * out_bytes;
+
+		for (uint32_t x = 0; x < width; x++, out += out_bytes) {
+			argb_t c;
+
+			if (mode == MODE_R2M) {
+				c = output_color(out_cm, regs.OCOLR);
+			} else if (mode == MODE_M2M
+					&& input_bits(regs.FGPFCCR & DMA2D_FGPFCCR_CM_Msk)
+							== out_bytes * 8) {
+				// no PFC, the bytes as they are
+				const uint8_t *in = address(regs.FGMAR)
+						+ ((uint64_t) y * (width + regs.FGOR) + x) * out_bytes;
+				for (uint32_t i = 0; i < out_bytes; i++) {
+					out[i] = in[i];
+				}
+				continue;
+			} else {
+				c = fetch(regs.FGMAR, regs.FGOR, regs.FGPFCCR, regs.FGCOLR, width,
+						x, y);
+				if (mode == MODE_M2M_BLEND) {
+					c = blend(c, fetch(regs.BGMAR, regs.BGOR, regs.BGPFCCR,
+							regs.BGCOLR, width, x, y));
+				}
+			}
+			if (regs.OPFCCR & (1U << DMA2D_OPFCCR_RBS_Pos)) {
+				uint8_t r = c.r;
+				c.r = c.b;
+				c.b = r;
+			}
+			store(out, out_cm, c);
+		}
+	}
+
+	uint32_t bits = out_bytes * 8;
+	if (mode != MODE_R2M) {
+		bits += input_bits(regs.FGPFCCR & DMA2D_FGPFCCR_CM_Msk);
+	}
+	if (mode == MODE_M2M_BLEND) {
+		bits += input_bits(regs.BGPFCCR & DMA2D_FGPFCCR_CM_Msk);
+	}
+	uint64_t line_ns = (uint64_t) width * bits * DMA2D_BYTE_NS / 8;
+
+	host_ltdc_check_write(regs.OMAR, height, host_time_ns() + DMA2D_SETUP_NS,
+			line_ns);
+	stats.transfers++;
+	stats.by_mode[mode]++;
+	stats.pixels += (uint64_t) width * height;
+	return DMA2D_SETUP_NS + line_ns * height;
+}
+
+// the interrupt, for the flags it is enabled for
+static void interrupt(void) {
+	if (((regs.ISR & DMA2D_ISR_TCIF) && (regs.CR & DMA2D_CR_TCIE))
+			|| ((regs.ISR & DMA2D_ISR_CEIF) && (regs.CR & DMA2D_CR_CEIE))) {
+		HAL_DMA2D_IRQHandler(&hdma2d);
+	}
+}
+
+// IFCR written and START set since the last access
+static void update(void) {
+	static bool checked;
+
+	if (!checked) {
+		checked = true;
+		if ((uintptr_t) &regs > UINT32_MAX) {
+			fprintf(stderr, "host_dma2d: statics above 4 GiB, link with "
+					"-no-pie\n");
+			exit(1);
+		}
+	}
+
+	if (regs.IFCR != 0) {
+		regs.ISR &= ~regs.IFCR;
+		regs.IFCR = 0;
+	}
+	if ((regs.CR & DMA2D_CR_START) && !busy) {
+		uint32_t mode = (regs.CR & DMA2D_CR_MODE_Msk) >> DMA2D_CR_MODE_Pos;
+		uint32_t width = (regs.NLR & DMA2D_NLR_PL_Msk) >> DMA2D_NLR_PL_Pos;
+		uint32_t height = (regs.NLR & DMA2D_NLR_NL_Msk) >> DMA2D_NLR_NL_Pos;
+
+		if (config_error(mode, width, height)) {
+			regs.CR &= ~DMA2D_CR_START;
+			regs.ISR |= DMA2D_ISR_CEIF;
+			stats.config_errors++;
+			interrupt();
+			return;
+		}
+		uint64_t ns = run();
+		busy = true;
+		busy_end = host_time_ns() + ns;
+		stats.busy_ns += ns;
+	}
+}
+
+DMA2D_TypeDef* host_dma2d(void) {
+	update();
+	if (busy) {
+		uint64_t start = host_time_ns();
+
+		while (busy) {
+			host_wait(busy_end);
+		}
+		stats.wait_ns += host_time_ns() - start;
+	}
+	return &regs;
+}
+
+uint64_t host_dma2d_next_event(void) {
+	update();
+	return busy ? busy_end : UINT64_MAX;
+}
+
+void host_dma2d_event(void) {
+	busy = false;
+	regs.CR &= ~DMA2D_CR_START;
+	regs.ISR |= DMA2D_ISR_TCIF;
+	interrupt();
+}
+
+void HAL_DMA2D_IRQHandler(DMA2D_HandleTypeDef *hdma2d) {
+	if ((regs.ISR & DMA2D_ISR_CEIF) && (regs.CR & DMA2D_CR_CEIE)) {
+		regs.CR &= ~DMA2D_CR_CEIE;
+		regs.ISR &= ~DMA2D_ISR_CEIF;
+		hdma2d->State = HAL_DMA2D_STATE_READY;
+		if (hdma2d->XferErrorCallback != NULL) {
+			hdma2d->XferErrorCallback(hdma2d);
+		}
+	}
+	if ((regs.ISR & DMA2D_ISR_TCIF) && (regs.CR & DMA2D_CR_TCIE)) {
+		regs.CR &= ~DMA2D_CR_TCIE;
+		regs.ISR &= ~DMA2D_ISR_TCIF;
+		hdma2d->State = HAL_DMA2D_STATE_READY;
+		if (hdma2d->XferCpltCallback != NULL) {
+			hdma2d->XferCpltCallback(hdma2d);
+		}
+	}
+}
+
+void host_dma2d_get_stats(host_dma2d_stats_t *out) {
+	*out = stats;
+}
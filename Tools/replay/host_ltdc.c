@@ -0,0 +1,417 @@
+/*
+ * host_ltdc.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ *
+ * LTDC model, see host/ltdc.h. Lines are counted as CPSR counts them, from
+ * the start of vertical sync, TotalHeigh + 1 to a frame; the first visible
+ * line is AccumulatedVBP + 1 and vertical blanking starts after
+ * AccumulatedActiveH. Layers are blended as the LTDC does with constant
+ * alpha, the pixel's alpha too for the PAxCA factors, and a colour keyed
+ * pixel is transparent; RGB565 expands to RGB888 by repeating its top bits.
+ */
+#include "ltdc.h"
+#include "host_port.h"
+#include <string.h>
+
+#define PIXEL_NS 40U // 25 MHz, PLL3 R from HSE in HAL_LTDC_MspInit
+
+LTDC_HandleTypeDef hltdc;
+
+static LTDC_TypeDef regs;
+static LTDC_Layer_TypeDef layers[2]; // as written
+static LTDC_Layer_TypeDef active[2]; // as scanned
+static host_ltdc_stats_t stats;
+
+static uint64_t line_armed_ns; // when the line interrupt was last enabled
+static bool line_armed;
+
+static uint32_t total_width(void) {
+	return ((regs.TWCR >> 16) & 0xFFFU) + 1;
+}
+
+static uint32_t total_lines(void) {
+	return (regs.TWCR & 0x7FFU) + 1;
+}
+
+static uint64_t line_ns(void) {
+	return (uint64_t) total_width() * PIXEL_NS;
+}
+
+static uint64_t frame_ns(void) {
+	return line_ns() * total_lines();
+}
+
+// CPSR line of the first visible line
+static uint32_t first_line(void) {
+	return (regs.BPCR & 0x7FFU) + 1;
+}
+
+// when the scan next starts line, at or after t
+static uint64_t line_start(uint64_t t, uint32_t line) {
+	uint64_t at = t / frame_ns() * frame_ns() + line * line_ns();
+
+	return at >= t ? at : at + frame_ns();
+}
+
+// shadow registers made active now
+static void reload(void) {
+	memcpy(active, layers, sizeof(active));
+}
+
+static void update(void) {
+	if (regs.SRCR & LTDC_SRCR_IMR) {
+		regs.SRCR &= ~LTDC_SRCR_IMR;
+		reload();
+	}
+	if (regs.ICR != 0) {
+		regs.ISR &= ~regs.ICR;
+		regs.ICR = 0;
+	}
+	if (!(regs.IER & LTDC_IER_LIE)) {
+		line_armed = false;
+	} else if (!line_armed) {
+		line_armed = true;
+		line_armed_ns = host_time_ns();
+	}
+}
+
+LTDC_TypeDef* host_ltdc(void) {
+	update();
+	if (regs.TWCR != 0) {
+		uint64_t t = host_time_ns();
+		uint32_t line = (uint32_t) (t / line_ns() % total_lines());
+		uint32_t x = (uint32_t) (t % line_ns() / PIXEL_NS);
+
+		regs.CPSR = x << LTDC_CPSR_CXPOS_Pos | line << LTDC_CPSR_CYPOS_Pos;
+	}
+	return &regs;
+}
+
+LTDC_Layer_TypeDef* host_ltdc_layer(uint32_t layer) {
+	update();
+	return &layers[layer];
+}
+
+// the line interrupt's time, UINT64_MAX if not enabled
+static uint64_t line_event(void) {
+	if (!line_armed) {
+		return UINT64_MAX;
+	}
+	// not the line the scan is in when it was enabled
+	return line_start(line_armed_ns + 1, regs.LIPCR & LTDC_LIPCR_LIPOS);
+}
+
+static uint64_t reload_event(void) {
+	if (!(regs.SRCR & LTDC_SRCR_VBR)) {
+		return UINT64_MAX;
+	}
+	return line_start(host_time_ns(), (regs.AWCR & 0x7FFU) + 1);
+}
+
+uint64_t host_ltdc_next_event(void) {
+	update();
+	if (regs.TWCR == 0) {
+		return UINT64_MAX;
+	}
+	uint64_t line = line_event();
+	uint64_t reload = reload_event();
+
+	return line < reload ? line : reload;
+}
+
+void host_ltdc_event(void) {
+	if (reload_event() <= line_event()) {
+		regs.SRCR &= ~LTDC_SRCR_VBR;
+		reload();
+		regs.ISR |= LTDC_ISR_RRIF;
+		stats.reloads++;
+	} else {
+		regs.ISR |= LTDC_ISR_LIF;
+		line_armed_ns = host_time_ns();
+		stats.line_events++;
+	}
+	if ((regs.ISR & regs.IER) & (LTDC_ISR_LIF | LTDC_ISR_RRIF)) {
+		HAL_LTDC_IRQHandler(&hltdc);
+	}
+	update();
+}
+
+void HAL_LTDC_IRQHandler(LTDC_HandleTypeDef *hltdc) {
+	if ((regs.ISR & LTDC_ISR_LIF) && (regs.IER & LTDC_IER_LIE)) {
+		regs.IER &= ~LTDC_IER_LIE;
+		regs.ISR &= ~LTDC_ISR_LIF;
+		HAL_LTDC_LineEventCallback(hltdc);
+	}
+	if ((regs.ISR & LTDC_ISR_RRIF) && (regs.IER & LTDC_IER_RRIE)) {
+		regs.IER &= ~LTDC_IER_RRIE;
+		regs.ISR &= ~LTDC_ISR_RRIF;
+		HAL_LTDC_ReloadEventCallback(hltdc);
+	}
+}
+
+__attribute__((weak)) void HAL_LTDC_ReloadEventCallback(
+		LTDC_HandleTypeDef *hltdc) {
+	(void) hltdc;
+}
+
+__attribute__((weak)) void HAL_LTDC_LineEventCallback(
+		LTDC_HandleTypeDef *hltdc) {
+	(void) hltdc;
+}
+
+/* HAL ------------------------------------------------------------------- */
+
+HAL_StatusTypeDef HAL_LTDC_Init(LTDC_HandleTypeDef *hltdc) {
+	const LTDC_InitTypeDef *init = &hltdc->Init;
+
+	hltdc->Instance = &regs;
+	regs.SSCR = init->HorizontalSync << 16 | init->VerticalSync;
+	regs.BPCR = init->AccumulatedHBP << 16 | init->AccumulatedVBP;
+	regs.AWCR = init->AccumulatedActiveW << 16 | init->AccumulatedActiveH;
+	regs.TWCR = init->TotalWidth << 16 | init->TotalHeigh;
+	regs.BCCR = (uint32_t) init->Backcolor.Red << 16
+			| (uint32_t) init->Backcolor.Green << 8 | init->Backcolor.Blue;
+	regs.GCR |= LTDC_GCR_LTDCEN;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_ConfigLayer(LTDC_HandleTypeDef *hltdc,
+		LTDC_LayerCfgTypeDef *pLayerCfg, uint32_t LayerIdx) {
+	LTDC_Layer_TypeDef *layer = &layers[LayerIdx];
+	uint32_t ahbp = (regs.BPCR >> 16) & 0xFFFU;
+	uint32_t avbp = regs.BPCR & 0x7FFU;
+	uint32_t bytes = pLayerCfg->PixelFormat == LTDC_PIXEL_FORMAT_ARGB8888 ? 4 :
+			pLayerCfg->PixelFormat == LTDC_PIXEL_FORMAT_RGB888 ? 3 : 2;
+
+	hltdc->LayerCfg[LayerIdx] = *pLayerCfg;
+	layer->WHPCR = (pLayerCfg->WindowX1 + ahbp) << 16
+			| (pLayerCfg->WindowX0 + ahbp + 1);
+	layer->WVPCR = (pLayerCfg->WindowY1 + avbp) << 16
+			| (pLayerCfg->WindowY0 + avbp + 1);
+	layer->PFCR = pLayerCfg->PixelFormat;
+	layer->CACR = pLayerCfg->Alpha;
+	layer->DCCR = pLayerCfg->Alpha0 << 24
+			| (uint32_t) pLayerCfg->Backcolor.Red << 16
+			| (uint32_t) pLayerCfg->Backcolor.Green << 8
+			| pLayerCfg->Backcolor.Blue;
+	layer->BFCR = pLayerCfg->BlendingFactor1 | pLayerCfg->BlendingFactor2;
+	layer->CFBAR = pLayerCfg->FBStartAdress;
+	layer->CFBLR = (pLayerCfg->ImageWidth * bytes) << 16
+			| (pLayerCfg->ImageWidth * bytes + 3);
+	layer->CFBLNR = pLayerCfg->ImageHeight;
+	layer->CR |= LTDC_LxCR_LEN;
+	regs.SRCR = LTDC_SRCR_IMR;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_ConfigColorKeying(LTDC_HandleTypeDef *hltdc,
+		uint32_t RGBValue, uint32_t LayerIdx) {
+	(void) hltdc;
+	layers[LayerIdx].CKCR = RGBValue;
+	regs.SRCR = LTDC_SRCR_IMR;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_EnableColorKeying(LTDC_HandleTypeDef *hltdc,
+		uint32_t LayerIdx) {
+	(void) hltdc;
+	layers[LayerIdx].CR |= LTDC_LxCR_COLKEN;
+	regs.SRCR = LTDC_SRCR_IMR;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_SetAddress_NoReload(LTDC_HandleTypeDef *hltdc,
+		uint32_t Address, uint32_t LayerIdx) {
+	hltdc->LayerCfg[LayerIdx].FBStartAdress = Address;
+	layers[LayerIdx].CFBAR = Address;
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_Reload(LTDC_HandleTypeDef *hltdc,
+		uint32_t ReloadType) {
+	(void) hltdc;
+	regs.IER |= LTDC_IER_RRIE;
+	regs.SRCR = ReloadType;
+	update();
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_LTDC_ProgramLineEvent(LTDC_HandleTypeDef *hltdc,
+		uint32_t Line) {
+	(void) hltdc;
+	regs.IER &= ~LTDC_IER_LIE;
+	update();
+	regs.LIPCR = Line;
+	regs.IER |= LTDC_IER_LIE;
+	update();
+	return HAL_OK;
+}
+
+/* Host ------------------------------------------------------------------ */
+
+void host_ltdc_init(uint32_t fb) {
+	LTDC_LayerCfgTypeDef layer = { 0 };
+
+	// as MX_LTDC_Init in ltdc.c
+	hltdc.Init.HSPolarity = LTDC_HSPOLARITY_AL;
+	hltdc.Init.VSPolarity = LTDC_VSPOLARITY_AL;
+	hltdc.Init.DEPolarity = LTDC_DEPOLARITY_AL;
+	hltdc.Init.PCPolarity = LTDC_PCPOLARITY_IPC;
+	hltdc.Init.HorizontalSync = 3;
+	hltdc.Init.VerticalSync = 3;
+	hltdc.Init.AccumulatedHBP = 11;
+	hltdc.Init.AccumulatedVBP = 11;
+	hltdc.Init.AccumulatedActiveW = 811;
+	hltdc.Init.AccumulatedActiveH = 491;
+	hltdc.Init.TotalWidth = 819;
+	hltdc.Init.TotalHeigh = 499;
+	HAL_LTDC_Init(&hltdc);
+
+	layer.WindowX0 = 0;
+	layer.WindowX1 = 800;
+	layer.WindowY0 = 0;
+	layer.WindowY1 = 480;
+	layer.PixelFormat = LTDC_PIXEL_FORMAT_RGB565;
+	layer.Alpha = 255;
+	layer.Alpha0 = 0;
+	layer.BlendingFactor1 = LTDC_BLENDING_FACTOR1_CA;
+	layer.BlendingFactor2 = LTDC_BLENDING_FACTOR2_CA;
+	layer.FBStartAdress = fb;
+	layer.ImageWidth = 800;
+	layer.ImageHeight = 480;
+	HAL_LTDC_ConfigLayer(&hltdc, &layer, 0);
+	update();
+}
+
+void host_ltdc_check_write(uint32_t address, uint32_t lines,
+		uint64_t start_ns, uint64_t write_ns) {
+	if (regs.TWCR == 0 || lines == 0) {
+		return;
+	}
+	for (uint32_t i = 0; i < 2; i++) {
+		const LTDC_Layer_TypeDef *layer = &active[i];
+		uint32_t fb_pitch = layer->CFBLR >> 16;
+		uint32_t fb_size = fb_pitch * layer->CFBLNR;
+
+		if (!(layer->CR & LTDC_LxCR_LEN) || fb_pitch == 0
+				|| address < layer->CFBAR || address >= layer->CFBAR + fb_size) {
+			continue;
+		}
+
+		// screen lines, as CPSR counts them, of the rows written; a transfer
+		// into a framebuffer has its pitch
+		uint32_t row = (address - layer->CFBAR) / fb_pitch;
+		uint32_t line = (layer->WVPCR & 0x7FFU) + row;
+		uint64_t frame = start_ns / frame_ns();
+		bool torn = false;
+
+		for (uint64_t f = frame; f <= frame + 1 && !torn; f++) {
+			bool shown_old = false;
+			bool shown_new = false;
+
+			for (uint32_t k = 0; k < lines; k++) {
+				uint64_t written = start_ns + (uint64_t) (k + 1) * write_ns;
+				uint64_t read = f * frame_ns() + (uint64_t) (line + k) * line_ns();
+
+				if (read < written) {
+					shown_old = true;
+				} else {
+					shown_new = true;
+				}
+			}
+			torn = shown_old && shown_new;
+		}
+		stats.writes++;
+		stats.torn += torn;
+	}
+}
+
+uint64_t host_ltdc_frames(void) {
+	return regs.TWCR == 0 ? 0 : host_time_ns() / frame_ns();
+}
+
+void host_ltdc_size(uint32_t *width, uint32_t *height) {
+	*width = regs.TWCR == 0 ? 0 :
+			((regs.AWCR >> 16) & 0xFFFU) - ((regs.BPCR >> 16) & 0xFFFU);
+	*height = regs.TWCR == 0 ? 0 : (regs.AWCR & 0x7FFU) - (regs.BPCR & 0x7FFU);
+}
+
+static uint8_t expand(uint32_t v, uint32_t bits) {
+	return (uint8_t) (v << (8 - bits) | v >> (2 * bits - 8));
+}
+
+void host_ltdc_compose(uint8_t *rgb) {
+	uint32_t width;
+	uint32_t height;
+	uint32_t x0 = ((regs.BPCR >> 16) & 0xFFFU) + 1;
+	uint32_t y0 = first_line();
+
+	update();
+	host_ltdc_size(&width, &height);
+	for (uint32_t y = 0; y < height; y++) {
+		for (uint32_t x = 0; x < width; x++) {
+			uint8_t *out = &rgb[(y * width + x) * 3];
+
+			out[0] = (uint8_t) (regs.BCCR >> 16);
+			out[1] = (uint8_t) (regs.BCCR >> 8);
+			out[2] = (uint8_t) regs.BCCR;
+
+			for (uint32_t i = 0; i < 2; i++) {
+				const LTDC_Layer_TypeDef *layer = &active[i];
+				uint32_t sx = x + x0;
+				uint32_t sy = y + y0;
+
+				if (!(layer->CR & LTDC_LxCR_LEN) || sx < (layer->WHPCR & 0xFFFU)
+						|| sx > (layer->WHPCR >> 16)
+						|| sy < (layer->WVPCR & 0x7FFU)
+						|| sy > (layer->WVPCR >> 16)) {
+					continue;
+				}
+
+				uint32_t col = sx - (layer->WHPCR & 0xFFFU);
+				uint32_t row = sy - (layer->WVPCR & 0x7FFU);
+				uint32_t pitch = layer->CFBLR >> 16;
+				uint32_t a = 0xFF;
+				uint32_t r;
+				uint32_t g;
+				uint32_t b;
+				const uint8_t *p;
+
+				if (row >= layer->CFBLNR) {
+					continue;
+				}
+				p = (const uint8_t*) (uintptr_t) layer->CFBAR + row * pitch;
+				if (layer->PFCR == LTDC_PIXEL_FORMAT_ARGB8888) {
+					p += col * 4;
+					a = p[3], r = p[2], g = p[1], b = p[0];
+				} else if (layer->PFCR == LTDC_PIXEL_FORMAT_RGB888) {
+					p += col * 3;
+					r = p[2], g = p[1], b = p[0];
+				} else {
+					uint32_t v;
+
+					p += col * 2;
+					v = (uint32_t) p[0] | (uint32_t) p[1] << 8;
+					r = expand(v >> 11, 5);
+					g = expand((v >> 5) & 0x3F, 6);
+					b = expand(v & 0x1F, 5);
+				}
+				if ((layer->CR & LTDC_LxCR_COLKEN)
+						&& (r << 16 | g << 8 | b) == (layer->CKCR & 0xFFFFFFU)) {
+					continue;
+				}
+				a = (layer->BFCR & 0x700U) == LTDC_BLENDING_FACTOR1_PAxCA ?
+						a * (layer->CACR & 0xFFU) / 255 : layer->CACR & 0xFFU;
+				out[0] = (uint8_t) ((r * a + out[0] * (255 - a)) / 255);
+				out[1] = (uint8_t) ((g * a + out[1] * (255 - a)) / 255);
+				out[2] = (uint8_t) ((b * a + out[2] * (255 - a)) / 255);
+			}
+		}
+	}
+}
+
+void host_ltdc_get_stats(host_ltdc_stats_t *out) {
+	*out = stats;
+}
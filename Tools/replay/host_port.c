@@ -0,0 +1,322 @@
+/*
+ * host_port.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+#include "host_port.h"
+#include "fdcan.h"
+#include "FreeRTOS.h"
+#include "cmsis_os2.h"
+#include "dma2d.h"
+#include "ltdc.h"
+#include "fdcan/fdcan_handlers.h"
+#include "timing/cycles.h"
+#include "timing/timebase.h"
+#include "task.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define RX_FIFO_SIZE 3 // elements, as configured in the FDCAN message RAM
+#define STD_FILTERS_MAX 28
+#define EXT_FILTERS_MAX 8
+#define CYCLES_HZ 160000000U // SystemCoreClock
+
+FDCAN_HandleTypeDef hfdcan1;
+
+static uint64_t host_now_ns;
+static uint64_t host_wait_ns;
+
+static FDCAN_FilterTypeDef std_filters[STD_FILTERS_MAX];
+static FDCAN_FilterTypeDef ext_filters[EXT_FILTERS_MAX];
+static bool std_used[STD_FILTERS_MAX];
+static bool ext_used[EXT_FILTERS_MAX];
+static bool reject_std = false;
+static bool reject_ext = false;
+
+static can_frame_t rx_fifo[RX_FIFO_SIZE];
+static uint32_t rx_fifo_dlc[RX_FIFO_SIZE];
+static uint32_t rx_fifo_get;
+static uint32_t rx_fifo_fill;
+
+/* timebase and the hardware models' clock ------------------------------- */
+
+uint32_t timebase_us(void) {
+	return (uint32_t) (host_now_ns / 1000U);
+}
+
+// the DMA2D and LTDC events due by t, in time order, then the clock to t
+static void run_until(uint64_t t) {
+	for (;;) {
+		uint64_t dma2d = host_dma2d_next_event();
+		uint64_t ltdc = host_ltdc_next_event();
+		uint64_t next = dma2d < ltdc ? dma2d : ltdc;
+
+		if (next > t) {
+			break;
+		}
+		if (next > host_now_ns) {
+			host_now_ns = next;
+		}
+		if (dma2d == next) {
+			host_dma2d_event();
+		} else {
+			host_ltdc_event();
+		}
+	}
+	if (t > host_now_ns) {
+		host_now_ns = t;
+	}
+}
+
+void host_set_time_us(uint64_t now_us) {
+	run_until(now_us * 1000U);
+}
+
+uint64_t host_time_ns(void) {
+	return host_now_ns;
+}
+
+bool host_wait(uint64_t t_ns) {
+	uint64_t dma2d = host_dma2d_next_event();
+	uint64_t ltdc = host_ltdc_next_event();
+	uint64_t next = dma2d < ltdc ? dma2d : ltdc;
+
+	if (t_ns < next) {
+		next = t_ns;
+	}
+	if (next == UINT64_MAX) {
+		return false;
+	}
+	if (next > host_now_ns) {
+		host_wait_ns += next - host_now_ns;
+	}
+	run_until(next);
+	return true;
+}
+
+uint64_t host_waited_ns(void) {
+	return host_wait_ns;
+}
+
+/* cycle counter, the host's own time and the waits for the hardware models
+ * at the target clock rate ---------------------------------------------- */
+
+void cycles_init(void) {
+}
+
+uint32_t cycles_now(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t) (((uint64_t) ts.tv_sec * 1000000000U
+			+ (uint64_t) ts.tv_nsec + host_wait_ns) * (CYCLES_HZ / 1000000U)
+			/ 1000U);
+}
+
+uint32_t cycles_hz(void) {
+	return CYCLES_HZ;
+}
+
+/* CMSIS-RTOS2 ----------------------------------------------------------- */
+
+osThreadId_t osThreadNew(osThreadFunc_t func, void *argument,
+		const osThreadAttr_t *attr) {
+	(void) func;
+	(void) argument;
+	(void) attr;
+	return NULL;
+}
+
+osThreadId_t osThreadGetId(void) {
+	static int thread; // the one the replay runs everything on
+
+	return &thread;
+}
+
+uint32_t osThreadFlagsSet(osThreadId_t thread_id, uint32_t flags) {
+	(void) thread_id;
+	return flags;
+}
+
+uint32_t osThreadFlagsClear(uint32_t flags) {
+	(void) flags;
+	return 0;
+}
+
+// the interrupt the task waits for is one of the models', so let them run
+// to their next event; the flags are not kept, the callers recheck
+uint32_t osThreadFlagsWait(uint32_t flags, uint32_t options, uint32_t timeout) {
+	(void) options;
+	host_wait(timeout == osWaitForever ? UINT64_MAX :
+			host_now_ns + (uint64_t) timeout * 1000000U / configTICK_RATE_HZ
+					* 1000U);
+	return flags;
+}
+
+osStatus_t osDelay(uint32_t ticks) {
+	(void) ticks;
+	return osOK;
+}
+
+/* HAL ------------------------------------------------------------------- */
+
+void Error_Handler(void) {
+	fprintf(stderr, "Error_Handler\n");
+	exit(1);
+}
+
+/* FreeRTOS -------------------------------------------------------------- */
+
+uint32_t ulTaskGetIdleRunTimeCounter(void) {
+	return 0; // no idle task on the host, the idle share reads 0 %
+}
+
+/* FDCAN ----------------------------------------------------------------- */
+
+static uint32_t len_to_dlc(uint8_t len) {
+	static const uint8_t fd_lengths[] = { 12, 16, 20, 24, 32, 48, 64 };
+
+	if (len <= 8) {
+		return len;
+	}
+	for (uint32_t i = 0; i < sizeof(fd_lengths); i++) {
+		if (len <= fd_lengths[i]) {
+			return 9 + i;
+		}
+	}
+	return 15;
+}
+
+static bool filter_match(const FDCAN_FilterTypeDef *f, uint32_t id) {
+	switch (f->FilterType) {
+	case FDCAN_FILTER_RANGE:
+		return id >= f->FilterID1 && id <= f->FilterID2;
+	case FDCAN_FILTER_DUAL:
+		return id == f->FilterID1 || id == f->FilterID2;
+	case FDCAN_FILTER_MASK:
+		return (id & f->FilterID2) == (f->FilterID1 & f->FilterID2);
+	default:
+		return false;
+	}
+}
+
+static bool accepted(const can_frame_t *frame) {
+	const FDCAN_FilterTypeDef *filters =
+			frame->extended ? ext_filters : std_filters;
+	const bool *used = frame->extended ? ext_used : std_used;
+	uint32_t count =
+			frame->extended ?
+					hfdcan1.Init.ExtFiltersNbr : hfdcan1.Init.StdFiltersNbr;
+
+	for (uint32_t i = 0; i < count; i++) {
+		if (used[i] && filters[i].FilterConfig == FDCAN_FILTER_TO_RXFIFO0
+				&& filter_match(&filters[i], frame->id)) {
+			return true;
+		}
+	}
+	return frame->extended ? !reject_ext : !reject_std;
+}
+
+void host_fdcan_init(void) {
+	memset(&hfdcan1, 0, sizeof(hfdcan1));
+	hfdcan1.Init.StdFiltersNbr = STD_FILTERS_MAX;
+	hfdcan1.Init.ExtFiltersNbr = EXT_FILTERS_MAX;
+}
+
+bool host_fdcan_receive(const can_frame_t *frame) {
+	can_frame_t padded = *frame;
+
+	memset(padded.data + frame->len, 0, sizeof(padded.data) - frame->len);
+	return host_fdcan_receive_dlc(&padded, len_to_dlc(frame->len));
+}
+
+bool host_fdcan_receive_dlc(const can_frame_t *frame, uint32_t dlc) {
+	uint32_t its = FDCAN_IT_RX_FIFO0_NEW_MESSAGE;
+
+	if (!accepted(frame)) {
+		return false;
+	}
+
+	if (rx_fifo_fill == RX_FIFO_SIZE) {
+		its |= FDCAN_IT_RX_FIFO0_MESSAGE_LOST;
+	} else {
+		uint32_t put = (rx_fifo_get + rx_fifo_fill) % RX_FIFO_SIZE;
+
+		rx_fifo[put] = *frame;
+		rx_fifo_dlc[put] = dlc & 0xFU;
+		rx_fifo_fill++;
+	}
+
+	HAL_FDCAN_IRQHandler(&hfdcan1);
+	HAL_FDCAN_RxFifo0Callback(&hfdcan1, its);
+	return true;
+}
+
+void HAL_FDCAN_IRQHandler(FDCAN_HandleTypeDef *hfdcan) {
+	(void) hfdcan;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigFilter(FDCAN_HandleTypeDef *hfdcan,
+		const FDCAN_FilterTypeDef *sFilterConfig) {
+	bool extended = sFilterConfig->IdType == FDCAN_EXTENDED_ID;
+	uint32_t count =
+			extended ? hfdcan->Init.ExtFiltersNbr : hfdcan->Init.StdFiltersNbr;
+
+	if (sFilterConfig->FilterIndex >= count) {
+		return HAL_ERROR;
+	}
+	if (extended) {
+		ext_filters[sFilterConfig->FilterIndex] = *sFilterConfig;
+		ext_used[sFilterConfig->FilterIndex] = true;
+	} else {
+		std_filters[sFilterConfig->FilterIndex] = *sFilterConfig;
+		std_used[sFilterConfig->FilterIndex] = true;
+	}
+	return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_ConfigGlobalFilter(FDCAN_HandleTypeDef *hfdcan,
+		uint32_t NonMatchingStd, uint32_t NonMatchingExt,
+		uint32_t RejectRemoteStd, uint32_t RejectRemoteExt) {
+	(void) hfdcan;
+	(void) RejectRemoteStd;
+	(void) RejectRemoteExt;
+	reject_std = NonMatchingStd == FDCAN_REJECT;
+	reject_ext = NonMatchingExt == FDCAN_REJECT;
+	return HAL_OK;
+}
+
+uint32_t HAL_FDCAN_GetRxFifoFillLevel(const FDCAN_HandleTypeDef *hfdcan,
+		uint32_t RxFifo) {
+	(void) hfdcan;
+	return RxFifo == FDCAN_RX_FIFO0 ? rx_fifo_fill : 0;
+}
+
+HAL_StatusTypeDef HAL_FDCAN_GetRxMessage(FDCAN_HandleTypeDef *hfdcan,
+		uint32_t RxLocation, FDCAN_RxHeaderTypeDef *pRxHeader,
+		uint8_t *pRxData) {
+	(void) hfdcan;
+
+	if (RxLocation != FDCAN_RX_FIFO0 || rx_fifo_fill == 0) {
+		return HAL_ERROR;
+	}
+
+	const can_frame_t *frame = &rx_fifo[rx_fifo_get];
+	uint32_t dlc = rx_fifo_dlc[rx_fifo_get];
+
+	memset(pRxHeader, 0, sizeof(*pRxHeader));
+	pRxHeader->Identifier = frame->id;
+	pRxHeader->IdType = frame->extended ? FDCAN_EXTENDED_ID : FDCAN_STANDARD_ID;
+	pRxHeader->DataLength = dlc;
+	pRxHeader->FDFormat = frame->fd ? FDCAN_FD_CAN : FDCAN_CLASSIC_CAN;
+	pRxHeader->BitRateSwitch = frame->brs ? FDCAN_BRS_ON : FDCAN_BRS_OFF;
+	// the HAL copies as many bytes as the DLC codes in an FD frame, classic
+	// or not
+	memcpy(pRxData, frame->data, can_dlc_to_len(dlc, true));
+
+	rx_fifo_get = (rx_fifo_get + 1) % RX_FIFO_SIZE;
+	rx_fifo_fill--;
+	return HAL_OK;
+}
@@ -0,0 +1,53 @@
+/*
+ * host_port.h
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ */
+
+#ifndef TOOLS_REPLAY_HOST_PORT_H_
+#define TOOLS_REPLAY_HOST_PORT_H_
+
+#include "fdcan/can_rx_ring.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Host side of the replay: a simulated clock behind timebase_us(), the host's
+ * own clock behind cycles_now() for the render profile, and an
+ * FDCAN model with the firmware's message RAM filter lists and a 3 element
+ * RX FIFO that calls the real HAL_FDCAN_RxFifo0Callback().
+ *
+ * The simulated clock also times the DMA2D and LTDC models (host/dma2d.h,
+ * host/ltdc.h): their transfers, scan lines and interrupts happen at model
+ * times, in order, as the clock passes them. The replay moves it on with the
+ * log; the firmware moves it on when it waits for the hardware, and
+ * cycles_now() counts that wait too. The CPU's own work takes no model time.
+ */
+
+/* Initialise the FDCAN model like MX_FDCAN1_Init (filter list sizes) */
+void host_fdcan_init(void);
+
+/* Move the clock on to now_us, running the hardware events due by then;
+ * it does not go back */
+void host_set_time_us(uint64_t now_us);
+
+uint64_t host_time_ns(void);
+
+/* The CPU waits until t_ns or the next hardware event, whichever is first.
+ * Returns false, without waiting, if no event is due and t_ns is never */
+bool host_wait(uint64_t t_ns);
+
+/* Model time the CPU spent in host_wait() */
+uint64_t host_waited_ns(void);
+
+/* Put one frame on the simulated bus. Returns false if the acceptance
+ * filters dropped it; otherwise it went through the RX interrupt. */
+bool host_fdcan_receive(const can_frame_t *frame);
+
+/* The same with the DLC code as sent, which classic frames may set to 9..15
+ * for 8 bytes. The controller's message RAM holds the frame's data up to the
+ * DLC's FD length, whatever the frame's len. */
+bool host_fdcan_receive_dlc(const can_frame_t *frame, uint32_t dlc);
+
+#endif /* TOOLS_REPLAY_HOST_PORT_H_ */
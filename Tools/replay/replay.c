@@ -0,0 +1,1916 @@
+/*
+ * replay.c
+ *
+ *  Created on: 17/10/2026
+ *      Author:
+ *
+ * Offline CAN log replay for the dashboard on a Linux host.
+ *
+ *     replay [-s speed] [-q] [-p] [-1] [-n] [-r profile.bin] log
+ *                                         replay a log
+ *     replay -d [-s speed] [-q] [-n] [-r profile.bin] [-o prefix] log
+ *                                         replay it through the display port
+ *     replay -c out.bin log               convert a log to the binary form
+ *     replay -g                           check the DMA2D letters
+ *     replay -a                           benchmark the gauge and readout
+ *     replay -f                           check and benchmark label_text.c
+ *     replay -t                           benchmark the screens' updates
+ *     replay -x                           stress the CAN receive path
+ *     replay -e                           check and benchmark the decoder
+ *     replay -i                           check the FDCAN filter planning
+ *     replay -l                           torture the telemetry seqlock
+ *
+ * Frames go through the real receive path (HAL_FDCAN_RxFifo0Callback, the
+ * RX ring and the table decoder) and the GUI loop runs gui_task_step() and
+ * lv_timer_handler() every 10 ms of log time, rendering the screens in
+ * software. -s 1 (default) replays in real time, -s N at N times speed and
+ * -s 0 as fast as possible. -p renders like the firmware's MY_DISP_PARTIAL
+ * display port instead of its double framebuffer mode, -1 without the LTDC
+ * layer 1 overlay display (MY_DISP_OVERLAY 0), -n without the static chrome
+ * cache (gui/chrome_cache.c). Afterwards decode throughput, GUI update cost,
+ * screen switch time, the frame time distribution, the redrawn area per
+ * frame, the area copied between the two framebuffers, the pixels drawn
+ * from the chrome cache's snapshots, or by the same widgets live with -n,
+ * and the LVGL heap use, now and at its peak, are printed.
+ *
+ * Copies into a framebuffer that is on screen (the overlay, and layer 0 with
+ * -p) run through the firmware's beam racing (gui/scanout.c) against a model
+ * of the LTDC scan and DMA2D copy timing, which counts the copies that would
+ * show a torn frame with and without it.
+ *
+ * -r writes a render profile record (gui/render_profile.h) per second of log
+ * time, as the firmware sends them on USART1, for Tools/render_profile.py.
+ * Draw calls are timed on the host; flushes and waits for the beam are the
+ * model's.
+ *
+ * -d runs the firmware's display port (Core/Src/lvgl_port_display.c) instead
+ * of the replay's stand-in, in the configuration the Makefile's PORT_DEFS
+ * built it with, on the DMA2D and LTDC register models (host_dma2d.c,
+ * host_ltdc.c). Its flushes, page flips, beam waits and interrupts run as on
+ * the target in model time, and the summary adds what the two models saw:
+ * transfers, the time DMA2D was busy and the CPU waited for it, frames
+ * scanned out and DMA2D writes that a frame showed half done. CPU work takes
+ * no model time. -o writes the frame the LTDC composes from its layers to
+ * <prefix>NNNN.png every second of log time and at the end.
+ *
+ * -a puts a gauge (gui/gauge.c) and the lv_arc, container and two labels it
+ * replaced on a screen in turn, with the dashboard's styles, and the battery
+ * temperature as a readout (gui/readout.c) and as the label it replaced, and
+ * prints the objects and LVGL heap each takes, then walks them through the
+ * same values: pixels redrawn, time to set a value and time to refresh per
+ * update, and the same for 99 to 100. Heap sizes are the host's, with 64 bit
+ * pointers. Then the gauge past both ends of its range, which fails unless
+ * its numerals show the value and its sweep stops at the end.
+ *
+ * -f formats every raw value of the pre-drive screen's voltages, and its
+ * negation, with lv_vsnprintf(), as the screen did, and with
+ * gui/label_text.c, fails if any text differs, and prints the time and host
+ * cycles (the TSC on x86) per call of each, then the same for a whole label
+ * update.
+ *
+ * -t builds the screens as the dashboard does and shows the pre-drive and
+ * drive screens in turn, updating every widget with the same made-up
+ * telemetry: pixels redrawn, time to update and time to refresh per update.
+ *
+ * -x puts frames back to back at 1 Mbit/s, in real time, through the
+ * firmware's acceptance filters, the FDCAN model's RX FIFO and the real RX
+ * interrupt callback while another thread decodes them with can_rx_process(),
+ * held off for 5 ms every 20 ms. Extended frames carry every priority in
+ * turn. It fails unless every frame passes the filters and is decoded once
+ * and in order, with no FIFO or ring losses (can_check.c).
+ *
+ * -e first sends a classic and an FD frame of every DLC code through the
+ * FDCAN model and the RX interrupt, and decodes what it queued with a
+ * database of one 64-byte message. It fails unless the frame keeps its
+ * length (8 bytes for classic DLC 9 to 15), signals ending at each FD length
+ * and at byte 63 decode, and those past a shorter frame's end are left
+ * alone. Then it decodes random payloads of every message in can_db.c with
+ * can_decode() and with the hand-written switch it replaced, the extended
+ * ones with random priority bits, fails if a frame is not found or any
+ * telemetry field comes out different beyond float rounding and the table's
+ * saturation, and prints the time per frame of each.
+ *
+ * -i plans filters (fdcan/can_filter.c) for random sets of 11 and 29 bit IDs
+ * in runs, on banks of 1 to 32 filters, and fails unless every ID is
+ * accepted, the plan fits the bank, and it accepts nothing else whenever the
+ * bank holds the IDs' runs. Extended IDs matched on their low 25 bits, as
+ * the firmware's are, must get mask filters that accept them with any
+ * priority bits and, with room, no more than each run's aligned block. Sets with more runs than the planner keeps and
+ * banks too small for the runs must both come up.
+ *
+ * -l has a writer thread put one count into paired telemetry fields
+ * (battery.pack_voltage and pack_current, and others from inv1 to the last
+ * signal timestamp) between telemetry_write_begin() and _end(), in bursts and
+ * sometimes preempted halfway, while two readers take telemetry_snapshot()s
+ * for a second. It fails if a snapshot mixes two writes or goes back in
+ * time, or if the same readers copying without the lock never see a torn
+ * write.
+ *
+ * -g draws the letters of the dashboard's fonts through gui/glyph_dma2d.c and
+ * the DMA2D register model (host_dma2d.c) and through LVGL, and fails if they
+ * are more than GLYPH_CHECK_STEPS apart in any channel or a transfer is
+ * misconfigured. The replay itself draws its letters through the model too,
+ * as LVGL's DMA2D backend (LV_USE_GPU_STM32_DMA2D) does its fills and image
+ * copies.
+ *
+ * Logs are candump -l text ("(1699999999.123456) can0 123#11223344", FD
+ * frames as "123##<flags><data>") or the binary form: the magic "OUR5CAN1"
+ * followed by records of
+ *
+ *     uint32 delta_us   time since the previous record, little endian
+ *     uint32 id         bit 31 extended, bit 30 FD, bit 29 BRS
+ *     uint8  len        payload bytes
+ *     uint8  data[len]
+ */
+#include "host_port.h"
+#include "can_check.h"
+#include "fdcan/fdcan_handlers.h"
+#include "dma2d.h"
+#include "ltdc.h"
+#include "lvgl_port_display.h"
+#include "gui/binding.h"
+#include "gui/chrome_cache.h"
+#include "gui/digit_atlas.h"
+#include "gui/gauge.h"
+#include "gui/glyph_dma2d.h"
+#include "gui/gui_stats.h"
+#include "gui/gui_task.h"
+#include "gui/label_text.h"
+#include "gui/readout.h"
+#include "gui/render_profile.h"
+#include "gui/scanout.h"
+#include "telemetry/telemetry.h"
+#include "lvgl/lvgl.h"
+#include "lvgl/src/draw/sw/lv_draw_sw.h"
+#include "lvgl/src/misc/lv_tlsf.h"
+#include "timing/cycles.h"
+#include <ctype.h>
+#include <errno.h>
+#include <inttypes.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GUI_PERIOD_US 10000U // GuiTask osDelay
+#define PROFILE_PERIOD_US 1000000U // CAN_STATS_UART_PERIOD_MS
+#define DISP_HOR_RES 800
+#define DISP_VER_RES 480
+#define DISP_PARTIAL_LINES (DISP_VER_RES / 10) // MY_DISP_PARTIAL_LINES
+#define OVERLAY_VER_RES 200 // MY_DISP_OVERLAY_VER_RES
+#define OVERLAY_LINES 20 // MY_DISP_OVERLAY_LINES
+#define OVERLAY_Y 260 // MY_DISP_OVERLAY_Y
+
+// scan-out model: LTDC timing from ltdc.c at the 25 MHz pixel clock, render
+// and DMA2D costs estimated for the target
+#define SCAN_LINE_NS 32800U // 820 pixel clocks
+#define SCAN_TOTAL_LINES 500U // hltdc.Init.TotalHeigh + 1
+#define SCAN_FRAME_NS ((uint64_t) SCAN_LINE_NS * SCAN_TOTAL_LINES)
+#define RENDER_PX_NS 20U
+#define DMA2D_PX_NS 12U // RGB565 to RGB565
+
+// DMA2D against LVGL blending, per channel: DMA2D rounds in 8 bits and
+// truncates to 5 and 6, LVGL rounds in 5 and 6
+#define GLYPH_CHECK_STEPS 2
+
+#define GAUGE_BENCH_UPDATES 5000
+#define GAUGE_BENCH_MAX 150 // the speed gauge's range
+#define FORMAT_BENCH_LABELS 20000
+#define SCREEN_BENCH_UPDATES 2000
+
+#define PNG_BLOCK_MAX 65535U // bytes in a stored deflate block
+
+#define BIN_MAGIC "OUR5CAN1"
+#define BIN_MAGIC_LEN 8
+#define BIN_EXTENDED 0x80000000U
+#define BIN_FD 0x40000000U
+#define BIN_BRS 0x20000000U
+#define BIN_ID_MASK 0x1FFFFFFFU
+
+#define CAN_ERR_FLAG 0x20000000U // SocketCAN error frame marker
+
+typedef struct {
+	FILE *file;
+	bool binary;
+	uint64_t time_us; // time of the last record, binary logs
+	uint64_t first_us; // first timestamp, text logs
+	bool started;
+	uint32_t line;
+} log_reader_t;
+
+typedef struct {
+	uint32_t *ns; // or pixel counts
+	size_t count;
+	size_t capacity;
+} samples_t;
+
+static lv_color_t framebuffers[2][DISP_HOR_RES * DISP_VER_RES];
+static lv_color_t partial_bufs[2][DISP_HOR_RES * DISP_PARTIAL_LINES];
+static lv_color_t overlay_fb[DISP_HOR_RES * OVERLAY_VER_RES];
+static lv_color_t overlay_bufs[2][DISP_HOR_RES * OVERLAY_LINES];
+static bool flushed;
+static samples_t redrawn_px; // both displays, per GUI loop that drew
+static uint32_t frame_px;
+static uint64_t overlay_px;
+static uint64_t copied_px; // front to back buffer, or draw to framebuffer
+
+// the display port's callbacks, -d; [0] layer 0, [1] the overlay
+static void (*port_flush[2])(lv_disp_drv_t *disp_drv, const lv_area_t *area,
+		lv_color_t *color_p);
+static void (*port_monitor)(lv_disp_drv_t *disp_drv, uint32_t time,
+		uint32_t px);
+
+typedef struct {
+	uint64_t now_ns; // model time, the GUI loop's log time plus work done
+	uint32_t copies;
+	uint32_t waited;
+	uint64_t wait_ns;
+	uint32_t torn;
+	uint32_t torn_unscheduled; // had each copy started without waiting
+} scanout_model_t;
+
+static scanout_model_t scan;
+static void (*sw_buffer_copy)(lv_draw_ctx_t *draw_ctx, void *dest_buf,
+		lv_coord_t dest_stride, const lv_area_t *dest_area, void *src_buf,
+		lv_coord_t src_stride, const lv_area_t *src_area);
+
+/* Helpers ---------------------------------------------------------------- */
+
+static uint64_t wall_ns(void) {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t) ts.tv_sec * 1000000000U + (uint64_t) ts.tv_nsec;
+}
+
+static uint32_t ns_to_cycles(uint64_t ns) {
+	return (uint32_t) (ns * (cycles_hz() / 1000000U) / 1000U);
+}
+
+static void samples_add(samples_t *s, uint64_t ns) {
+	if (s->count == s->capacity) {
+		s->capacity = s->capacity ? 2 * s->capacity : 4096;
+		s->ns = realloc(s->ns, s->capacity * sizeof(*s->ns));
+		if (s->ns == NULL) {
+			perror("replay");
+			exit(1);
+		}
+	}
+	s->ns[s->count++] = ns > UINT32_MAX ? UINT32_MAX : (uint32_t) ns;
+}
+
+static int compare_u32(const void *a, const void *b) {
+	uint32_t x = *(const uint32_t*) a;
+	uint32_t y = *(const uint32_t*) b;
+	return (x > y) - (x < y);
+}
+
+static double percentile_us(const samples_t *s, double p) {
+	size_t i = (size_t) (p * (double) (s->count - 1) + 0.5);
+	return s->ns[i] / 1000.0;
+}
+
+static void print_redrawn(samples_t *s) {
+	uint64_t total = 0;
+
+	if (s->count == 0) {
+		printf("redrawn     no frames\n");
+		return;
+	}
+	qsort(s->ns, s->count, sizeof(*s->ns), compare_u32);
+	for (size_t i = 0; i < s->count; i++) {
+		total += s->ns[i];
+	}
+	printf("redrawn     %zu frames, %.0f px/frame, p50 %" PRIu32 ", p95 %" PRIu32
+			", max %" PRIu32 " px, %.1f Mpx total (%.1f%% of full frames)\n",
+			s->count, (double) total / s->count, s->ns[s->count / 2],
+			s->ns[(size_t) (0.95 * (s->count - 1) + 0.5)], s->ns[s->count - 1],
+			total / 1e6,
+			100.0 * total / ((double) s->count * DISP_HOR_RES * DISP_VER_RES));
+}
+
+static void print_distribution(const char *name, samples_t *s) {
+	static const uint32_t bounds_us[] = { 100, 500, 1000, 2000, 5000, 10000,
+			20000, 50000 };
+	uint64_t total = 0;
+
+	if (s->count == 0) {
+		printf("%-11s no samples\n", name);
+		return;
+	}
+	qsort(s->ns, s->count, sizeof(*s->ns), compare_u32);
+	for (size_t i = 0; i < s->count; i++) {
+		total += s->ns[i];
+	}
+
+	printf("%-11s %zu samples, mean %.1f us, p50 %.1f, p95 %.1f, p99 %.1f, "
+			"max %.1f us\n", name, s->count, total / 1000.0 / s->count,
+			percentile_us(s, 0.50), percentile_us(s, 0.95),
+			percentile_us(s, 0.99), s->ns[s->count - 1] / 1000.0);
+
+	size_t i = 0;
+	for (size_t b = 0; b <= sizeof(bounds_us) / sizeof(bounds_us[0]); b++) {
+		bool last = b == sizeof(bounds_us) / sizeof(bounds_us[0]);
+		size_t start = i;
+
+		while (i < s->count && (last || s->ns[i] < bounds_us[b] * 1000U)) {
+			i++;
+		}
+		if (i == start) {
+			continue;
+		}
+		if (last) {
+			printf("%13s>= %6" PRIu32 " us %8zu  %5.1f%%\n", "",
+					bounds_us[b - 1], i - start, 100.0 * (i - start) / s->count);
+		} else {
+			printf("%13s<  %6" PRIu32 " us %8zu  %5.1f%%\n", "", bounds_us[b],
+					i - start, 100.0 * (i - start) / s->count);
+		}
+	}
+}
+
+/* Log readers ------------------------------------------------------------ */
+
+static int hex_digit(char c) {
+	if (c >= '0' && c <= '9') {
+		return c - '0';
+	}
+	c = (char) tolower((unsigned char) c);
+	return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : -1;
+}
+
+/* Parse "(sec.frac) iface id#data" or "id##<flags>data", false to skip */
+static bool parse_candump(const char *line, uint64_t *time_us,
+		can_frame_t *frame) {
+	unsigned long long sec;
+	char frac[16];
+	char iface[32];
+	char body[300];
+
+	if (sscanf(line, " (%llu.%15[0-9]) %31s %299s", &sec, frac, iface, body)
+			!= 4) {
+		return false;
+	}
+
+	// fraction to microseconds, whatever its number of digits
+	uint64_t usec = 0;
+	for (int i = 0; i < 6; i++) {
+		usec = usec * 10 + (frac[i] != '\0' ? (uint64_t) (frac[i] - '0') : 0);
+		if (frac[i] == '\0') {
+			for (i++; i < 6; i++) {
+				usec *= 10;
+			}
+			break;
+		}
+	}
+	*time_us = sec * 1000000ULL + usec;
+
+	char *hash = strchr(body, '#');
+	if (hash == NULL) {
+		return false;
+	}
+
+	size_t id_len = (size_t) (hash - body);
+	char *end;
+	unsigned long id = strtoul(body, &end, 16);
+	if (end != hash || id_len == 0 || (id & CAN_ERR_FLAG) != 0) {
+		return false;
+	}
+
+	memset(frame, 0, sizeof(*frame));
+	frame->id = (uint32_t) id;
+	frame->extended = id_len > 3;
+
+	const char *data = hash + 1;
+	if (*data == 'R') {
+		return false; // remote frames carry no signals
+	}
+	if (*data == '#') {
+		int flags = hex_digit(data[1]);
+		if (flags < 0) {
+			return false;
+		}
+		frame->fd = true;
+		frame->brs = (flags & 0x1) != 0;
+		data += 2;
+	}
+
+	while (data[0] != '\0') {
+		if (data[0] == '.') { // optional byte separator
+			data++;
+			continue;
+		}
+		int hi = hex_digit(data[0]);
+		int lo = hex_digit(data[1]);
+		if (hi < 0 || lo < 0 || frame->len == CAN_FRAME_MAX_LEN) {
+			return false;
+		}
+		frame->data[frame->len++] = (uint8_t) (hi << 4 | lo);
+		data += 2;
+	}
+
+	return frame->fd || frame->len <= 8;
+}
+
+static uint32_t read_le32(const uint8_t *p) {
+	return (uint32_t) p[0] | (uint32_t) p[1] << 8 | (uint32_t) p[2] << 16
+			| (uint32_t) p[3] << 24;
+}
+
+static void write_le32(uint8_t *p, uint32_t v) {
+	p[0] = (uint8_t) v;
+	p[1] = (uint8_t) (v >> 8);
+	p[2] = (uint8_t) (v >> 16);
+	p[3] = (uint8_t) (v >> 24);
+}
+
+static bool log_open(log_reader_t *log, const char *path) {
+	char magic[BIN_MAGIC_LEN];
+
+	memset(log, 0, sizeof(*log));
+	log->file = fopen(path, "rb");
+	if (log->file == NULL) {
+		return false;
+	}
+
+	log->binary = fread(magic, 1, BIN_MAGIC_LEN, log->file) == BIN_MAGIC_LEN
+			&& memcmp(magic, BIN_MAGIC, BIN_MAGIC_LEN) == 0;
+	if (!log->binary) {
+		rewind(log->file);
+	}
+	return true;
+}
+
+/* Next frame and its time relative to the start of the log */
+static bool log_next(log_reader_t *log, uint64_t *time_us, can_frame_t *frame) {
+	if (log->binary) {
+		uint8_t header[9];
+
+		if (fread(header, 1, sizeof(header), log->file) != sizeof(header)) {
+			return false;
+		}
+		uint32_t id = read_le32(header + 4);
+
+		memset(frame, 0, sizeof(*frame));
+		frame->id = id & BIN_ID_MASK;
+		frame->extended = (id & BIN_EXTENDED) != 0;
+		frame->fd = (id & BIN_FD) != 0;
+		frame->brs = (id & BIN_BRS) != 0;
+		frame->len = header[8];
+		if (frame->len > CAN_FRAME_MAX_LEN
+				|| fread(frame->data, 1, frame->len, log->file) != frame->len) {
+			fprintf(stderr, "replay: truncated binary log\n");
+			return false;
+		}
+		log->time_us += read_le32(header);
+		*time_us = log->time_us;
+		return true;
+	}
+
+	char line[512];
+	while (fgets(line, sizeof(line), log->file) != NULL) {
+		uint64_t stamp;
+
+		log->line++;
+		if (!parse_candump(line, &stamp, frame)) {
+			continue;
+		}
+		if (!log->started) {
+			log->started = true;
+			log->first_us = stamp;
+		}
+		// candump logs can be slightly out of order across interfaces
+		*time_us = stamp > log->first_us ? stamp - log->first_us : 0;
+		return true;
+	}
+	return false;
+}
+
+static int convert(const char *in_path, const char *out_path) {
+	log_reader_t log;
+	FILE *out;
+	uint64_t time_us;
+	uint64_t last_us = 0;
+	can_frame_t frame;
+	uint32_t count = 0;
+
+	if (!log_open(&log, in_path)) {
+		perror(in_path);
+		return 1;
+	}
+	out = fopen(out_path, "wb");
+	if (out == NULL) {
+		perror(out_path);
+		return 1;
+	}
+
+	fwrite(BIN_MAGIC, 1, BIN_MAGIC_LEN, out);
+	while (log_next(&log, &time_us, &frame)) {
+		uint8_t header[9];
+		uint64_t delta = time_us > last_us ? time_us - last_us : 0;
+
+		if (delta > UINT32_MAX) {
+			delta = UINT32_MAX;
+		}
+		last_us += delta;
+
+		write_le32(header, (uint32_t) delta);
+		write_le32(header + 4,
+				frame.id | (frame.extended ? BIN_EXTENDED : 0)
+						| (frame.fd ? BIN_FD : 0) | (frame.brs ? BIN_BRS : 0));
+		header[8] = frame.len;
+		fwrite(header, 1, sizeof(header), out);
+		fwrite(frame.data, 1, frame.len, out);
+		count++;
+	}
+
+	fclose(log.file);
+	if (fclose(out) != 0) {
+		perror(out_path);
+		return 1;
+	}
+	printf("%" PRIu32 " frames written to %s\n", count, out_path);
+	return 0;
+}
+
+/* Scan-out model --------------------------------------------------------- */
+
+static uint32_t scan_beam(uint64_t t) {
+	return (uint32_t) (t / SCAN_LINE_NS % SCAN_TOTAL_LINES);
+}
+
+/* When the beam next reaches line, the LTDC line event */
+static uint64_t scan_time_at(uint64_t t, int32_t line) {
+	uint64_t at = t / SCAN_FRAME_NS * SCAN_FRAME_NS
+			+ (uint64_t) line * SCAN_LINE_NS;
+	return at >= t ? at : at + SCAN_FRAME_NS;
+}
+
+/*
+ * Whether a copy of screen lines y1..y2 starting at start leaves a frame
+ * showing some of them old and some new: the frame being scanned and the
+ * next one, with DMA2D writing a line every width pixels
+ */
+static bool scan_torn(uint64_t start, int32_t y1, int32_t y2,
+		lv_coord_t width) {
+	uint64_t line_ns = (uint64_t) width * DMA2D_PX_NS;
+	uint64_t frame = start / SCAN_FRAME_NS;
+
+	for (uint64_t f = frame; f <= frame + 1; f++) {
+		bool shown_old = false;
+		bool shown_new = false;
+		for (int32_t y = y1; y <= y2; y++) {
+			uint64_t written = start + (uint64_t) (y - y1 + 1) * line_ns;
+			uint64_t read = f * SCAN_FRAME_NS + (uint64_t) y * SCAN_LINE_NS;
+			if (read < written) {
+				shown_old = true;
+			} else {
+				shown_new = true;
+			}
+		}
+		if (shown_old && shown_new) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/* Render an area, wait for the beam as the display port does and copy it */
+static void scan_copy(const lv_area_t *area, int32_t y_offset) {
+	int32_t y1 = area->y1 + y_offset;
+	int32_t y2 = area->y2 + y_offset;
+	lv_coord_t width = lv_area_get_width(area);
+	uint64_t px = lv_area_get_size(area);
+	uint64_t start;
+	int32_t line;
+
+	scan.now_ns += px * RENDER_PX_NS;
+	start = scan.now_ns;
+	while ((line = scanout_copy_line(scan_beam(start), y1, y2))
+			!= SCANOUT_NOW) {
+		start = scan_time_at(start, line);
+	}
+
+	scan.copies++;
+	if (start != scan.now_ns) {
+		scan.waited++;
+		scan.wait_ns += start - scan.now_ns;
+		render_profile_record_flush_wait(ns_to_cycles(start - scan.now_ns));
+	}
+	render_profile_record_flush(ns_to_cycles(px * DMA2D_PX_NS));
+	if (scan_torn(start, y1, y2, width)) {
+		scan.torn++;
+	}
+	if (scan_torn(scan.now_ns, y1, y2, width)) {
+		scan.torn_unscheduled++;
+	}
+	scan.now_ns = start + px * DMA2D_PX_NS;
+}
+
+static int32_t scan_y_offset(lv_disp_drv_t *disp_drv) {
+	return disp_drv->user_data == overlay_fb ? OVERLAY_Y : 0;
+}
+
+/* Replay ----------------------------------------------------------------- */
+
+static void host_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area,
+		lv_color_t *color_p) {
+	(void) area;
+	(void) color_p;
+	// the page flip, which on the host is immediate; on the target it takes
+	// effect in the next vertical blanking
+	if (lv_disp_flush_is_last(disp_drv)) {
+		flushed = true;
+		render_profile_record_flush(ns_to_cycles(
+				scan_time_at(scan.now_ns, DISP_VER_RES) - scan.now_ns));
+	}
+	lv_disp_flush_ready(disp_drv);
+}
+
+/* Partial mode and the overlay: copy the rendered area into the display's
+ * framebuffer (user_data), as DMA2D does */
+static void host_flush_partial(lv_disp_drv_t *disp_drv, const lv_area_t *area,
+		lv_color_t *color_p) {
+	lv_color_t *fb = disp_drv->user_data;
+	lv_coord_t width = lv_area_get_width(area);
+
+	scan_copy(area, scan_y_offset(disp_drv));
+	copied_px += lv_area_get_size(area);
+	for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+		memcpy(&fb[y * disp_drv->hor_res + area->x1], color_p,
+				width * sizeof(lv_color_t));
+		color_p += width;
+	}
+	if (lv_disp_flush_is_last(disp_drv)) {
+		flushed = true;
+	}
+	lv_disp_flush_ready(disp_drv);
+}
+
+/* LVGL syncs last frame's dirty areas into the back buffer with this */
+static void host_buffer_copy(lv_draw_ctx_t *draw_ctx, void *dest_buf,
+		lv_coord_t dest_stride, const lv_area_t *dest_area, void *src_buf,
+		lv_coord_t src_stride, const lv_area_t *src_area) {
+	copied_px += lv_area_get_size(dest_area);
+	sw_buffer_copy(draw_ctx, dest_buf, dest_stride, dest_area, src_buf,
+			src_stride, src_area);
+}
+
+static void host_monitor(lv_disp_drv_t *disp_drv, uint32_t time,
+		uint32_t px) {
+	(void) time;
+	frame_px += px;
+	if (disp_drv->user_data == overlay_fb) {
+		overlay_px += px;
+	}
+}
+
+/* The firmware's refresh timer profiles the refresh and orders the areas
+ * of a display copied while on screen for the beam */
+static void host_refr_timer(lv_timer_t *timer) {
+	lv_disp_t *disp = timer->user_data;
+	uint32_t px = frame_px;
+
+	if (disp->driver->flush_cb == host_flush_partial) {
+		scanout_order_areas(disp, scan_y_offset(disp->driver),
+				scan_beam(scan.now_ns));
+	}
+	render_profile_refresh_begin();
+	_lv_disp_refr_timer(timer);
+	render_profile_refresh_end(frame_px - px);
+}
+
+static void display_init(bool partial, bool overlay) {
+	static lv_disp_draw_buf_t draw_buf;
+	static lv_disp_drv_t disp_drv;
+	static lv_disp_draw_buf_t overlay_draw_buf;
+	static lv_disp_drv_t overlay_drv;
+
+	lv_init();
+	lv_disp_drv_init(&disp_drv);
+	disp_drv.hor_res = DISP_HOR_RES;
+	disp_drv.ver_res = DISP_VER_RES;
+	disp_drv.monitor_cb = host_monitor;
+	disp_drv.draw_buf = &draw_buf;
+	disp_drv.full_refresh = 0;
+
+	// the same modes as lvgl_port_display.c
+	if (partial) {
+		lv_disp_draw_buf_init(&draw_buf, partial_bufs[0], partial_bufs[1],
+				DISP_HOR_RES * DISP_PARTIAL_LINES);
+		disp_drv.flush_cb = host_flush_partial;
+		disp_drv.direct_mode = 0;
+		disp_drv.user_data = framebuffers[0];
+		gui_stats_set_display("partial",
+				sizeof(framebuffers[0]) + sizeof(partial_bufs));
+	} else {
+		lv_disp_draw_buf_init(&draw_buf, framebuffers[1], framebuffers[0],
+				DISP_HOR_RES * DISP_VER_RES);
+		disp_drv.flush_cb = host_flush;
+		disp_drv.direct_mode = 1;
+		gui_stats_set_display("double fb", sizeof(framebuffers));
+	}
+	lv_disp_t *base = lv_disp_drv_register(&disp_drv);
+	lv_timer_set_cb(base->refr_timer, host_refr_timer);
+	glyph_dma2d_attach(&disp_drv);
+	render_profile_attach(&disp_drv);
+	scanout_configure(DISP_VER_RES, SCAN_TOTAL_LINES);
+
+	sw_buffer_copy = disp_drv.draw_ctx->buffer_copy;
+	disp_drv.draw_ctx->buffer_copy = host_buffer_copy;
+
+	// LTDC layer 1, registered second so layer 0 stays the default display
+	if (overlay) {
+		lv_disp_draw_buf_init(&overlay_draw_buf, overlay_bufs[0],
+				overlay_bufs[1], DISP_HOR_RES * OVERLAY_LINES);
+		lv_disp_drv_init(&overlay_drv);
+		overlay_drv.hor_res = DISP_HOR_RES;
+		overlay_drv.ver_res = OVERLAY_VER_RES;
+		overlay_drv.monitor_cb = host_monitor;
+		overlay_drv.draw_buf = &overlay_draw_buf;
+		overlay_drv.flush_cb = host_flush_partial;
+		overlay_drv.user_data = overlay_fb;
+
+		lv_disp_t *disp = lv_disp_drv_register(&overlay_drv);
+		lv_timer_set_cb(disp->refr_timer, host_refr_timer);
+		glyph_dma2d_attach(&overlay_drv);
+		render_profile_attach(&overlay_drv);
+		lv_obj_set_style_bg_color(lv_disp_get_scr_act(disp),
+				lv_color_black(), 0);
+		dashboard_set_overlay_display(disp);
+		gui_stats_set_display(partial ? "partial + overlay" :
+				"double fb + overlay", (partial ? sizeof(framebuffers[0])
+				+ sizeof(partial_bufs) : sizeof(framebuffers))
+				+ sizeof(overlay_fb) + sizeof(overlay_bufs));
+	}
+}
+
+/* Display port ----------------------------------------------------------- */
+
+static bool port_overlay(lv_disp_drv_t *disp_drv) {
+	return disp_drv != lv_disp_get_default()->driver;
+}
+
+/* The port's flush, counting what it has DMA2D copy */
+static void host_port_flush(lv_disp_drv_t *disp_drv, const lv_area_t *area,
+		lv_color_t *color_p) {
+	if (!disp_drv->direct_mode) {
+		copied_px += lv_area_get_size(area);
+	}
+	port_flush[port_overlay(disp_drv)](disp_drv, area, color_p);
+}
+
+/* The port's monitor, which LVGL calls after a refresh that drew */
+static void host_port_monitor(lv_disp_drv_t *disp_drv, uint32_t time,
+		uint32_t px) {
+	port_monitor(disp_drv, time, px);
+	flushed = true;
+	frame_px += px;
+	if (port_overlay(disp_drv)) {
+		overlay_px += px;
+	}
+}
+
+/* lvgl_display_init() on the models, with MX_LTDC_Init's layer 0 on the
+ * replay's two framebuffers, back to back as in RAM2 */
+static void port_init(bool *partial, bool *overlay) {
+	lv_init();
+	host_ltdc_init((uint32_t) (uintptr_t) framebuffers);
+	lvgl_display_init();
+
+	lv_disp_t *base = lv_disp_get_default();
+	lv_disp_t *layer1 = NULL;
+
+	for (lv_disp_t *disp = lv_disp_get_next(NULL); disp != NULL;
+			disp = lv_disp_get_next(disp)) {
+		if (disp != base) {
+			layer1 = disp;
+		}
+	}
+
+	port_monitor = base->driver->monitor_cb;
+	port_flush[0] = base->driver->flush_cb;
+	base->driver->flush_cb = host_port_flush;
+	base->driver->monitor_cb = host_port_monitor;
+	sw_buffer_copy = base->driver->draw_ctx->buffer_copy;
+	base->driver->draw_ctx->buffer_copy = host_buffer_copy;
+	if (layer1 != NULL) {
+		port_flush[1] = layer1->driver->flush_cb;
+		layer1->driver->flush_cb = host_port_flush;
+		layer1->driver->monitor_cb = host_port_monitor;
+	}
+	*partial = !base->driver->direct_mode;
+	*overlay = layer1 != NULL;
+}
+
+/* Frame dumps ------------------------------------------------------------ */
+
+static uint32_t png_crc(uint32_t crc, const uint8_t *p, size_t n) {
+	crc = ~crc;
+	for (size_t i = 0; i < n; i++) {
+		crc ^= p[i];
+		for (int k = 0; k < 8; k++) {
+			crc = (crc >> 1) ^ (0xEDB88320U & -(crc & 1));
+		}
+	}
+	return ~crc;
+}
+
+static void write_be32(uint8_t *p, uint32_t v) {
+	p[0] = (uint8_t) (v >> 24);
+	p[1] = (uint8_t) (v >> 16);
+	p[2] = (uint8_t) (v >> 8);
+	p[3] = (uint8_t) v;
+}
+
+static void png_chunk(FILE *file, const char *type, const uint8_t *data,
+		uint32_t len) {
+	uint8_t head[8];
+	uint8_t crc[4];
+
+	write_be32(head, len);
+	memcpy(&head[4], type, 4);
+	write_be32(crc, png_crc(png_crc(0, &head[4], 4), data, len));
+	fwrite(head, 1, sizeof(head), file);
+	fwrite(data, 1, len, file);
+	fwrite(crc, 1, sizeof(crc), file);
+}
+
+/*
+ * width * height RGB888 pixels as a PNG. The image data is a zlib stream of
+ * stored deflate blocks, uncompressed, so the replay needs no zlib; the rows
+ * have no filter
+ */
+static bool png_write(const char *path, const uint8_t *rgb, uint32_t width,
+		uint32_t height) {
+	static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A,
+			'\n' };
+	size_t row = 1 + (size_t) width * 3;
+	size_t raw_len = row * height;
+	size_t blocks = (raw_len + PNG_BLOCK_MAX - 1) / PNG_BLOCK_MAX;
+	size_t idat_len = 2 + blocks * 5 + raw_len + 4;
+	uint8_t *raw = malloc(raw_len);
+	uint8_t *idat = malloc(idat_len);
+	uint8_t ihdr[13] = { 0 };
+	FILE *file = fopen(path, "wb");
+	bool ok = file != NULL && raw != NULL && idat != NULL;
+
+	if (ok) {
+		uint32_t a = 1;
+		uint32_t b = 0;
+		uint8_t *p = idat;
+
+		for (uint32_t y = 0; y < height; y++) {
+			raw[y * row] = 0;
+			memcpy(&raw[y * row + 1], &rgb[(size_t) y * width * 3], width * 3);
+		}
+		for (size_t i = 0; i < raw_len; i++) {
+			a = (a + raw[i]) % 65521U;
+			b = (b + a) % 65521U;
+		}
+
+		*p++ = 0x78; // deflate, 32K window, no dictionary
+		*p++ = 0x01;
+		for (size_t done = 0; done < raw_len;) {
+			uint32_t len = raw_len - done > PNG_BLOCK_MAX ? PNG_BLOCK_MAX :
+					(uint32_t) (raw_len - done);
+
+			*p++ = done + len == raw_len; // final block, stored
+			*p++ = (uint8_t) len;
+			*p++ = (uint8_t) (len >> 8);
+			*p++ = (uint8_t) ~len;
+			*p++ = (uint8_t) (~len >> 8);
+			memcpy(p, &raw[done], len);
+			p += len;
+			done += len;
+		}
+		write_be32(p, b << 16 | a);
+
+		write_be32(&ihdr[0], width);
+		write_be32(&ihdr[4], height);
+		ihdr[8] = 8; // bits per channel
+		ihdr[9] = 2; // RGB
+		fwrite(signature, 1, sizeof(signature), file);
+		png_chunk(file, "IHDR", ihdr, sizeof(ihdr));
+		png_chunk(file, "IDAT", idat, (uint32_t) idat_len);
+		png_chunk(file, "IEND", NULL, 0);
+	}
+	if (file != NULL && fclose(file) != 0) {
+		ok = false;
+	}
+	if (!ok) {
+		perror(path);
+	}
+	free(raw);
+	free(idat);
+	return ok;
+}
+
+/* The frame the LTDC scans out next, to <prefix><index>.png */
+static bool dump_frame(const char *prefix, uint32_t index) {
+	static uint8_t rgb[DISP_HOR_RES * DISP_VER_RES * 3];
+	char path[4096];
+	uint32_t width;
+	uint32_t height;
+
+	host_ltdc_size(&width, &height);
+	if ((size_t) width * height * 3 > sizeof(rgb)) {
+		fprintf(stderr, "%" PRIu32 "x%" PRIu32 " frame too large\n", width,
+				height);
+		return false;
+	}
+	host_ltdc_compose(rgb);
+	snprintf(path, sizeof(path), "%s%04" PRIu32 ".png", prefix, index);
+	return png_write(path, rgb, width, height);
+}
+
+/* Test pixels ------------------------------------------------------------ */
+
+static uint32_t bench_seed = 1;
+
+static uint32_t bench_random(void) {
+	bench_seed = bench_seed * 1664525U + 1013904223U;
+	return bench_seed >> 8;
+}
+
+/* Something like a rendered screen: runs of black, of one colour and of
+ * noise */
+static void bench_pixels(lv_color_t *px, size_t n) {
+	for (size_t i = 0; i < n;) {
+		uint32_t r = bench_random();
+		size_t run = 1 + (r & 15);
+		uint16_t c = (uint16_t) bench_random();
+
+		for (; run > 0 && i < n; run--, i++) {
+			px[i].full = (r >> 4) % 3 == 0 ? 0 :
+					(r >> 4) % 3 == 1 ? c : (uint16_t) bench_random();
+		}
+	}
+}
+
+/* DMA2D letters ---------------------------------------------------------- */
+
+#define GLYPH_CHECK_W 96
+#define GLYPH_CHECK_H 64
+
+static const lv_font_t *const glyph_fonts[] = { &lv_font_montserrat_14,
+		&lv_font_montserrat_24, &lv_font_montserrat_30, &lv_font_montserrat_36,
+		&lv_font_montserrat_48 };
+
+static const char glyph_letters[] =
+		"0123456789.,-:%/ ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+
+/* Every letter of the dashboard's fonts drawn by DMA2D, through the register
+ * model, and by LVGL's software blending over the same pixels, at even and
+ * odd columns, whole and clipped on each side. The two blend differently,
+ * DMA2D in 8 bits per channel and LVGL in 5 and 6, so they may be a step or
+ * two apart */
+static int glyph_check(void) {
+	static lv_color_t buf[2][GLYPH_CHECK_W * GLYPH_CHECK_H];
+	lv_area_t buf_area = { 0, 0, GLYPH_CHECK_W - 1, GLYPH_CHECK_H - 1 };
+	size_t n = sizeof(buf[0]) / sizeof(buf[0][0]);
+	uint32_t letters = 0;
+	uint32_t differ = 0;
+	uint32_t worst[3] = { 0 };
+	glyph_dma2d_stats_t before;
+	glyph_dma2d_stats_t after;
+	host_dma2d_stats_t model;
+
+	display_init(false, false);
+	lv_disp_t *disp = lv_disp_get_default();
+	lv_draw_ctx_t *ctx = disp->driver->draw_ctx;
+	lv_draw_sw_ctx_t *sw = (lv_draw_sw_ctx_t*) ctx;
+	void (*blend)(lv_draw_ctx_t*, const lv_draw_sw_blend_dsc_t*) = sw->blend;
+	_lv_refr_set_disp_refreshing(disp);
+	ctx->buf_area = &buf_area;
+	glyph_dma2d_get_stats(&before);
+
+	for (size_t f = 0; f < sizeof(glyph_fonts) / sizeof(glyph_fonts[0]); f++) {
+		for (const char *c = glyph_letters; *c != '\0'; c++) {
+			for (uint32_t place = 0; place < 8; place++) {
+				lv_point_t pos = { 16 + (lv_coord_t) (place & 1), 4 };
+				lv_area_t clip = buf_area;
+				lv_draw_label_dsc_t dsc;
+
+				// whole, then cut on the left, right and top at odd and
+				// even columns
+				if (place / 2 == 1) {
+					clip.x1 = pos.x + 5 + (lv_coord_t) (place & 1);
+				} else if (place / 2 == 2) {
+					clip.x2 = pos.x + 7;
+				} else if (place / 2 == 3) {
+					clip.y1 = pos.y + glyph_fonts[f]->line_height / 2;
+				}
+
+				lv_draw_label_dsc_init(&dsc);
+				dsc.font = glyph_fonts[f];
+				dsc.color.full = (uint16_t) bench_random();
+				bench_pixels(buf[0], n);
+				memcpy(buf[1], buf[0], sizeof(buf[0]));
+				ctx->clip_area = &clip;
+
+				ctx->buf = buf[0];
+				sw->blend = lv_draw_sw_blend_basic;
+				lv_draw_sw_letter(ctx, &dsc, &pos, (uint8_t) *c);
+				sw->blend = blend;
+				ctx->buf = buf[1];
+				ctx->draw_letter(ctx, &dsc, &pos, (uint8_t) *c);
+				lv_draw_wait_for_finish(ctx);
+				letters++;
+
+				for (size_t i = 0; i < n; i++) {
+					uint16_t a = buf[0][i].full;
+					uint16_t b = buf[1][i].full;
+					uint32_t d[3] = { abs((a >> 11) - (b >> 11)),
+							abs(((a >> 5) & 0x3F) - ((b >> 5) & 0x3F)),
+							abs((a & 0x1F) - (b & 0x1F)) };
+
+					differ += a != b;
+					for (int k = 0; k < 3; k++) {
+						worst[k] = d[k] > worst[k] ? d[k] : worst[k];
+					}
+				}
+			}
+		}
+	}
+	_lv_refr_set_disp_refreshing(NULL);
+
+	glyph_dma2d_get_stats(&after);
+	host_dma2d_get_stats(&model);
+	printf("glyphs      %" PRIu32 " letters, %" PRIu32 " blended by DMA2D, %"
+			PRIu32 " by LVGL, %" PRIu32 " DMA2D configuration errors\n",
+			letters, after.dma2d - before.dma2d,
+			after.fallback - before.fallback, model.config_errors);
+	printf("            %" PRIu32 " px differ from LVGL's, by at most %" PRIu32
+			"/%" PRIu32 "/%" PRIu32 " (r/g/b steps)\n", differ, worst[0],
+			worst[1], worst[2]);
+	return model.config_errors == 0 && worst[0] <= GLYPH_CHECK_STEPS
+			&& worst[1] <= GLYPH_CHECK_STEPS && worst[2] <= GLYPH_CHECK_STEPS ?
+			0 : 1;
+}
+
+/* Gauge benchmark -------------------------------------------------------- */
+
+typedef struct {
+	const char *name;
+	lv_obj_t* (*create)(lv_obj_t *parent);
+	void (*set)(lv_obj_t *gauge, int32_t value);
+} gauge_bench_case_t;
+
+/* The gauge as dashboard.c built it before gui/gauge.c: an lv_arc with a
+ * flex container of a value and a units label */
+static lv_obj_t* composite_create(lv_obj_t *parent) {
+	lv_obj_t *arc = lv_arc_create(parent);
+	lv_obj_set_size(arc, 200, 200);
+	lv_arc_set_range(arc, 0, GAUGE_BENCH_MAX);
+	lv_arc_set_value(arc, 0);
+	lv_arc_set_bg_angles(arc, 0, 270);
+	lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE);
+	lv_arc_set_mode(arc, LV_ARC_MODE_NORMAL);
+	lv_arc_set_rotation(arc, 135);
+	lv_obj_set_style_arc_color(arc, lv_color_hex(0x646464), LV_PART_MAIN);
+	lv_obj_set_style_arc_width(arc, 6, LV_PART_INDICATOR);
+	lv_obj_set_style_bg_opa(arc, LV_OPA_TRANSP, LV_PART_KNOB);
+
+	lv_obj_t *container = lv_obj_create(arc);
+	lv_obj_set_size(container, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+	lv_obj_center(container);
+	lv_obj_set_flex_flow(container, LV_FLEX_FLOW_COLUMN);
+	lv_obj_set_style_bg_opa(container, LV_OPA_TRANSP, 0);
+	lv_obj_set_style_pad_all(container, 0, 0);
+	lv_obj_set_style_border_width(container, 0, 0);
+	lv_obj_set_style_border_opa(container, LV_OPA_TRANSP, 0);
+	lv_obj_clear_flag(container, LV_OBJ_FLAG_SCROLLABLE);
+
+	lv_obj_t *value = lv_label_create(container);
+	lv_label_set_text(value, "0");
+	lv_obj_set_style_text_font(value, &lv_font_montserrat_48, 0);
+	lv_obj_t *units = lv_label_create(container);
+	lv_label_set_text(units, "mph");
+	lv_obj_set_style_text_font(units, &lv_font_montserrat_24, 0);
+	return arc;
+}
+
+/* As update_display_state_drive() did: the arc, and the label's text when
+ * it differs */
+static void composite_set(lv_obj_t *arc, int32_t value) {
+	lv_obj_t *label = lv_obj_get_child(lv_obj_get_child(arc, 0), 0);
+	char text[12];
+
+	lv_arc_set_value(arc, (int16_t) value);
+	lv_snprintf(text, sizeof(text), "%" PRId32, value);
+	if (strcmp(lv_label_get_text(label), text) != 0) {
+		lv_label_set_text(label, text);
+	}
+}
+
+/* As dashboard.c builds it */
+static lv_obj_t* gauge_bench_create(lv_obj_t *parent) {
+	lv_obj_t *gauge = gauge_create(parent, GAUGE_BENCH_MAX, "mph");
+	lv_obj_set_size(gauge, 200, 200);
+	lv_obj_set_style_arc_color(gauge, lv_color_hex(0x646464), LV_PART_MAIN);
+	lv_obj_set_style_arc_width(gauge, 6, LV_PART_INDICATOR);
+	lv_obj_set_style_text_font(gauge, &lv_font_montserrat_24, LV_PART_MAIN);
+	lv_obj_set_style_text_font(gauge, digit_atlas_font(&lv_font_montserrat_48),
+			LV_PART_INDICATOR);
+	return gauge;
+}
+
+/* The battery temperature as dashboard.c built it before gui/readout.c: a
+ * recoloured label in montserrat 48 */
+static lv_obj_t* temp_label_create(lv_obj_t *parent) {
+	lv_obj_t *label = lv_label_create(parent);
+	lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+	lv_label_set_recolor(label, true);
+	lv_label_set_text(label, "#00ff00 0 °C#");
+	return label;
+}
+
+static void temp_label_set(lv_obj_t *label, int32_t value) {
+	char text[24];
+
+	lv_snprintf(text, sizeof(text), "#00ff00 %" PRId32 " °C#", value);
+	if (strcmp(lv_label_get_text(label), text) != 0) {
+		lv_label_set_text(label, text);
+	}
+}
+
+static lv_obj_t* temp_readout_create(lv_obj_t *parent) {
+	lv_obj_t *readout = readout_create(parent, 3, NULL, " °C");
+	lv_obj_set_style_text_font(readout, &lv_font_montserrat_48, LV_PART_MAIN);
+	lv_obj_set_style_text_font(readout,
+			digit_atlas_font(&lv_font_montserrat_48), LV_PART_INDICATOR);
+	lv_obj_set_style_text_color(readout, lv_color_hex(0x00ff00),
+			LV_PART_INDICATOR);
+	return readout;
+}
+
+static const gauge_bench_case_t gauge_bench_cases[] = {
+	{ "lv_arc+labels", composite_create, composite_set },
+	{ "gauge", gauge_bench_create, gauge_set_value },
+	{ "label", temp_label_create, temp_label_set },
+	{ "readout", temp_readout_create, readout_set_value },
+};
+
+static uint32_t count_objects(lv_obj_t *obj) {
+	uint32_t n = 1;
+
+	for (uint32_t i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+		n += count_objects(lv_obj_get_child(obj, (int32_t) i));
+	}
+	return n;
+}
+
+/* Pixels of two snapshots of a gauge that differ outside its numerals: a
+ * box two cells either side of the centre, a line of numerals high */
+static uint32_t gauge_sweep_differ(const lv_obj_t *gauge, const lv_img_dsc_t *a,
+		const lv_img_dsc_t *b) {
+	const lv_color_t *pa = (const lv_color_t*) a->data;
+	const lv_color_t *pb = (const lv_color_t*) b->data;
+	lv_coord_t w = a->header.w;
+	lv_coord_t h = a->header.h;
+	lv_coord_t cell_w = ((const gauge_t*) gauge)->cell_w;
+	lv_coord_t line_h = lv_font_get_line_height(
+			lv_obj_get_style_text_font(gauge, LV_PART_INDICATOR));
+	uint32_t differ = 0;
+
+	for (lv_coord_t y = 0; y < h; y++) {
+		for (lv_coord_t x = 0; x < w; x++) {
+			bool numerals = LV_ABS(x - w / 2) < 2 * cell_w
+					&& LV_ABS(y - h / 2) < line_h;
+
+			differ += !numerals && pa[y * w + x].full != pb[y * w + x].full;
+		}
+	}
+	return differ;
+}
+
+/* A value past either end, as rpm_gauge gets mph past its max or in
+ * reverse: the numerals show it as it is, the sweep stops at the end, so
+ * away from the numerals the gauge looks as it does at that end */
+static int gauge_range_check(void) {
+	static const int32_t values[][2] = { // value, the end it is past
+		{ GAUGE_BENCH_MAX + 1, GAUGE_BENCH_MAX },
+		{ 1000, GAUGE_BENCH_MAX },
+		{ -5, 0 },
+		{ -40, 0 },
+	};
+	lv_obj_t *old = lv_scr_act();
+	lv_obj_t *screen = lv_obj_create(NULL);
+	uint32_t failed = 0;
+
+	lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
+	lv_scr_load(screen);
+	lv_obj_del(old);
+	lv_obj_t *gauge = gauge_bench_create(screen);
+	lv_obj_center(gauge);
+	lv_refr_now(NULL);
+
+	// off LVGL's heap, which holds one snapshot of this size, not two
+	uint32_t size = lv_snapshot_buf_size_needed(gauge, LV_IMG_CF_TRUE_COLOR);
+	void *bufs[2] = { malloc(size), malloc(size) };
+
+	for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		char expect[GAUGE_DIGITS_MAX + 1];
+		lv_img_dsc_t end;
+		lv_img_dsc_t past;
+
+		gauge_set_value(gauge, values[i][1]);
+		lv_snapshot_take_to_buf(gauge, LV_IMG_CF_TRUE_COLOR, &end, bufs[0],
+				size);
+		gauge_set_value(gauge, values[i][0]);
+		lv_snapshot_take_to_buf(gauge, LV_IMG_CF_TRUE_COLOR, &past, bufs[1],
+				size);
+		uint32_t differ = gauge_sweep_differ(gauge, &end, &past);
+
+		lv_snprintf(expect, sizeof(expect), "%" PRId32, values[i][0]);
+		printf("gauge at %-5" PRId32 " shows \"%s\", %" PRIu32
+				" px of the sweep differ from %" PRId32 "\n", values[i][0],
+				((const gauge_t*) gauge)->text, differ, values[i][1]);
+		failed += differ != 0
+				|| strcmp(((const gauge_t*) gauge)->text, expect) != 0;
+	}
+	free(bufs[0]);
+	free(bufs[1]);
+	return failed == 0 ? 0 : 1;
+}
+
+/* Each widget alone on a screen, its objects and heap use, then the same
+ * walk of speed values: the time to set each, and the pixels and time of
+ * the refresh after it; last the pixels and time of 99 to 100 */
+static int gauge_bench(void) {
+	display_init(false, false);
+
+	printf("%-14s %7s %7s %10s %8s %10s %10s %8s\n", "widget", "objects",
+			"heap B", "px/update", "set us", "refresh us", "99>100 px",
+			"99>100 us");
+	for (size_t i = 0;
+			i < sizeof(gauge_bench_cases) / sizeof(gauge_bench_cases[0]); i++) {
+		const gauge_bench_case_t *c = &gauge_bench_cases[i];
+		lv_obj_t *old = lv_scr_act();
+		lv_obj_t *screen = lv_obj_create(NULL);
+		lv_mem_monitor_t before;
+		lv_mem_monitor_t after;
+
+		lv_obj_set_style_bg_color(screen, lv_color_black(), 0);
+		lv_scr_load(screen);
+		lv_obj_del(old);
+		lv_refr_now(NULL);
+
+		lv_mem_monitor(&before);
+		lv_obj_t *gauge = c->create(screen);
+		lv_obj_center(gauge);
+		lv_mem_monitor(&after);
+		lv_refr_now(NULL);
+
+		uint64_t set_ns = 0;
+		uint64_t refr_ns = 0;
+		uint64_t px = 0;
+		int32_t value = 0;
+		bench_seed = 1;
+		for (uint32_t u = 0; u < GAUGE_BENCH_UPDATES; u++) {
+			value += (int32_t) (bench_random() % 7U) - 3;
+			value = LV_CLAMP(0, value, GAUGE_BENCH_MAX);
+
+			uint64_t t0 = wall_ns();
+			c->set(gauge, value);
+			uint64_t t1 = wall_ns();
+			frame_px = 0;
+			lv_refr_now(NULL);
+			refr_ns += wall_ns() - t1;
+			set_ns += t1 - t0;
+			px += frame_px;
+		}
+
+		c->set(gauge, 99);
+		lv_refr_now(NULL);
+		uint64_t t0 = wall_ns();
+		c->set(gauge, 100);
+		frame_px = 0;
+		lv_refr_now(NULL);
+		uint64_t step_ns = wall_ns() - t0;
+
+		printf("%-14s %7" PRIu32 " %7" PRIu32 " %10.0f %8.2f %10.1f %10"
+				PRIu32 " %8.1f\n", c->name, count_objects(gauge),
+				(uint32_t) (before.free_size - after.free_size),
+				(double) px / GAUGE_BENCH_UPDATES,
+				set_ns / 1e3 / GAUGE_BENCH_UPDATES,
+				refr_ns / 1e3 / GAUGE_BENCH_UPDATES, frame_px, step_ns / 1e3);
+	}
+	return gauge_range_check();
+}
+
+/* Number formatter benchmark --------------------------------------------- */
+
+typedef struct {
+	const char *name;
+	const char *fmt; // as the pre-drive screen had it
+	float scale; // the signal's, from can_db.c
+	uint32_t decimals;
+	const char *suffix;
+} format_bench_case_t;
+
+static const format_bench_case_t format_bench_cases[] = {
+	{ "lv_voltage", "%.1f V", 0.00491214369387f, 1, " V" },
+	{ "capacitor_voltage", "%.2f", 0.0625f, 2, "" },
+	{ "pack_voltage", "%.1f", 0.1f, 1, "" },
+};
+
+static volatile uint32_t format_sink; // keeps the timed loops' results
+
+/* Host CPU cycles where there is a cycle counter, the TSC on x86 */
+static uint64_t host_cycles(void) {
+#if defined(__x86_64__) || defined(__i386__)
+	return __builtin_ia32_rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static void format_bench_old(const format_bench_case_t *c, float value,
+		char *out) {
+	lv_snprintf(out, LABEL_TEXT_NUMBER_MAX + 8, c->fmt, value);
+}
+
+static void format_bench_new(const format_bench_case_t *c, float value,
+		char *out) {
+	char *end = label_text_format_float(out, value, c->decimals);
+	strcpy(end, c->suffix);
+}
+
+/* Each raw value of each signal formatted both ways, as text, then timed:
+ * the time and host cycles per call. Then the pack label of the pre-drive
+ * screen, formatted and set on a label both ways, which must end up with the
+ * same text */
+static int format_bench(void) {
+	static const char *names[] = { "lv_vsnprintf", "label_text" };
+	void (*format[])(const format_bench_case_t*, float, char*) = {
+		format_bench_old, format_bench_new };
+	uint32_t failed = 0;
+
+	printf("%-18s %7s %-14s %8s %8s\n", "signal", "differ", "path", "ns/call",
+			"cycles");
+	for (size_t i = 0;
+			i < sizeof(format_bench_cases) / sizeof(format_bench_cases[0]); i++) {
+		const format_bench_case_t *c = &format_bench_cases[i];
+		char old_text[LABEL_TEXT_NUMBER_MAX + 8];
+		char new_text[LABEL_TEXT_NUMBER_MAX + 8];
+		uint32_t differ = 0;
+
+		// negated as well, where small values round to "-0.0"
+		for (int32_t raw = -UINT16_MAX; raw <= UINT16_MAX; raw++) {
+			float value = (float) raw * c->scale;
+
+			format_bench_old(c, value, old_text);
+			format_bench_new(c, value, new_text);
+			if (strcmp(old_text, new_text) != 0) {
+				if (differ++ == 0) {
+					printf("%-18s raw %" PRIi32 ": \"%s\", \"%s\"\n", c->name,
+							raw, old_text, new_text);
+				}
+			}
+		}
+		failed += differ;
+
+		for (uint32_t path = 0; path < 2; path++) {
+			uint32_t sum = 0;
+			uint64_t t0 = wall_ns();
+			uint64_t c0 = host_cycles();
+			for (uint32_t raw = 0; raw <= UINT16_MAX; raw++) {
+				format[path](c, (float) raw * c->scale, old_text);
+				sum += (uint8_t) old_text[0];
+			}
+			uint64_t cycles = host_cycles() - c0;
+			uint64_t ns = wall_ns() - t0;
+
+			format_sink += sum;
+			printf("%-18s %7" PRIu32 " %-14s %8.1f %8.0f\n",
+					path == 0 ? c->name : "", differ, names[path],
+					(double) ns / (UINT16_MAX + 1),
+					(double) cycles / (UINT16_MAX + 1));
+		}
+	}
+
+	// the whole text of a label, and setting it when it changed
+	display_init(false, false);
+	static label_text_t text;
+	lv_obj_t *label = lv_label_create(lv_scr_act());
+	char buffer[LABEL_TEXT_BYTES];
+	char last[LABEL_TEXT_BYTES];
+
+	for (uint32_t path = 0; path < 2; path++) {
+		if (path == 1) {
+			label_text_bind(&text, label);
+		}
+		bench_seed = 1;
+		uint64_t t0 = wall_ns();
+		uint64_t c0 = host_cycles();
+		for (uint32_t u = 0; u < FORMAT_BENCH_LABELS; u++) {
+			int32_t temperature = 40 + (int32_t) (bench_random() % 3U);
+			int32_t soc = 80;
+			float pack_voltage = (float) (3900 + bench_random() % 4U) * 0.1f;
+			int32_t dcl = 250;
+
+			if (path == 0) {
+				lv_snprintf(buffer, sizeof(buffer), "TS Battery Pack\n"
+						"Temperature: %d °C\n"
+						"SOC: %d%%\n"
+						"Pack Voltage: %.1f\n"
+						"Pack DCL: %d A", temperature, soc, pack_voltage, dcl);
+				if (strcmp(lv_label_get_text(label), buffer) != 0) {
+					lv_label_set_text(label, buffer);
+				}
+				continue;
+			}
+			label_text_begin(&text);
+			label_text_str(&text, "TS Battery Pack\nTemperature: ");
+			label_text_int(&text, temperature);
+			label_text_str(&text, " °C\nSOC: ");
+			label_text_int(&text, soc);
+			label_text_str(&text, "%\nPack Voltage: ");
+			label_text_float(&text, pack_voltage, 1);
+			label_text_str(&text, "\nPack DCL: ");
+			label_text_int(&text, dcl);
+			label_text_str(&text, " A");
+			label_text_end(&text);
+		}
+		uint64_t cycles = host_cycles() - c0;
+		uint64_t ns = wall_ns() - t0;
+
+		printf("%-18s %7s %-14s %8.1f %8.0f\n", path == 0 ? "pack label" : "",
+				"", names[path], (double) ns / FORMAT_BENCH_LABELS,
+				(double) cycles / FORMAT_BENCH_LABELS);
+		if (path == 0) {
+			strcpy(last, lv_label_get_text(label));
+		} else if (strcmp(last, lv_label_get_text(label)) != 0) {
+			printf("pack label differs: \"%s\", \"%s\"\n", last,
+					lv_label_get_text(label));
+			failed++;
+		}
+	}
+	return failed == 0 ? 0 : 1;
+}
+
+/* Screen benchmark ------------------------------------------------------- */
+
+/* The telemetry of update u: values that wander as on a car, the LV battery
+ * about its colour threshold and the RTD switch going on and off */
+static void screen_bench_telemetry(uint32_t u) {
+	telemetry.vcu.lv_voltage = 12.5f + (float) (bench_random() % 41U) * 0.01f;
+	telemetry.vcu.rtd_switch_state = (u / 50U) % 2U != 0;
+	telemetry.vcu.max_torque = 120;
+	telemetry.vcu.current_limit = 200;
+	telemetry.vcu.max_rpm = 6000;
+	telemetry.battery.temperature = (uint8_t) (40U + bench_random() % 3U);
+	telemetry.battery.pack_soc = (uint8_t) (80U - u / 400U);
+	telemetry.battery.pack_voltage = (float) (3900U + bench_random() % 5U)
+			* 0.1f;
+	telemetry.battery.pack_dcl = 250;
+	telemetry.inv1.capacitor_voltage = (float) (6240U + bench_random() % 9U)
+			* 0.0625f;
+	telemetry.inv2.capacitor_voltage = (float) (6240U + bench_random() % 9U)
+			* 0.0625f;
+	telemetry.inv1.statusword = STATUSWORD_ENABLED;
+	telemetry.inv2.statusword = STATUSWORD_ENABLED;
+	telemetry.inv1.motor_temp = (int16_t) (60U + bench_random() % 2U);
+	telemetry.inv2.motor_temp = (int16_t) (60U + bench_random() % 2U);
+	telemetry.inv1.motor_speed = (int16_t) (3000U + bench_random() % 200U);
+	telemetry.inv2.motor_speed = telemetry.inv1.motor_speed;
+	time_count = u * (GUI_MIN_REFRESH_MS / 10U);
+}
+
+/* The pre-drive and drive screens as the dashboard builds them, each shown
+ * and updated with the same telemetry: the time of each update, the drive
+ * screen's bindings evaluated and changed (gui/binding.c), and the pixels and
+ * time of the refresh after it. The last run marks only the speed messages
+ * dirty, as most updates on the car do. */
+static int screen_bench(void) {
+	static const display_state_t states[] = { PRE_DRIVE, DRIVE, DRIVE };
+	static const char *names[] = { "pre-drive", "drive", "drive/rpm" };
+	static const uint32_t dirty[] = { TELEMETRY_GROUPS_ALL,
+			TELEMETRY_GROUPS_ALL, TELEMETRY_GROUP(INV1_TORQUESPEED)
+					| TELEMETRY_GROUP(INV2_TORQUESPEED) };
+	binding_stats_t bindings;
+
+	display_init(false, false);
+	initialize_display_screens();
+
+	printf("%-10s %10s %9s %9s %10s\n", "screen", "px/update", "update us",
+			"bindings", "refresh us");
+	for (size_t i = 0; i < sizeof(states) / sizeof(states[0]); i++) {
+		bench_seed = 1;
+		screen_bench_telemetry(0);
+		update_display_state(states[i], TELEMETRY_GROUPS_ALL);
+		load_display_state(states[i]);
+		lv_refr_now(NULL);
+		binding_get_stats(&bindings);
+
+		uint64_t update_ns = 0;
+		uint64_t refr_ns = 0;
+		uint64_t px = 0;
+		for (uint32_t u = 1; u <= SCREEN_BENCH_UPDATES; u++) {
+			screen_bench_telemetry(u);
+
+			uint64_t t0 = wall_ns();
+			update_display_state(states[i], dirty[i]);
+			uint64_t t1 = wall_ns();
+			frame_px = 0;
+			lv_refr_now(NULL);
+			refr_ns += wall_ns() - t1;
+			update_ns += t1 - t0;
+			px += frame_px;
+		}
+
+		binding_get_stats(&bindings);
+		printf("%-10s %10.0f %9.1f %4.1f/%4.1f %10.1f\n", names[i],
+				(double) px / SCREEN_BENCH_UPDATES,
+				update_ns / 1e3 / SCREEN_BENCH_UPDATES,
+				(double) bindings.evaluated / SCREEN_BENCH_UPDATES,
+				(double) bindings.changed / SCREEN_BENCH_UPDATES,
+				refr_ns / 1e3 / SCREEN_BENCH_UPDATES);
+	}
+	return 0;
+}
+
+/* LVGL heap -------------------------------------------------------------- */
+
+// lv_mem_monitor()'s max_used takes off a freed block's whole size but adds
+// only what was asked for, and leaves reallocations out, so it drifts low;
+// these count TLSF's blocks, headers included, as the pool holds them
+static size_t heap_blocks;
+static size_t heap_blocks_peak;
+static void *heap_zero; // what lv_mem_alloc(0) returns, not in the pool
+
+void *__real_lv_mem_alloc(size_t size);
+void __real_lv_mem_free(void *data);
+void *__real_lv_mem_realloc(void *data, size_t new_size);
+
+static size_t heap_block(void *data) {
+	if (heap_zero == NULL) {
+		heap_zero = __real_lv_mem_alloc(0);
+	}
+	return data == NULL || data == heap_zero ? 0 :
+			lv_tlsf_block_size(data) + lv_tlsf_alloc_overhead();
+}
+
+static void heap_count(size_t freed, size_t allocated) {
+	heap_blocks = heap_blocks - freed + allocated;
+	if (heap_blocks > heap_blocks_peak) {
+		heap_blocks_peak = heap_blocks;
+	}
+}
+
+void *__wrap_lv_mem_alloc(size_t size) {
+	void *data = __real_lv_mem_alloc(size);
+	heap_count(0, heap_block(data));
+	return data;
+}
+
+void __wrap_lv_mem_free(void *data) {
+	heap_count(heap_block(data), 0);
+	__real_lv_mem_free(data);
+}
+
+void *__wrap_lv_mem_realloc(void *data, size_t new_size) {
+	size_t freed = heap_block(data);
+	void *new_data = __real_lv_mem_realloc(data, new_size);
+	if (new_data != NULL) {
+		heap_count(freed, heap_block(new_data));
+	}
+	return new_data;
+}
+
+/* Sleep until the wall clock reaches the log time scaled by speed */
+static void pace(uint64_t start_ns, uint64_t log_us, double speed) {
+	if (speed <= 0) {
+		return;
+	}
+
+	uint64_t target = start_ns + (uint64_t) ((double) log_us * 1000.0 / speed);
+	uint64_t now = wall_ns();
+	if (target > now) {
+		struct timespec ts = { .tv_sec = (time_t) ((target - now) / 1000000000U),
+				.tv_nsec = (long) ((target - now) % 1000000000U) };
+		while (nanosleep(&ts, &ts) != 0 && errno == EINTR) {
+		}
+	}
+}
+
+static void usage(void) {
+	fprintf(stderr, "usage: replay [-s speed] [-q] [-p] [-1] [-n] "
+			"[-r profile.bin] log\n"
+			"       replay -d [-s speed] [-q] [-n] [-r profile.bin] "
+			"[-o prefix] log\n"
+			"       replay -c out.bin log\n"
+			"       replay -g | -a | -f | -t | -x | -e | -i | -l\n");
+	exit(2);
+}
+
+int main(int argc, char **argv) {
+	double speed = 1.0;
+	bool quiet = false;
+	bool partial = false;
+	bool overlay = true;
+	bool port = false;
+	const char *convert_path = NULL;
+	const char *dump_prefix = NULL;
+	const char *profile_path = NULL;
+	FILE *profile = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "s:qp1ndc:r:o:gaftxeil")) != -1) {
+		switch (opt) {
+		case 's':
+			speed = atof(optarg);
+			break;
+		case 'q':
+			quiet = true;
+			break;
+		case 'p':
+			partial = true;
+			break;
+		case '1':
+			overlay = false;
+			break;
+		case 'n':
+			chrome_cache_enable(false);
+			break;
+		case 'd':
+			port = true;
+			break;
+		case 'c':
+			convert_path = optarg;
+			break;
+		case 'r':
+			profile_path = optarg;
+			break;
+		case 'o':
+			dump_prefix = optarg;
+			break;
+		case 'g':
+			return glyph_check();
+		case 'a':
+			return gauge_bench();
+		case 'f':
+			return format_bench();
+		case 't':
+			return screen_bench();
+		case 'x':
+			return rx_stress();
+		case 'e':
+			return decode_check();
+		case 'i':
+			return filter_check();
+		case 'l':
+			return lock_check();
+		default:
+			usage();
+		}
+	}
+	// the port's configuration is PORT_DEFS's
+	if (optind != argc - 1 || (port && (partial || !overlay))
+			|| (dump_prefix != NULL && !port)) {
+		usage();
+	}
+	if (convert_path != NULL) {
+		return convert(argv[optind], convert_path);
+	}
+
+	log_reader_t log;
+	if (!log_open(&log, argv[optind])) {
+		perror(argv[optind]);
+		return 1;
+	}
+	if (profile_path != NULL) {
+		profile = fopen(profile_path, "wb");
+		if (profile == NULL) {
+			perror(profile_path);
+			return 1;
+		}
+	}
+
+	host_fdcan_init();
+	can_configure_filters();
+	if (port) {
+		port_init(&partial, &overlay);
+	} else {
+		display_init(partial, overlay);
+	}
+
+	samples_t decode = { 0 };
+	samples_t update = { 0 };
+	samples_t render = { 0 };
+	samples_t switches = { 0 };
+	uint64_t decode_ns = 0;
+	uint64_t next_gui_us = 0;
+	uint64_t next_profile_us = PROFILE_PERIOD_US;
+	uint32_t profile_records = 0;
+	uint32_t dumps = 0;
+	static uint8_t record[RENDER_PROFILE_RECORD_MAX];
+	uint64_t time_us = 0;
+	uint32_t frames = 0;
+	uint32_t filtered = 0;
+	can_frame_t frame;
+	bool more = true;
+	uint64_t start_ns = wall_ns();
+
+	while (more) {
+		more = log_next(&log, &time_us, &frame);
+
+		// GUI loop iterations due before this frame (or the log end)
+		while (next_gui_us <= time_us || (!more && next_gui_us <= time_us
+						+ GUI_PERIOD_US)) {
+			pace(start_ns, next_gui_us, speed);
+			host_set_time_us(next_gui_us);
+			lv_tick_inc(GUI_PERIOD_US / 1000U);
+			if (scan.now_ns < next_gui_us * 1000U) {
+				scan.now_ns = next_gui_us * 1000U;
+			}
+
+			flushed = false;
+			frame_px = 0;
+			display_state_t shown = current_display_state;
+			uint64_t t0 = wall_ns();
+			lv_timer_handler();
+			uint64_t t1 = wall_ns();
+			render_profile_record(RENDER_PROFILE_HANDLER, ns_to_cycles(t1 - t0));
+			gui_task_step();
+			uint64_t t2 = wall_ns();
+
+			if (flushed) {
+				samples_add(&render, t1 - t0);
+				samples_add(&redrawn_px, frame_px);
+				if (!port) { // the port records its own
+					gui_stats_record_frame((uint32_t) ((t1 - t0) / 1000U),
+							frame_px);
+				}
+			}
+			if (current_display_state != shown) {
+				samples_add(&switches, t2 - t1); // includes its first frame
+			} else {
+				samples_add(&update, t2 - t1);
+			}
+			next_gui_us += GUI_PERIOD_US;
+
+			if (next_gui_us >= next_profile_us) {
+				size_t len = render_profile_encode(record, sizeof(record));
+				if (profile != NULL) {
+					fwrite(record, 1, len, profile);
+					profile_records++;
+				}
+				if (dump_prefix != NULL && !dump_frame(dump_prefix, dumps++)) {
+					return 1;
+				}
+				next_profile_us += PROFILE_PERIOD_US;
+			}
+		}
+		if (!more) {
+			break;
+		}
+
+		pace(start_ns, time_us, speed);
+		host_set_time_us(time_us);
+		frames++;
+
+		uint64_t t0 = wall_ns();
+		if (host_fdcan_receive(&frame)) {
+			can_rx_process();
+			uint64_t t1 = wall_ns();
+			decode_ns += t1 - t0;
+			samples_add(&decode, t1 - t0);
+		} else {
+			filtered++;
+		}
+
+		if (!quiet && frames % 100000U == 0) {
+			fprintf(stderr, "\r%" PRIu32 " frames, %.1f s", frames,
+					time_us / 1e6);
+		}
+	}
+	if (!quiet && frames >= 100000U) {
+		fprintf(stderr, "\n");
+	}
+	if (dump_prefix != NULL && !dump_frame(dump_prefix, dumps++)) {
+		return 1;
+	}
+
+	double wall_s = (wall_ns() - start_ns) / 1e9;
+	can_rx_counters_t counters;
+	can_rx_get_counters(&counters);
+
+	printf("log         %.3f s, %" PRIu32 " frames, replayed in %.3f s "
+			"(%.1fx)\n", time_us / 1e6, frames, wall_s,
+			wall_s > 0 ? time_us / 1e6 / wall_s : 0.0);
+	printf("receive     %" PRIu32 " filtered in hardware, %" PRIu32
+			" received, %" PRIu32 " decoded, %" PRIu32 " unmatched, %" PRIu32
+			" lost\n", filtered, counters.received, counters.decoded,
+			counters.unmatched, counters.fifo_lost + counters.ring_overflow);
+	if (decode.count > 0) {
+		printf("decode      %.0f ns/frame, %.2f Mframes/s\n",
+				(double) decode_ns / decode.count,
+				decode.count / (decode_ns / 1e9) / 1e6);
+	}
+	print_distribution("decode", &decode);
+	print_distribution("gui update", &update);
+	print_distribution("switch", &switches);
+	print_distribution("frame time", &render);
+	print_redrawn(&redrawn_px);
+	if (overlay && redrawn_px.count > 0) {
+		printf("overlay     %.0f px/frame of them on layer 1\n",
+				(double) overlay_px / redrawn_px.count);
+	}
+	if (redrawn_px.count > 0) {
+		printf("copied      %.0f px/frame, %.1f Mpx total (%s)\n",
+				(double) copied_px / redrawn_px.count, copied_px / 1e6,
+				partial ? "flush" : overlay ? "buffer sync, overlay flush" :
+						"buffer sync");
+	}
+
+	chrome_cache_stats_t chrome;
+	chrome_cache_get_stats(&chrome);
+	if (redrawn_px.count > 0 && chrome.widgets > 0) {
+		printf("chrome      %.0f px/frame copied from %" PRIu32 " snapshots "
+				"(%" PRIu32 " KB) for %" PRIu32 " widgets\n",
+				(double) chrome.blit_px / redrawn_px.count, chrome.snapshots,
+				chrome.bytes / 1024U, chrome.widgets);
+	} else if (redrawn_px.count > 0) {
+		printf("chrome      %.0f px/frame drawn live by the same widgets "
+				"(cache off)\n", (double) chrome.live_px / redrawn_px.count);
+	}
+	if (chrome.full > 0) {
+		printf("            %" PRIu32 " widgets drawn live, the cache is full\n",
+				chrome.full);
+	}
+
+	glyph_dma2d_stats_t glyphs;
+	glyph_dma2d_get_stats(&glyphs);
+	if (glyphs.dma2d + glyphs.fallback > 0) {
+		printf("letters     %" PRIu32 " blended by DMA2D, %" PRIu32 " by LVGL; %"
+				PRIu32 " glyphs repacked to A4, cache emptied %" PRIu32
+				" times\n", glyphs.dma2d, glyphs.fallback, glyphs.repacked,
+				glyphs.flushed);
+	}
+
+	digit_atlas_stats_t atlas;
+	digit_atlas_get_stats(&atlas);
+	if (atlas.fonts > 0) {
+		printf("digits      %" PRIu32 " fonts' digits from the atlas, %" PRIu32
+				" B\n", atlas.fonts, atlas.bytes);
+	}
+	if (atlas.full > 0) {
+		printf("            %" PRIu32 " fonts' digits left as they were, the "
+				"atlas is full\n", atlas.full);
+	}
+
+	if (scan.copies > 0) {
+		printf("scanout     %" PRIu32 " copies into an on-screen framebuffer, "
+				"%" PRIu32 " waited for the beam (%.0f us mean), %" PRIu32
+				" torn; %" PRIu32 " would tear without waiting\n", scan.copies,
+				scan.waited, scan.waited ? scan.wait_ns / 1e3 / scan.waited : 0.0,
+				scan.torn, scan.torn_unscheduled);
+	}
+
+	if (port) {
+		host_dma2d_stats_t dma2d;
+		host_ltdc_stats_t ltdc;
+
+		host_dma2d_get_stats(&dma2d);
+		host_ltdc_get_stats(&ltdc);
+		printf("dma2d       %" PRIu32 " transfers (%" PRIu32 " copy, %" PRIu32
+				" convert, %" PRIu32 " blend, %" PRIu32 " fill), %.1f Mpx, "
+				"busy %.1f ms, CPU waited %.1f ms, %" PRIu32
+				" configuration errors\n", dma2d.transfers, dma2d.by_mode[0],
+				dma2d.by_mode[1], dma2d.by_mode[2], dma2d.by_mode[3],
+				dma2d.pixels / 1e6, dma2d.busy_ns / 1e6, dma2d.wait_ns / 1e6,
+				dma2d.config_errors);
+		printf("ltdc        %" PRIu64 " frames, %" PRIu32 " reloads, %" PRIu32
+				" line events; %" PRIu32 " transfers into an on-screen "
+				"framebuffer, %" PRIu32 " torn; firmware waited %.1f ms\n",
+				host_ltdc_frames(), ltdc.reloads, ltdc.line_events, ltdc.writes,
+				ltdc.torn, host_waited_ns() / 1e6);
+	}
+	if (dump_prefix != NULL) {
+		printf("frames      %" PRIu32 " written to %s*.png\n", dumps,
+				dump_prefix);
+	}
+
+	if (profile != NULL) {
+		if (fclose(profile) != 0) {
+			perror(profile_path);
+			return 1;
+		}
+		printf("profile     %" PRIu32 " records written to %s\n",
+				profile_records, profile_path);
+	}
+
+	lv_mem_monitor_t mem;
+	lv_mem_monitor(&mem);
+	printf("lvgl heap   %" PRIu32 " of %" PRIu32 " bytes in use, %" PRIu32
+			" at the peak (host pointers are 64 bit, the target needs less)\n",
+			(uint32_t) (mem.total_size - mem.free_size),
+			(uint32_t) mem.total_size, (uint32_t) (mem.total_size
+					- mem.free_size - heap_blocks + heap_blocks_peak));
+
+	fclose(log.file);
+	return 0;
+}